@@ -24,3 +24,7 @@ endif()
 
 include(CheckIncludeFile)
 check_include_file ("rpc/rpc.h" HAVE_RPC_RPC_H)
+
+# memory streams for writing multigrid files in the background
+include(CheckSymbolExists)
+check_symbol_exists (open_memstream "stdio.h" HAVE_OPEN_MEMSTREAM)
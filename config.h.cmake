@@ -27,6 +27,11 @@
 #cmakedefine HAVE_RPC_RPC_H 1
 #endif
 
+/* Define to 1 if open_memstream is available (needed for background writing). */
+#ifndef HAVE_OPEN_MEMSTREAM
+#cmakedefine HAVE_OPEN_MEMSTREAM 1
+#endif
+
 /* end private section */
 
 /* end dune-uggrid */
@@ -92,6 +92,10 @@ enum MeshStatus {MESHSTAT_NOTINIT,
                  MESHSTAT_SURFMESH,
                  MESHSTAT_MESH};
 
+/** \brief Heap accounting classes of boundary points and sides (see HEAP_STAT) */
+enum DomainHeapStat {BNDP_HEAPSTAT = MAXHEAPSTAT-2,
+                     BNDS_HEAPSTAT = MAXHEAPSTAT-1};
+
 /** @name Function formats */
 /*@{*/
 typedef INT (*ConfigProcPtr)(INT argc, char **argv);
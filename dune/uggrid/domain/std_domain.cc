@@ -151,6 +151,20 @@ REP_ERR_FILE
 static INT BndPointGlobal (const BNDP * aBndP, DOUBLE * global);
 static INT PatchGlobal (const PATCH * p, DOUBLE * lambda, DOUBLE * global);
 
+/* record a new boundary point/side in the heap accounting,
+   counting the BND_PS record itself (BND_SIZE) */
+static BNDP *AccountBndP (HEAP * Heap, BND_PS * ps)
+{
+  HeapStatAlloc (HEAPSTAT (Heap, BNDP_HEAPSTAT), BND_SIZE (ps));
+  return ((BNDP *) ps);
+}
+
+static BNDS *AccountBndS (HEAP * Heap, BND_PS * ps)
+{
+  HeapStatAlloc (HEAPSTAT (Heap, BNDS_HEAPSTAT), BND_SIZE (ps));
+  return ((BNDS *) ps);
+}
+
 /****************************************************************************/
 /** \brief Allocate a new BNDCOND structure
  *
@@ -765,7 +779,7 @@ CreateBndPOnPoint (HEAP * Heap, PATCH * p)
     if (BndPointGlobal ((BNDP *) ps, (DOUBLE *) BND_DATA (ps)))
       REP_ERR_RETURN (NULL);
   }
-  return ((BNDP *) ps);
+  return (AccountBndP (Heap, ps));
 }
 
 static INT
@@ -1637,7 +1651,7 @@ CreateBndPOnLine (HEAP * Heap, PATCH * p0, PATCH * p1, DOUBLE lcoord)
       return (NULL);
   }
 
-  return ((BNDP *) bp);
+  return (AccountBndP (Heap, bp));
 }
 #endif
 
@@ -1916,7 +1930,7 @@ BVP_InsertBndP (HEAP * Heap, BVP * aBVP, INT argc, char **argv)
       return (NULL);
   }
 
-  return ((BNDP *) ps);
+  return (AccountBndP (Heap, ps));
 }
 
 /****************************************************************************/
@@ -2148,7 +2162,7 @@ TriangulatePatch (HEAP * Heap, PATCH * p, BNDP ** bndp,
           if (BndPointGlobal ((BNDP *) ps, (DOUBLE *) BND_DATA (ps)))
             return (1);
         }
-        bndp[nodeid++] = (BNDP *) ps;
+        bndp[nodeid++] = AccountBndP (Heap, ps);
 
 
         PRINTDEBUG (dom, 1, ("    lambda nid %d %f %f\n",
@@ -2490,7 +2504,7 @@ BNDS_CreateBndP (HEAP * Heap, BNDS * aBndS, DOUBLE * local)
 
   PRINTDEBUG (dom, 1, (" BNDP s %d\n", pp->patch_id));
 
-  return ((BNDP *) pp);
+  return (AccountBndP (Heap, pp));
 }
 
 /****************************************************************************/
@@ -2812,7 +2826,7 @@ BNDP_CreateBndS (HEAP * Heap, BNDP ** aBndP, INT n)
       *(pps++) = bp[i];
   }
 
-  return ((BNDS *) bs);
+  return (AccountBndS (Heap, bs));
 }
 
 /* domain interface function: for description see domain.h */
@@ -2897,7 +2911,7 @@ BNDP_CreateBndP (HEAP * Heap, BNDP * aBndP0, BNDP * aBndP1, DOUBLE lcoord)
       if (BNDP_Global ((BNDP *) bp, (DOUBLE *) BND_DATA (bp)))
         return (NULL);
     }
-    return ((BNDP *) bp);
+    return (AccountBndP (Heap, bp));
   }
 #endif
 
@@ -2933,7 +2947,7 @@ BNDP_CreateBndP (HEAP * Heap, BNDP * aBndP0, BNDP * aBndP1, DOUBLE lcoord)
       x[i] = a[i] * (1.0 - lcoord) + b[i] * lcoord;
   }
 
-  return ((BNDP *) bp);
+  return (AccountBndP (Heap, bp));
 }
 
 /* domain interface function: for description see domain.h */
@@ -3039,6 +3053,7 @@ BNDP_Dispose (HEAP * Heap, BNDP * theBndP)
     return (0);
 
   ps = (BND_PS *) theBndP;
+  HeapStatFree (HEAPSTAT (Heap, BNDP_HEAPSTAT), BND_SIZE (ps));
   if (!PATCH_IS_FIXED (currBVP->patches[ps->patch_id]))
     DisposeMem(Heap, BND_DATA (ps));
   DisposeMem(Heap, ps);
@@ -3055,6 +3070,7 @@ BNDS_Dispose (HEAP * Heap, BNDS * theBndS)
     return (0);
 
   ps = (BND_PS *) theBndS;
+  HeapStatFree (HEAPSTAT (Heap, BNDS_HEAPSTAT), BND_SIZE (ps));
   if (!PATCH_IS_FIXED (currBVP->patches[ps->patch_id]))
     DisposeMem(Heap, BND_DATA (ps));
   DisposeMem(Heap, ps);
@@ -3177,7 +3193,7 @@ BNDP_LoadBndP (BVP * theBVP, HEAP * Heap)
       pos[j] = dList[j];
   }
 
-  return ((BNDP *) bp);
+  return (AccountBndP (Heap, bp));
 }
 
 BNDP *NS_DIM_PREFIX
@@ -166,6 +166,7 @@ void NS_DIM_PREFIX BElementScatterBndS (const DDD::DDDContext& context, BNDS **b
     {
       bs = (BNDS *) memmgr_AllocOMEM((size_t)size,ddd_ctrl(context).TypeBndS,0,0);
       memcpy(bs,data,size);
+      HeapStatAlloc(HEAPSTAT(MGHEAP(ddd_ctrl(context).currMG),BNDS_HEAPSTAT),size);
       bnds[i] = bs;
     }
     data += CEIL(size);
@@ -204,6 +205,7 @@ void NS_DIM_PREFIX BVertexScatterBndP (const DDD::DDDContext& context, BNDP **bn
   {
     *bndp = (BNDS *) memmgr_AllocOMEM((size_t)cnt,ddd_ctrl(context).TypeBndP,0,0);
     memcpy(*bndp,data,cnt);
+    HeapStatAlloc(HEAPSTAT(MGHEAP(ddd_ctrl(context).currMG),BNDP_HEAPSTAT),cnt);
     PRINTDEBUG(dom,1,("BVertexScatterBndP():  pid "
                       "%d n %d size %d cnt %d\n",
                       BND_PATCH_ID(*bndp),
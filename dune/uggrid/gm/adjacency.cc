@@ -0,0 +1,156 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file adjacency.cc
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      adjacency.cc                                                  */
+/*                                                                          */
+/* Purpose:   node-to-element and node-to-node adjacency of a grid level    */
+/*            in compressed sparse row (CSR) format                         */
+/*                                                                          */
+/* Remarks:   The adjacency is built with two linear passes over the        */
+/*            elements (count, fill) and one pass over the node links.      */
+/*            It is cached in the multigrid and rebuilt on first use after  */
+/*            the topology revision changed (AdaptMultiGrid, TransferGrid). */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*            system include files                                          */
+/*            application include files                                     */
+/*                                                                          */
+/****************************************************************************/
+
+#include <config.h>
+
+#include <memory>
+
+#include <dune/uggrid/low/debug.h>
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "adjacency.h"
+#include "gm.h"
+
+USING_UG_NAMESPACES
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+REP_ERR_FILE
+
+/****************************************************************************/
+/** \brief Rebuild the adjacency of a grid level unconditionally
+
+   \param theGrid - grid level to handle
+
+   Assigns row i to the i-th node in the node list of the level and fills
+   the node-to-element and node-to-node arrays. Elements are listed in
+   element list order, neighbour nodes in link order.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   <li> GM_ERROR if an element refers to a node of another level </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX BuildNodeAdjacency (GRID *theGrid)
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+  auto adj = std::make_shared<NodeAdjacency>();
+
+  adj->revision = MG_TOPOLOGY_REVISION(theMG);
+
+  for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+  {
+    adj->row.emplace(theNode, adj->node.size());
+    adj->node.push_back(theNode);
+  }
+  const std::size_t n = adj->node.size();
+
+  /* node -> element: count, prefix sum, fill */
+  adj->elementStart.assign(n+1, 0);
+  for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+    for (INT i=0; i<CORNERS_OF_ELEM(theElement); i++)
+    {
+      const auto it = adj->row.find(CORNER(theElement,i));
+      if (it == adj->row.end())
+        REP_ERR_RETURN(GM_ERROR);
+      adj->elementStart[it->second+1]++;
+    }
+  for (std::size_t i=0; i<n; i++)
+    adj->elementStart[i+1] += adj->elementStart[i];
+
+  adj->element.resize(adj->elementStart[n]);
+  std::vector<INT> fill(adj->elementStart.begin(), adj->elementStart.end()-1);
+  for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+    for (INT i=0; i<CORNERS_OF_ELEM(theElement); i++)
+      adj->element[fill[adj->row[CORNER(theElement,i)]]++] = theElement;
+
+  /* node -> node from the links of each node */
+  adj->nbNodeStart.resize(n+1);
+  adj->nbNodeStart[0] = 0;
+  for (std::size_t i=0; i<n; i++)
+  {
+    for (LINK *theLink=START(adj->node[i]); theLink!=NULL; theLink=NEXT(theLink))
+      adj->nbNode.push_back(NBNODE(theLink));
+    adj->nbNodeStart[i+1] = adj->nbNode.size();
+  }
+
+  theMG->nodeAdjacency[GLEVEL(theGrid)] = std::move(adj);
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Return the adjacency of a grid level
+
+   \param theGrid - grid level to handle
+
+   The adjacency is built on first use and rebuilt whenever the topology
+   of the multigrid changed since it was built.
+
+   \return pointer to the adjacency, NULL if it could not be built
+ */
+/****************************************************************************/
+
+const NodeAdjacency * NS_DIM_PREFIX GetNodeAdjacency (GRID *theGrid)
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+  const auto &adj = theMG->nodeAdjacency[GLEVEL(theGrid)];
+
+  if (adj == nullptr || adj->revision != MG_TOPOLOGY_REVISION(theMG))
+    if (BuildNodeAdjacency(theGrid) != GM_OK)
+      return (NULL);
+
+  return adj.get();
+}
+
+/****************************************************************************/
+/** \brief Free the adjacency of all levels of a multigrid
+
+   \param theMG - multigrid to handle
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX DisposeNodeAdjacency (MULTIGRID *theMG)
+{
+  for (auto &adj : theMG->nodeAdjacency)
+    adj.reset();
+}
+
+/** @} */
@@ -0,0 +1,127 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file adjacency.h
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      adjacency.h                                                   */
+/*                                                                          */
+/* Purpose:   node-to-element and node-to-node adjacency of a grid level    */
+/*            in compressed sparse row (CSR) format                         */
+/*                                                                          */
+/* Remarks:   replaces the per-node ELEMENTLIST chains for users which      */
+/*            need contiguous neighbour lists (patch assembly, smoothers)   */
+/*                                                                          */
+/****************************************************************************/
+
+
+/****************************************************************************/
+/*                                                                          */
+/* auto include mechanism and other include files                           */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef __ADJACENCY__
+#define __ADJACENCY__
+
+#include <unordered_map>
+#include <vector>
+
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "gm.h"
+
+START_UGDIM_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* data structures exported by the corresponding source file                */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Contiguous range of adjacent objects of one node */
+template<class T>
+struct AdjacencyRange
+{
+  T* const* first;
+  T* const* last;
+
+  T* const* begin () const { return first; }
+  T* const* end () const { return last; }
+  INT size () const { return last - first; }
+};
+
+/** \brief Node adjacency of one grid level in CSR format
+
+   Row i belongs to the i-th node of the level in list order (including
+   copies in the parallel case). The element list of row i is
+   element[elementStart[i]] ... element[elementStart[i+1]-1], the node
+   list is stored the same way in nbNode/nbNodeStart.
+ */
+struct NodeAdjacency
+{
+  /** \brief Topology revision of the multigrid this was built for */
+  unsigned int revision;
+
+  /** \brief The nodes of the level, indexed by row */
+  std::vector<NODE*> node;
+
+  /** \brief Node -> row lookup */
+  std::unordered_map<const NODE*, INT> row;
+
+  std::vector<INT> elementStart;
+  std::vector<ELEMENT*> element;
+
+  std::vector<INT> nbNodeStart;
+  std::vector<NODE*> nbNode;
+};
+
+/****************************************************************************/
+/*                                                                          */
+/* function declarations                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Return the adjacency of a grid level, (re)building it if it is out of date */
+const NodeAdjacency *GetNodeAdjacency (GRID *theGrid);
+
+/** \brief Rebuild the adjacency of a grid level unconditionally */
+INT BuildNodeAdjacency (GRID *theGrid);
+
+/** \brief Free the adjacency of all levels of a multigrid */
+void DisposeNodeAdjacency (MULTIGRID *theMG);
+
+/** \brief Row of a node, -1 if the node is not part of the adjacency */
+inline INT NodeAdjacencyRow (const NodeAdjacency &adj, const NODE *theNode)
+{
+  auto it = adj.row.find(theNode);
+  return (it == adj.row.end()) ? -1 : it->second;
+}
+
+/** \brief Elements having the node of row i as a corner */
+inline AdjacencyRange<ELEMENT> NodeElements (const NodeAdjacency &adj, INT i)
+{
+  const auto base = adj.element.data();
+  return {base + adj.elementStart[i], base + adj.elementStart[i+1]};
+}
+
+/** \brief Nodes connected to the node of row i by an edge */
+inline AdjacencyRange<NODE> NodeNeighbors (const NodeAdjacency &adj, INT i)
+{
+  const auto base = adj.nbNode.data();
+  return {base + adj.nbNodeStart[i], base + adj.nbNodeStart[i+1]};
+}
+
+END_UGDIM_NAMESPACE
+
+#endif
+
+/** @} */
@@ -55,11 +55,13 @@
 /****************************************************************************/
 
 #include <config.h>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include <dune/common/unused.hh>
 
@@ -69,6 +71,7 @@
 #include <dune/uggrid/low/heaps.h>
 #include <dune/uggrid/low/misc.h>
 #include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/threads.h>
 #include <dune/uggrid/low/ugenv.h>
 #include <dune/uggrid/low/ugtypes.h>
 
@@ -338,6 +341,7 @@ static INT CreateVectorInPart (GRID *theGrid, INT DomPart, INT VectorObjType,
   SETVNCLASS(pv,0);
   SETVBUILDCON(pv,1);
   SETVNEW(pv,1);
+  SETVROWCHANGED(pv,1);
   /* SETPRIO(dddContext, pv,PrioMaster); */
 
 #ifndef ModelP
@@ -550,6 +554,9 @@ CONNECTION * NS_DIM_PREFIX CreateConnection (GRID *theGrid, VECTOR *from, VECTOR
   /* counters */
   theGrid->nCon++;
 
+  SparsityRowChanged(theGrid,from);
+  SparsityRowChanged(theGrid,to);
+
   return(pc);
 }
 
@@ -581,6 +588,7 @@ CONNECTION      *NS_DIM_PREFIX CreateExtraConnection    (GRID *theGrid, VECTOR *
   return(pc);
 }
 
+#ifndef UG_NO_NODE_ELEMENTLIST
 INT NS_DIM_PREFIX CreateElementList (GRID *theGrid, NODE *theNode, ELEMENT *theElement)
 {
   ELEMENTLIST *pel;
@@ -600,6 +608,7 @@ INT NS_DIM_PREFIX CreateElementList (GRID *theGrid, NODE *theNode, ELEMENT *theE
 
   return(0);
 }
+#endif
 
 /****************************************************************************/
 /** \brief Remove vector from the data structure
@@ -637,6 +646,7 @@ INT NS_DIM_PREFIX DisposeVector (GRID *theGrid, VECTOR *theVector)
 
   /* now remove vector from vector list */
   GRID_UNLINK_VECTOR(theGrid,theVector);
+  SparsityRowChanged(theGrid,theVector);
 
   /* reset count flags */
   SETVCOUNT(theVector,0);
@@ -785,6 +795,9 @@ INT NS_DIM_PREFIX DisposeConnection (GRID *theGrid, CONNECTION *theConnection)
           MNEXT(SearchMatrix) = MNEXT(ReverseMatrix);
   }
 
+  SparsityRowChanged(theGrid,from);
+  SparsityRowChanged(theGrid,to);
+
   /* free connection object */
   if (MDIAG(Matrix))
     PutFreeObject(MYMG(theGrid),Matrix,UG_MSIZE(Matrix),MAOBJ);
@@ -1018,6 +1031,7 @@ INT NS_DIM_PREFIX DisposeConnectionsFromMultiGrid (MULTIGRID *theMG)
   return(0);
 }
 
+#ifndef UG_NO_NODE_ELEMENTLIST
 INT NS_DIM_PREFIX DisposeElementFromElementList (GRID *theGrid, NODE *theNode,
                                                  ELEMENT *theElement)
 {
@@ -1057,6 +1071,7 @@ INT NS_DIM_PREFIX DisposeElementList (GRID *theGrid, NODE *theNode)
 
   return(0);
 }
+#endif
 
 /****************************************************************************/
 /** \brief Return pointer to matrix if it exists
@@ -1236,6 +1251,10 @@ INT NS_DIM_PREFIX GetVectorsOfEdges (const ELEMENT *theElement, INT *cnt, VECTOR
  * @param vList - array to store vector list
 
    This function gets a pointer array to all VECTORs in nodes of the element.
+   Nodes of formats without node vectors are allocated without their vector
+   pointer, so the caller must make sure that the format defines NODEVEC
+   (e.g. by VEC_DEF_IN_OBJ_OF_GRID). An element does not know its grid, so
+   this cannot be checked here.
 
  * @return <ul>
  *   <li>    GM_OK if ok </li>
@@ -1273,6 +1292,7 @@ INT NS_DIM_PREFIX GetVectorsOfNodes (const ELEMENT *theElement, INT *cnt, VECTOR
  * @param vList - array to store vector list
 
    This function returns a pointer array to all VECTORs of the element of the specified type.
+   The format must define vectors in objects of this type, see 'GetVectorsOfNodes'.
 
  * @return <ul>
  *   <li>    GM_OK if ok </li>
@@ -1336,6 +1356,7 @@ INT NS_DIM_PREFIX DataTypeFilterVList (INT dt, VECTOR **vec, INT *cnt)
  * @param vec - vector list
 
    This function gets a list of vectors of the specified vtypes corresponding to an element.
+   Like for 'GetVectorsOfNodes' all object types in 'obj' must be defined in the format.
 
  * @return <ul>
  *   <li>   GM_OK if ok </li>
@@ -2472,6 +2493,270 @@ INT NS_DIM_PREFIX PrepareAlgebraModification (MULTIGRID *theMG)
   return (0);
 }
 
+/****************************************************************************/
+/*                                                                          */
+/* CSR sparsity patterns                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/** \brief Record that the matrix row of a vector changed
+
+ * @param theGrid - grid level of the vector
+ * @param theVector - vector whose connections were created or disposed
+
+   CreateConnection, DisposeConnection and DisposeVector call this. Code
+   that links or frees matrices by other means (the DDD handlers) must call
+   it as well, otherwise the cached patterns keep the old row. The row is
+   flagged with VROWCHANGED until the next update of the level pattern.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX SparsityRowChanged (GRID *theGrid, VECTOR *theVector)
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+
+  SETVROWCHANGED(theVector,1);
+  if (theMG->levelPattern[GLEVEL(theGrid)] != nullptr)
+    theMG->levelPattern[GLEVEL(theGrid)]->changed = true;
+  if (theMG->surfacePattern != nullptr)
+    theMG->surfacePattern->changed = true;
+}
+
+/****************************************************************************/
+/** \brief (Re)compute the CSR sparsity pattern of a grid level
+
+ * @param pattern - pattern to update, empty if built for the first time
+ * @param vectors - the vectors of the level in list order
+
+   Rows of vectors without VROWCHANGED are copied from the old pattern with
+   renumbered columns, dropping the columns of vectors that left the level.
+   The rows of vectors that entered the level and of their neighbours are
+   rebuilt from the matrix lists. Both passes run on several threads, each
+   thread handling a contiguous range of rows. The vector -> row map is only
+   rebuilt if the vector list changed. The flags are cleared afterwards.
+ */
+/****************************************************************************/
+
+static void UpdateSparsityPattern (SparsityPattern &pattern, std::vector<VECTOR*> &&vectors)
+{
+  const std::size_t n = vectors.size();
+  const bool sameRows = (vectors == pattern.vector);
+
+  /* old row of each vector, -1 if the vector is new */
+  std::vector<INT> prevRow(n, -1);
+  std::unordered_map<const VECTOR*, INT> row;
+  if (sameRows)
+    for (std::size_t i=0; i<n; i++)
+      prevRow[i] = i;
+  else
+  {
+    row.reserve(n);
+    for (std::size_t i=0; i<n; i++)
+    {
+      row.emplace(vectors[i], i);
+      const auto it = pattern.row.find(vectors[i]);
+      if (it != pattern.row.end())
+        prevRow[i] = it->second;
+      else if (!pattern.vector.empty())
+        /* a new column in the rows of the neighbours */
+        for (MATRIX *m=VSTART(vectors[i]); m!=NULL; m=MNEXT(m))
+          SETVROWCHANGED(MDEST(m),1);
+    }
+  }
+  const auto &rowOf = sameRows ? pattern.row : row;
+
+  std::vector<INT> oldToNew(pattern.vector.size(), -1);
+  for (std::size_t i=0; i<n; i++)
+    if (prevRow[i] >= 0)
+      oldToNew[prevRow[i]] = i;
+
+  /* old row to copy, -1 if the row is rebuilt */
+  std::vector<INT> oldRow(n, -1);
+  for (std::size_t i=0; i<n; i++)
+    if (!VROWCHANGED(vectors[i]))
+      oldRow[i] = prevRow[i];
+
+  /* row lengths */
+  std::vector<INT> rowStart(n+1, 0);
+  ParallelForRange(n, [&](std::size_t begin, std::size_t end, INT) {
+      for (std::size_t i=begin; i<end; i++)
+      {
+        INT len = 0;
+        if (oldRow[i] >= 0)
+        {
+          for (INT k=pattern.rowStart[oldRow[i]]; k<pattern.rowStart[oldRow[i]+1]; k++)
+            if (oldToNew[pattern.colIndex[k]] >= 0)
+              len++;
+        }
+        else
+          for (const MATRIX *m=VSTART(vectors[i]); m!=NULL; m=MNEXT(m))
+            if (rowOf.find(MDEST(m)) != rowOf.end())
+              len++;
+        rowStart[i+1] = len;
+      }
+    });
+  for (std::size_t i=0; i<n; i++)
+    rowStart[i+1] += rowStart[i];
+
+  /* columns */
+  std::vector<INT> colIndex(rowStart[n]);
+  ParallelForRange(n, [&](std::size_t begin, std::size_t end, INT) {
+      for (std::size_t i=begin; i<end; i++)
+      {
+        INT *col = colIndex.data() + rowStart[i];
+        if (oldRow[i] >= 0)
+        {
+          for (INT k=pattern.rowStart[oldRow[i]]; k<pattern.rowStart[oldRow[i]+1]; k++)
+            if (oldToNew[pattern.colIndex[k]] >= 0)
+              *col++ = oldToNew[pattern.colIndex[k]];
+        }
+        else
+          for (const MATRIX *m=VSTART(vectors[i]); m!=NULL; m=MNEXT(m))
+          {
+            const auto it = rowOf.find(MDEST(m));
+            if (it != rowOf.end())
+              *col++ = it->second;
+          }
+        std::sort(colIndex.data() + rowStart[i], col);
+      }
+    });
+
+  for (VECTOR *v : vectors)
+    SETVROWCHANGED(v,0);
+
+  if (!sameRows)
+  {
+    pattern.vector = std::move(vectors);
+    pattern.row = std::move(row);
+  }
+  pattern.rowStart = std::move(rowStart);
+  pattern.colIndex = std::move(colIndex);
+  pattern.changed = false;
+}
+
+/****************************************************************************/
+/** \brief Return the CSR sparsity pattern of a grid level
+
+ * @param theGrid - grid level
+
+   Rows are the vectors of the level in list order. The pattern is cached
+   and updated incrementally from the connections created and disposed
+   since the last call.
+
+ * @return <ul>
+ *   <li>    pointer to the pattern
+   </ul>
+ */
+/****************************************************************************/
+
+const SparsityPattern * NS_DIM_PREFIX GetGridSparsityPattern (GRID *theGrid)
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+  auto &pattern = theMG->levelPattern[GLEVEL(theGrid)];
+
+  if (pattern == nullptr)
+    pattern = std::make_shared<SparsityPattern>();
+  else if (pattern->revision == MG_TOPOLOGY_REVISION(theMG) && !pattern->changed)
+    return pattern.get();
+
+  std::vector<VECTOR*> vectors;
+  vectors.reserve(NVEC(theGrid));
+  for (VECTOR *v=PFIRSTVECTOR(theGrid); v!=NULL; v=SUCCVC(v))
+    vectors.push_back(v);
+
+  UpdateSparsityPattern(*pattern, std::move(vectors));
+  pattern->revision = MG_TOPOLOGY_REVISION(theMG);
+
+  return pattern.get();
+}
+
+/****************************************************************************/
+/** \brief Return the CSR sparsity pattern of the surface
+
+ * @param theMG - multigrid
+
+   Rows are the vectors with FINE_GRID_DOF set, level by level in list
+   order. Columns are restricted to surface vectors. Connections only link
+   vectors of the same level, so the pattern is assembled from the updated
+   level patterns without walking the matrix lists.
+
+ * @return <ul>
+ *   <li>    pointer to the pattern
+   </ul>
+ */
+/****************************************************************************/
+
+const SparsityPattern * NS_DIM_PREFIX GetSurfaceSparsityPattern (MULTIGRID *theMG)
+{
+  auto &pattern = theMG->surfacePattern;
+
+  if (pattern == nullptr)
+    pattern = std::make_shared<SparsityPattern>();
+  else if (pattern->revision == MG_TOPOLOGY_REVISION(theMG) && !pattern->changed)
+    return pattern.get();
+
+  std::vector<VECTOR*> vectors;
+  std::vector<INT> rowStart(1, 0);
+  std::vector<INT> colIndex;
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+  {
+    const SparsityPattern &levelPattern = *GetGridSparsityPattern(GRID_ON_LEVEL(theMG,level));
+
+    /* surface row of each level row, -1 if not on the surface */
+    std::vector<INT> surfaceRow(levelPattern.vector.size(), -1);
+    for (std::size_t i=0; i<levelPattern.vector.size(); i++)
+      if (FINE_GRID_DOF(levelPattern.vector[i]))
+      {
+        surfaceRow[i] = vectors.size();
+        vectors.push_back(levelPattern.vector[i]);
+      }
+
+    /* level rows are in list order, so the columns stay sorted */
+    for (std::size_t i=0; i<surfaceRow.size(); i++)
+      if (surfaceRow[i] >= 0)
+      {
+        for (INT k=levelPattern.rowStart[i]; k<levelPattern.rowStart[i+1]; k++)
+          if (surfaceRow[levelPattern.colIndex[k]] >= 0)
+            colIndex.push_back(surfaceRow[levelPattern.colIndex[k]]);
+        rowStart.push_back(colIndex.size());
+      }
+  }
+
+  if (vectors != pattern->vector)
+  {
+    pattern->row.clear();
+    pattern->row.reserve(vectors.size());
+    for (std::size_t i=0; i<vectors.size(); i++)
+      pattern->row.emplace(vectors[i], i);
+    pattern->vector = std::move(vectors);
+  }
+  pattern->rowStart = std::move(rowStart);
+  pattern->colIndex = std::move(colIndex);
+  pattern->revision = MG_TOPOLOGY_REVISION(theMG);
+  pattern->changed = false;
+
+  return pattern.get();
+}
+
+/****************************************************************************/
+/** \brief Free all cached sparsity patterns
+
+ * @param theMG - multigrid
+
+   The next request rebuilds the patterns from scratch. This is needed
+   when vectors are created or deleted without going through
+   CreateConnection/DisposeConnection, e.g. during load balancing.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX DisposeSparsityPatterns (MULTIGRID *theMG)
+{
+  for (auto &pattern : theMG->levelPattern)
+    pattern.reset();
+  theMG->surfacePattern.reset();
+}
+
 /****************************************************************************/
 /** \brief Check connection of two elements
 
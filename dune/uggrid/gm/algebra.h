@@ -48,6 +48,9 @@
 #ifndef __ALGEBRA__
 #define __ALGEBRA__
 
+#include <unordered_map>
+#include <vector>
+
 #include <dune/uggrid/low/namespace.h>
 #include <dune/uggrid/low/ugtypes.h>
 
@@ -93,6 +96,31 @@ enum VectorClass {EVERY_CLASS = 0,       /*!< Class of all vectors */
 
 extern const char *ObjTypeName[MAXVOBJECTS];
 
+/** \brief Sparsity pattern of the connections in compressed sparse row format
+
+   Row i belongs to vector[i], rows are in vector list order (level by level
+   for the surface). The columns of row i are
+   colIndex[rowStart[i]] ... colIndex[rowStart[i+1]-1], sorted ascending.
+   The row of a vector is found with SparsityPatternRow; VINDEX is not
+   touched, so the level and the surface pattern can be used side by side.
+ */
+struct SparsityPattern
+{
+  /** \brief Topology revision of the multigrid this was built for */
+  unsigned int revision;
+
+  std::vector<VECTOR*> vector;
+  std::vector<INT> rowStart;
+  std::vector<INT> colIndex;
+
+  /** \brief Vector -> row */
+  std::unordered_map<const VECTOR*, INT> row;
+
+  /** \brief A row changed since the last update, the vectors of the changed
+      rows are flagged with VROWCHANGED */
+  bool changed = false;
+};
+
 /****************************************************************************/
 /*                                                                          */
 /* control word definitions                                                 */
@@ -137,7 +165,9 @@ INT         CreateVector                                    (GRID *theGrid, INT
 INT         CreateSideVector                (GRID *theGrid, INT side, GEOM_OBJECT *object, VECTOR **vHandle);
 INT         ReinspectSonSideVector  (GRID *g, ELEMENT *elem, INT side, VECTOR **vHandle);
 CONNECTION *CreateConnection        (GRID *theGrid, VECTOR *from, VECTOR *to);
+#ifndef UG_NO_NODE_ELEMENTLIST
 INT         CreateElementList        (GRID *theGrid, NODE *theNode, ELEMENT *theElement);
+#endif
 INT         DisposeVector            (GRID *theGrid, VECTOR *theVector);
 INT         DisposeConnection        (GRID *theGrid, CONNECTION *theConnection);
 /*@}*/
@@ -154,8 +184,10 @@ INT                     DisposeConnectionsFromMultiGrid (MULTIGRID *theMG);
 #ifdef __THREEDIM__
 INT             DisposeDoubledSideVector                (GRID *theGrid, ELEMENT *Elem0, INT Side0, ELEMENT *Elem1, INT Side1);
 #endif
+#ifndef UG_NO_NODE_ELEMENTLIST
 INT             DisposeElementList(GRID *theGrid, NODE *theNode);
 INT             DisposeElementFromElementList (GRID *theGrid, NODE *theNode, ELEMENT *theElement);
+#endif
 /*@}*/
 
 /** @name Query functions */
@@ -184,6 +216,21 @@ INT             SetSurfaceClasses                               (MULTIGRID *theM
 INT         CreateAlgebra                               (MULTIGRID *theMG);
 /*@}*/
 
+/** @name CSR sparsity patterns */
+/*@{*/
+const SparsityPattern *GetGridSparsityPattern   (GRID *theGrid);
+const SparsityPattern *GetSurfaceSparsityPattern (MULTIGRID *theMG);
+void            DisposeSparsityPatterns         (MULTIGRID *theMG);
+void            SparsityRowChanged              (GRID *theGrid, VECTOR *theVector);
+
+/** \brief Row of a vector, -1 if the vector is not part of the pattern */
+inline INT SparsityPatternRow (const SparsityPattern &pattern, const VECTOR *theVector)
+{
+  auto it = pattern.row.find(theVector);
+  return (it == pattern.row.end()) ? -1 : it->second;
+}
+/*@}*/
+
 /** @name Check algebra */
 /*@{*/
 INT                     ElementCheckConnection                  (GRID *theGrid, ELEMENT *theElement);
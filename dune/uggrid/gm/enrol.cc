@@ -94,22 +94,40 @@ static INT theSymbolVarID;                      /* env type for Format vars
 
 REP_ERR_FILE
 
-std::unique_ptr<FORMAT> NS_DIM_PREFIX CreateFormat ()
+/****************************************************************************/
+/** \brief Create the format of a multigrid
+
+   \param formatName - "DuneNodeFormat" adds a scalar to every node with
+                       matrices between the nodes of an element, every other
+                       name gives the format used by Dune
+
+   The Dune format has side vectors in 3D and no vectors in 2D.
+ */
+/****************************************************************************/
+
+std::unique_ptr<FORMAT> NS_DIM_PREFIX CreateFormat (const char *formatName)
 {
   INT i, j, type, type2, part, obj, MaxDepth, NeighborhoodDepth, MaxType;
 
   std::string name = "DuneFormat" + std::to_string(DIM) + "d";
+  const bool nodeVectors = (formatName!=NULL && strcmp(formatName,"DuneNodeFormat")==0);
 
 /* fill degrees of freedom needed */
   VectorDescriptor vDesc[MAXVECTORS];
-#ifdef __TWODIM__
   INT nvDesc = 0;
-#else
-  INT nvDesc = 1;
-  vDesc[0].tp    = SIDEVEC;
-  vDesc[0].size  = sizeof(DOUBLE);
-  vDesc[0].name  = 's';
+#ifdef __THREEDIM__
+  vDesc[nvDesc].tp    = SIDEVEC;
+  vDesc[nvDesc].size  = sizeof(DOUBLE);
+  vDesc[nvDesc].name  = 's';
+  nvDesc++;
 #endif
+  if (nodeVectors)
+  {
+    vDesc[nvDesc].tp    = NODEVEC;
+    vDesc[nvDesc].size  = sizeof(DOUBLE);
+    vDesc[nvDesc].name  = 'n';
+    nvDesc++;
+  }
 
   /* allocate new format structure */
   auto fmt = std::make_unique<FORMAT>();
@@ -138,10 +156,17 @@ std::unique_ptr<FORMAT> NS_DIM_PREFIX CreateFormat ()
 #ifdef __THREEDIM__
   po2t[0][3] = SIDEVEC;
 #endif
+  if (nodeVectors)
+    po2t[0][NODEVEC] = NODEVEC;
 
   SHORT MatStorageNeeded[MAXCONNECTIONS];
   for (type=0; type<MAXCONNECTIONS; type++)
     MatStorageNeeded[type] = 0;
+  if (nodeVectors)
+  {
+    MatStorageNeeded[MATRIXTYPE(NODEVEC,NODEVEC)] = 1;
+    MatStorageNeeded[DIAGMATRIXTYPE(NODEVEC)] = 1;
+  }
 
   /* fill connections needed */
   MatrixDescriptor mDesc[MAXMATRICES*MAXVECTORS];
@@ -2026,13 +2026,14 @@ static void CheckMRules (MULTIGRID *mg, INT RefRuleOffset[], MGIO_RR_RULE *mrule
     NEW_Write_RefRules - write refinement rules of multigrid to file
 
     SYNOPSIS:
-    INT NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle)
+    INT NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle, INT *nrules)
 
     PAAMETERS:
    .   mg - multigrid
    .   RefRuleOffset - tag-wise offsets for refrules
    .   MarkKey - mark key for temporary storage of ugio
    .   mrule_handle - pointer to mgio rules allocated on temporary storage of ugio
+   .   nrules - returns the number of rules in the table (may be NULL)
 
     DESCRIPTION:
         Write refinement rules of multigrid to file (rm rules as far as available, the remainder
@@ -2045,7 +2046,7 @@ static void CheckMRules (MULTIGRID *mg, INT RefRuleOffset[], MGIO_RR_RULE *mrule
    D*/
 /****************************************************************************/
 
-INT NS_DIM_PREFIX NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle)
+INT NS_DIM_PREFIX NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle, INT *nrules)
 {
   MGIO_RR_GENERAL rr_general;
   MGIO_RR_RULE *mrule;
@@ -2083,6 +2084,8 @@ INT NS_DIM_PREFIX NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT Ma
     rr_general.RefRuleOffset[tag] = RefRuleOffset[tag];
   }
   rr_general.nRules = global.maxrules;
+  if (nrules!=NULL)
+    *nrules = global.maxrules;
   if (Write_RR_General(&rr_general))
     REP_ERR_RETURN(1);
 
@@ -2136,10 +2139,11 @@ INT NS_DIM_PREFIX NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT Ma
    ResetRefineTagsBeyondRuleManager - reset refine tags to what refine expects there
 
    SYNOPSIS:
-   INT ResetRefineTagsBeyondRuleManager (MULTIGRID *mg)
+   INT ResetRefineTagsBeyondRuleManager (MULTIGRID *mg, std::vector<std::pair<ELEMENT*,INT> > *reset)
 
    PARAMETERS:
    .  mg - multigrid
+   .  reset - if not NULL, returns the elements reset and their former refine tags
 
    DESCRIPTION:
    Reset refine tags to what refine expects there.
@@ -2150,7 +2154,7 @@ INT NS_DIM_PREFIX NEW_Write_RefRules (MULTIGRID *mg, INT RefRuleOffset[], INT Ma
    D*/
 /****************************************************************************/
 
-INT NS_DIM_PREFIX ResetRefineTagsBeyondRuleManager (MULTIGRID *mg)
+INT NS_DIM_PREFIX ResetRefineTagsBeyondRuleManager (MULTIGRID *mg, std::vector<std::pair<ELEMENT*,INT> > *reset)
 {
   ELEMENT *elem;
   int l,n=0;
@@ -2160,6 +2164,8 @@ INT NS_DIM_PREFIX ResetRefineTagsBeyondRuleManager (MULTIGRID *mg)
     for (elem=PFIRSTELEMENT(GRID_ON_LEVEL(mg,l)); elem!=NULL; elem=SUCCE(elem))
       if (BEYOND_UG_RULES(elem))
       {
+        if (reset!=NULL)
+          reset->emplace_back(elem,REFINE(elem));
         SETREFINE(elem,COPY);
         n++;
       }
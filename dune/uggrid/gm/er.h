@@ -33,6 +33,9 @@
 #ifndef __ER__
 #define __ER__
 
+#include <utility>
+#include <vector>
+
 #include "mgio.h"
 
 #include <dune/uggrid/low/namespace.h>
@@ -74,8 +77,8 @@ START_UGDIM_NAMESPACE
 /****************************************************************************/
 
 INT GetOrderedSons                                              (ELEMENT *theElement, MGIO_RR_RULE *theRule, NODE **NodeContext, ELEMENT **SonList, INT *nmax);
-INT NEW_Write_RefRules                                  (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle);
-INT ResetRefineTagsBeyondRuleManager    (MULTIGRID *mg);
+INT NEW_Write_RefRules                                  (MULTIGRID *mg, INT RefRuleOffset[], INT MarkKey, MGIO_RR_RULE **mrule_handle, INT *nrules);
+INT ResetRefineTagsBeyondRuleManager    (MULTIGRID *mg, std::vector<std::pair<ELEMENT*,INT> > *reset = nullptr);
 
 END_UGDIM_NAMESPACE
 
@@ -0,0 +1,316 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file geomcache.cc
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      geomcache.cc                                                  */
+/*                                                                          */
+/* Purpose:   cache of the affine transformations of simplex elements       */
+/*                                                                          */
+/* Remarks:   Entries are computed on first use. InvalidateGeometryCache    */
+/*            only increments the stamp, outdated entries are recomputed    */
+/*            when they are used next. DisposeElement and the DDD object    */
+/*            destructor drop the entries of removed elements.              */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*            system include files                                          */
+/*            application include files                                     */
+/*                                                                          */
+/****************************************************************************/
+
+#include <config.h>
+
+#include <cmath>
+#include <memory>
+
+#include <dune/uggrid/low/architecture.h>
+#include <dune/uggrid/low/debug.h>
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "evm.h"
+#include "gm.h"
+#include "geomcache.h"
+#include "shapes.h"
+#include "ugm.h"
+
+USING_UG_NAMESPACES
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+REP_ERR_FILE
+
+/* volume and Jacobian of the reference simplex */
+#ifdef __TWODIM__
+#define REFERENCE_VOLUME        0.5
+#define TRANSFORMATION_OF_SIMPLEX(x,M)          TRANSFORMATION_OF_TRIANGLE(x,M)
+#else
+#define REFERENCE_VOLUME        (1.0/6.0)
+#define TRANSFORMATION_OF_SIMPLEX(x,M)          TRANSFORMATION_OF_TETRAHEDRON(x,M)
+#endif
+
+static bool IsSimplex (const ELEMENT *theElement)
+{
+  return (CORNERS_OF_ELEM(theElement) == DIM+1);
+}
+
+/* M_DIM_INVERT returns 1 for (nearly) singular matrices */
+static INT InvertJacobian (ElementGeometry &g)
+{
+  M_DIM_INVERT(g.J,g.Jinv,g.det);
+  return (0);
+}
+
+static void ComputeGeometry (const ELEMENT *theElement, INT stamp, ElementGeometry &g)
+{
+  const DOUBLE *x[DIM+1];
+  INT i;
+
+  for (i=0; i<=DIM; i++)
+    x[i] = CVECT(MYVERTEX(CORNER(theElement,i)));
+
+  g.stamp = stamp;
+  V_DIM_COPY(x[0],g.x0);
+  TRANSFORMATION_OF_SIMPLEX(x,g.J);
+  if (InvertJacobian(g))
+    g.det = 0.0;
+}
+
+/****************************************************************************/
+/** \brief Start caching the geometry of simplex elements
+
+   \param theMG - multigrid to handle
+
+   Entries are computed when they are used first. Enabling the cache again
+   drops all entries.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX EnableGeometryCache (MULTIGRID *theMG)
+{
+  theMG->geometryCache = std::make_shared<GeometryCache>();
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Stop caching and release the cache
+
+   \param theMG - multigrid to handle
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX DisableGeometryCache (MULTIGRID *theMG)
+{
+  theMG->geometryCache.reset();
+}
+
+/****************************************************************************/
+/** \brief Outdate all entries because vertices moved
+
+   \param theMG - multigrid to handle
+
+   Must be called after coordinates of vertices were changed, e.g. by
+   writing CVECT or by BNDP_Move. The entries are recomputed lazily.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX InvalidateGeometryCache (MULTIGRID *theMG)
+{
+  if (theMG == NULL || theMG->geometryCache == nullptr) return;
+
+  theMG->geometryCache->stamp++;
+}
+
+/****************************************************************************/
+/** \brief Drop the entry of an element which is disposed
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX GeometryCacheRemove (MULTIGRID *theMG, const ELEMENT *theElement)
+{
+  if (theMG == NULL || theMG->geometryCache == nullptr) return;
+
+  theMG->geometryCache->entry.erase(theElement);
+}
+
+/****************************************************************************/
+/** \brief Cached affine map of a simplex
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+
+   \return <ul>
+   <li> the up to date entry of the element </li>
+   <li> NULL if the element is not a simplex or the cache is disabled </li>
+   </ul>
+ */
+/****************************************************************************/
+
+const ElementGeometry * NS_DIM_PREFIX GetElementGeometry (MULTIGRID *theMG, const ELEMENT *theElement)
+{
+  if (theMG == NULL || theMG->geometryCache == nullptr || !IsSimplex(theElement))
+    return (NULL);
+
+  GeometryCache &cache = *theMG->geometryCache;
+  auto inserted = cache.entry.emplace(theElement,ElementGeometry());
+  ElementGeometry &g = inserted.first->second;
+  if (inserted.second || g.stamp != cache.stamp)
+    ComputeGeometry(theElement,cache.stamp,g);
+
+  return (&g);
+}
+
+/****************************************************************************/
+/** \brief Local coordinates of a global point in an element
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+   \param global - global coordinates
+   \param local - returns the local coordinates
+
+   Simplices use the cached inverse, other elements UG_GlobalToLocal.
+
+   \return <ul>
+   <li> 0 if ok </li>
+   <li> the error code of UG_GlobalToLocal otherwise </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX ElementGlobalToLocal (MULTIGRID *theMG, const ELEMENT *theElement, const DOUBLE *global, DOUBLE *local)
+{
+  const ElementGeometry *g = GetElementGeometry(theMG,theElement);
+  DOUBLE *x[MAX_CORNERS_OF_ELEM];
+  DOUBLE_VECTOR diff;
+  INT n;
+
+  if (g == NULL)
+  {
+    CORNER_COORDINATES((ELEMENT *)theElement,n,x);
+    return (UG_GlobalToLocal(n,(const DOUBLE **)x,global,local));
+  }
+
+  if (g->det == 0.0) return (2);
+  V_DIM_SUBTRACT(global,g->x0,diff);
+  MT_TIMES_V_DIM(g->Jinv,diff,local);
+
+  return (0);
+}
+
+/****************************************************************************/
+/** \brief Global coordinates of a local point in an element
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+   \param local - local coordinates
+   \param global - returns the global coordinates
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX ElementLocalToGlobal (MULTIGRID *theMG, const ELEMENT *theElement, const DOUBLE *local, DOUBLE *global)
+{
+  const ElementGeometry *g = GetElementGeometry(theMG,theElement);
+  DOUBLE *x[MAX_CORNERS_OF_ELEM];
+  INT i,n;
+
+  if (g == NULL)
+  {
+    CORNER_COORDINATES((ELEMENT *)theElement,n,x);
+    LOCAL_TO_GLOBAL(n,x,local,global);
+    return;
+  }
+
+  V_DIM_COPY(g->x0,global);
+  for (i=0; i<DIM; i++)
+    V_DIM_LINCOMB(1.0,global,local[i],g->J[i],global);
+}
+
+/****************************************************************************/
+/** \brief Volume of an element
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+
+   \return the same value as ElementVolume
+ */
+/****************************************************************************/
+
+DOUBLE NS_DIM_PREFIX ElementVolumeCached (MULTIGRID *theMG, const ELEMENT *theElement)
+{
+  const ElementGeometry *g = GetElementGeometry(theMG,theElement);
+
+  if (g == NULL)
+    return (ElementVolume(theElement));
+
+  return (REFERENCE_VOLUME*std::abs(g->det));
+}
+
+/****************************************************************************/
+/** \brief Determine whether a point is contained in an element
+
+   \param theMG - multigrid the element belongs to
+   \param global - coordinates of the point
+   \param theElement - element to scan
+
+   Simplices test the barycentric coordinates computed with the cached
+   inverse, other elements use PointInElement.
+
+   \return <ul>
+   <li> false: point is not in the element </li>
+   <li> true: point is in the element </li>
+   </ul>
+ */
+/****************************************************************************/
+
+bool NS_DIM_PREFIX PointInElementCached (MULTIGRID *theMG, const DOUBLE *global, const ELEMENT *theElement)
+{
+  const ElementGeometry *g;
+  DOUBLE_VECTOR diff,local;
+  DOUBLE sum;
+  INT i;
+
+  if (theElement == NULL)
+    return false;
+
+  g = GetElementGeometry(theMG,theElement);
+  if (g == NULL || g->det == 0.0)
+    return (PointInElement(global,theElement));
+
+  V_DIM_SUBTRACT(global,g->x0,diff);
+  MT_TIMES_V_DIM(g->Jinv,diff,local);
+
+  sum = 0.0;
+  for (i=0; i<DIM; i++)
+  {
+    if (local[i] < -SMALL_C) return false;
+    sum += local[i];
+  }
+
+  return (sum <= 1.0+SMALL_C);
+}
+
+/** @} */
@@ -0,0 +1,122 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file geomcache.h
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      geomcache.h                                                   */
+/*                                                                          */
+/* Purpose:   cache of the affine transformations of simplex elements       */
+/*                                                                          */
+/* Remarks:   When enabled, the Jacobian of the reference map of triangles  */
+/*            and tetrahedra, its inverse and its determinant are computed  */
+/*            once and kept out of line, keyed by the element address (IDs  */
+/*            change in RenumberMultiGrid and are shared by the copies of   */
+/*            an element in the parallel case). Disposed elements are       */
+/*            removed. Other element types are not affine and are evaluated */
+/*            from their corners (Newton iteration for global to local).    */
+/*            Whoever moves vertices (by writing CVECT or with BNDP_Move)   */
+/*            must call InvalidateGeometryCache. The cache is not thread    */
+/*            safe.                                                         */
+/*                                                                          */
+/****************************************************************************/
+
+
+/****************************************************************************/
+/*                                                                          */
+/* auto include mechanism and other include files                           */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef __GEOMCACHE__
+#define __GEOMCACHE__
+
+#include <unordered_map>
+
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "gm.h"
+
+START_UGDIM_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* data structures exported by the corresponding source file                */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Affine reference map global = x0 + sum_i local[i]*J[i] of a simplex */
+struct ElementGeometry
+{
+  /** \brief Invalidation stamp of the cache when the entry was computed */
+  INT stamp;
+
+  /** \brief Coordinates of corner 0 */
+  DOUBLE_VECTOR x0;
+
+  /** \brief Jacobian as computed by TRANSFORMATION, J[i] = x_{i+1} - x0 */
+  DOUBLE_VECTOR J[DIM];
+
+  /** \brief Inverse as computed by M_DIM_INVERT, local = Jinv^T (global - x0) */
+  DOUBLE_VECTOR Jinv[DIM];
+
+  /** \brief Determinant of J, 0 if J is (nearly) singular */
+  DOUBLE det;
+};
+
+/** \brief Geometry cache of a multigrid */
+struct GeometryCache
+{
+  /** \brief Entries keyed by element */
+  std::unordered_map<const ELEMENT*, ElementGeometry> entry;
+
+  /** \brief Entries with a different stamp are outdated */
+  INT stamp = 0;
+};
+
+/****************************************************************************/
+/*                                                                          */
+/* function declarations                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Start caching the geometry of simplex elements */
+INT EnableGeometryCache (MULTIGRID *theMG);
+
+/** \brief Stop caching and release the cache */
+void DisableGeometryCache (MULTIGRID *theMG);
+
+/** \brief Outdate all entries because vertices moved */
+void InvalidateGeometryCache (MULTIGRID *theMG);
+
+/** \brief Drop the entry of an element which is disposed */
+void GeometryCacheRemove (MULTIGRID *theMG, const ELEMENT *theElement);
+
+/** \brief Cached affine map of a simplex, NULL for other elements or if the cache is disabled */
+const ElementGeometry *GetElementGeometry (MULTIGRID *theMG, const ELEMENT *theElement);
+
+/** \brief Local coordinates of a global point in an element */
+INT ElementGlobalToLocal (MULTIGRID *theMG, const ELEMENT *theElement, const DOUBLE *global, DOUBLE *local);
+
+/** \brief Global coordinates of a local point in an element */
+void ElementLocalToGlobal (MULTIGRID *theMG, const ELEMENT *theElement, const DOUBLE *local, DOUBLE *global);
+
+/** \brief Volume of an element */
+DOUBLE ElementVolumeCached (MULTIGRID *theMG, const ELEMENT *theElement);
+
+/** \brief Determine whether a point is contained in an element */
+bool PointInElementCached (MULTIGRID *theMG, const DOUBLE *global, const ELEMENT *theElement);
+
+END_UGDIM_NAMESPACE
+
+#endif
+
+/** @} */
@@ -54,6 +54,7 @@
 #include <unordered_map>
 #include <array>
 #include <numeric>
+#include <vector>
 
 #include <dune/uggrid/domain/domain.h>
 #include <dune/uggrid/low/debug.h>
@@ -95,6 +96,12 @@
 #define DEBUG_MODE "OFF"
 #endif
 
+/* optional fields of nodes and elements, see the UG_* layout options of the */
+/* build system (UG_NO_NODE_ELEMENTLIST, UG_NO_MESSAGE_BUFFER)               */
+#if defined(ModelP) && !defined(UG_NO_MESSAGE_BUFFER)
+#define UG_HAS_MESSAGE_BUFFER
+#endif
+
 START_UGDIM_NAMESPACE
 
 /****************************************************************************/
@@ -613,6 +620,15 @@ struct bvertex {
   BNDP *bndp;
 };
 
+#ifdef UG_HAS_MESSAGE_BUFFER
+/** \brief Bit of a stored message buffer size marking the buffer as a view
+ *
+ * Views point into the migration arena of the multigrid (see
+ * AllocMigrationUserData()) and are not freed by message_buffer_free().
+ */
+constexpr std::size_t MESSAGE_BUFFER_VIEW = ~(~std::size_t(0) >> 1);
+#endif
+
 /** \brief Only used to define pointer to vertex */
 union vertex {
   struct ivertex iv;
@@ -644,7 +660,7 @@ struct node {
   /** \brief Information if this node is on the leaf. */
   bool isLeaf;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer_;
 
@@ -673,22 +689,27 @@ struct node {
   /** \brief Corresponding vertex structure               */
   union vertex *myvertex;
 
+#ifndef UG_NO_NODE_ELEMENTLIST
+  /** \brief Associated data pointer (element list, see CreateElementList()) */
+  void *data;
+#endif
+
   /** \brief Associated vector
    *
-   * WARNING: the allocation of the vector pointer depends on the format */
+   * WARNING: the allocation of the vector pointer depends on the format,
+   * it must stay the last member (see CreateNode()) */
   VECTOR *vector;
 
-  /** \brief Associated data pointer
-   *
-   * WARNING: The allocation of the data pointer depends on the format */
-  void *data;
-
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   const char* message_buffer() const
     { return message_buffer_; }
 
   std::size_t message_buffer_size() const
-  { return message_buffer_size_; }
+  { return message_buffer_size_ & ~MESSAGE_BUFFER_VIEW; }
+
+  /** \brief True if the buffer is owned by the migration arena */
+  bool message_buffer_is_view() const
+  { return message_buffer_size_ & MESSAGE_BUFFER_VIEW; }
 
   void message_buffer(char* p, std::size_t size)
   {
@@ -696,9 +717,17 @@ struct node {
     message_buffer_size_ = size;
   }
 
+  /** \brief Refer to data owned by the migration arena without taking ownership */
+  void message_buffer_view(char* p, std::size_t size)
+  {
+    message_buffer_ = p;
+    message_buffer_size_ = size | MESSAGE_BUFFER_VIEW;
+  }
+
   void message_buffer_free()
   {
-    std::free(message_buffer_);
+    if (!message_buffer_is_view())
+      std::free(message_buffer_);
     message_buffer(nullptr, 0);
   }
 #endif
@@ -787,7 +816,7 @@ struct generic_element {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -844,7 +873,7 @@ struct triangle {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -930,7 +959,7 @@ struct quadrilateral {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -1017,7 +1046,7 @@ struct tetrahedron {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -1109,7 +1138,7 @@ struct pyramid {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -1199,7 +1228,7 @@ struct prism {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -1290,7 +1319,7 @@ struct hexahedron {
       Controlled by DUNE */
   int leafIndex;
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /** \brief Per-node message buffer used by Dune for dynamic load-balancing */
   char* message_buffer;
 
@@ -1366,12 +1395,16 @@ union element {
   struct hexahedron he;
         #endif
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   const char* message_buffer() const
     { return ge.message_buffer; }
 
   std::size_t message_buffer_size() const
-  { return ge.message_buffer_size; }
+  { return ge.message_buffer_size & ~MESSAGE_BUFFER_VIEW; }
+
+  /** \brief True if the buffer is owned by the migration arena */
+  bool message_buffer_is_view() const
+  { return ge.message_buffer_size & MESSAGE_BUFFER_VIEW; }
 
   void message_buffer(char* p, std::size_t size)
   {
@@ -1379,9 +1412,17 @@ union element {
     ge.message_buffer_size = size;
   }
 
+  /** \brief Refer to data owned by the migration arena without taking ownership */
+  void message_buffer_view(char* p, std::size_t size)
+  {
+    ge.message_buffer = p;
+    ge.message_buffer_size = size | MESSAGE_BUFFER_VIEW;
+  }
+
   void message_buffer_free()
   {
-    std::free(ge.message_buffer);
+    if (!message_buffer_is_view())
+      std::free(ge.message_buffer);
     message_buffer(nullptr, 0);
   }
 #endif
@@ -1413,6 +1454,21 @@ typedef struct
   UINT VecCollectStatus[MAXMATRICES][MAX_NDOF_MOD_32];
 } DATA_STATUS;
 
+/* defined in adjacency.h */
+struct NodeAdjacency;
+
+/* defined in algebra.h */
+struct SparsityPattern;
+
+/* defined in indexsets.h */
+struct MultiGridIndexSets;
+
+/* defined in geomcache.h */
+struct GeometryCache;
+
+/* defined in ugio.cc */
+struct SaveCache;
+
 struct grid {
 
   /** \brief Object identification, various flags */
@@ -1569,12 +1625,51 @@ struct multigrid {
   /** \brief coarse grid MarkKey for SIMPLE_HEAP Mark/Release     */
   INT MarkKey;
 
+  /** \brief Incremented whenever the grid topology changes
+   *
+   * Caches derived from the grid (adjacency, sparsity patterns, ...)
+   * remember the revision they were built for and are rebuilt lazily
+   * when it no longer matches.
+   */
+  unsigned int topologyRevision = 0;
+
+  /** \brief Lazily built node adjacency of each level, see adjacency.h */
+  std::array<std::shared_ptr<NodeAdjacency>, MAXLEVEL> nodeAdjacency;
+
+  /** \brief Cached CSR sparsity patterns of the levels, see algebra.h */
+  std::array<std::shared_ptr<SparsityPattern>, MAXLEVEL> levelPattern;
+
+  /** \brief Cached CSR sparsity pattern of the surface, see algebra.h */
+  std::shared_ptr<SparsityPattern> surfacePattern;
+
+  /** \brief Maintained level and leaf indices, NULL unless enabled, see indexsets.h */
+  std::shared_ptr<MultiGridIndexSets> indexSets;
+
+  /** \brief Cached affine maps of simplices, NULL unless enabled, see geomcache.h */
+  std::shared_ptr<GeometryCache> geometryCache;
+
+  /** \brief Rule table and numbering of the last save, see ugio.cc */
+  std::shared_ptr<SaveCache> saveCache;
+
   const PPIF::PPIFContext& ppifContext() const
     { return *ppifContext_; }
 
   std::shared_ptr<PPIF::PPIFContext> ppifContext_;
 
+#ifdef UG_HAS_MESSAGE_BUFFER
+  /** \brief Chunks holding the user data received by the last migration
+   *
+   * Received message buffers are views into these chunks. They are
+   * released all at once by ReleaseMigrationUserData().
+   */
+  std::vector<std::unique_ptr<char[]> > migrationUserData;
+
+  /** \brief Unused bytes at the end of the last chunk of migrationUserData */
+  std::size_t migrationUserDataFree = 0;
+#endif
+
 #ifdef ModelP
+
   const DDD::DDDContext& dddContext() const
     { return *dddContext_; }
 
@@ -1582,6 +1677,9 @@ struct multigrid {
     { return *dddContext_; }
 
   std::shared_ptr<DDD::DDDContext> dddContext_;
+
+  /** \brief Number of layers of horizontal ghost elements, see TransferGridFromLevel */
+  INT overlapDepth = 1;
 #endif
 };
 
@@ -1751,6 +1849,7 @@ enum GM_CE {
   VCCOARSE_CE,
   NEW_DEFECT_CE,
   VACTIVE_CE,
+  VROWCHANGED_CE,
   FINE_GRID_DOF_CE,
   MOFFSET_CE,
   MROOTTYPE_CE,
@@ -1842,6 +1941,7 @@ enum LV_ID_TYPES {
 /* VNEW          |19    |*| | 1 if vector is new                                                                */
 /* VCNEW         |20    |*| | 1 if vector has a new connection                                  */
 /* VACTIVE   |24        |*| | 1 if vector is active inside a smoother                   */
+/* VROWCHANGED|25       |*| | 1 if the matrix row changed since the last pattern update */
 /* VCCUT         |26    |*| |                                                                                                   */
 /* VTYPE         |27-28 |*| | abstract vector type                                                              */
 /* VPART         |29-30 |*| | domain part                                                                               */
@@ -1989,6 +2089,11 @@ enum LV_ID_TYPES {
 #define VACTIVE(p)                                  CW_READ_STATIC(p,VACTIVE_,VECTOR_)
 #define SETVACTIVE(p,n)                     CW_WRITE_STATIC(p,VACTIVE_,VECTOR_,n)
 
+#define VROWCHANGED_SHIFT                   25
+#define VROWCHANGED_LEN                             1
+#define VROWCHANGED(p)                              CW_READ_STATIC(p,VROWCHANGED_,VECTOR_)
+#define SETVROWCHANGED(p,n)                 CW_WRITE_STATIC(p,VROWCHANGED_,VECTOR_,n)
+
 #define VCFLAG(p)                                       THEFLAG(p)
 #define SETVCFLAG(p,n)                          SETTHEFLAG(p,n)
 
@@ -2174,7 +2279,8 @@ enum LV_ID_TYPES {
 /* elements:                                                                                                                            */
 /* ECLASS        |8-9   | | | |*| | |element class from enumeration type                */
 /* NSONS         |10-13 | | | |*| | |number of sons                                                     */
-/* NEWEL         |14    | | | |*| | |element just created                                               */
+/* NEWEL         |14    | | | |*| | |element created, received or refined since     */
+/*                                   the last CheckElements(CHECK_NEW_ELEMENTS)     */
 /* VSIDES        |11-14 | | | |*| | |viewable sides                                                     */
 /* NORDER        |15-19 | | | |*| | |view position order of the nodes                   */
 /* CUTMODE       |26-27 | | | |*| | |elem intersects cutplane or...                     */
@@ -2376,10 +2482,12 @@ enum GM_OBJECTS {
 
 #define SONNODE(p)                      ((p)->son)
 #define MYVERTEX(p)             ((p)->myvertex)
-#define NDATA(p)                        ((p)->data)
 #define NVECTOR(p)                      ((p)->vector)
 
+#ifndef UG_NO_NODE_ELEMENTLIST
+#define NDATA(p)                        ((p)->data)
 #define NODE_ELEMENT_LIST(p)    ((ELEMENTLIST *)(p)->data)
+#endif
 #define ELEMENT_PTR(p)                  ((p)->el)
 
 /****************************************************************************/
@@ -2923,6 +3031,8 @@ grid::dddContext()
 #define MG_FILENAME(p)                  ((p)->filename)
 #define MG_COARSE_FIXED(p)              ((p)->CoarseGridFixed)
 #define MG_MARK_KEY(p)              ((p)->MarkKey)
+#define MG_TOPOLOGY_REVISION(p)         ((p)->topologyRevision)
+#define MG_TOPOLOGY_CHANGED(p)          (++(p)->topologyRevision)
 
 /****************************************************************************/
 /*                                                                          */
@@ -3028,7 +3138,7 @@ MULTIGRID               *GetFirstMultigrid                      (void);
 MULTIGRID               *GetNextMultigrid                       (const MULTIGRID *theMG);
 
 /* format definition */
-std::unique_ptr<FORMAT> CreateFormat ();
+std::unique_ptr<FORMAT> CreateFormat (const char *formatName);
 
 /* create, saving and disposing a multigrid structure */
 MULTIGRID *CreateMultiGrid (char *MultigridName, char *BndValProblem,
@@ -3116,6 +3226,15 @@ INT                     CheckGrid                               (GRID *theGrid,
 INT                     CheckGrid                               (GRID *theGrid, INT checkgeom, INT checkalgebra, INT checklists, INT checkif);
 #endif
 INT                     CheckLists                              (GRID *theGrid);
+
+/** \brief Elements checked by CheckElements */
+enum CheckElementSelection {
+  CHECK_ALL_ELEMENTS,        /**< all elements of the grid level            */
+  CHECK_SAMPLED_ELEMENTS,    /**< a random fraction of the elements         */
+  CHECK_NEW_ELEMENTS         /**< elements created, received or refined since the last check of this kind */
+};
+
+INT             CheckElements                   (GRID *theGrid, INT selection, DOUBLE fraction, INT seed);
 INT             CheckSubdomains                 (MULTIGRID *theMG);
 
 /* multigrid user data space management (using the heaps.c block heap management) */
@@ -38,12 +38,19 @@
 #include <cstring>
 #include <cmath>
 #include <cassert>
+#include <cstdarg>
 #include <errno.h>
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include <dune/uggrid/low/debug.h>
 #include <dune/uggrid/low/fifo.h>
 #include <dune/uggrid/low/heaps.h>
 #include <dune/uggrid/low/misc.h>
+#include <dune/uggrid/low/threads.h>
 #include <dune/uggrid/low/ugenv.h>
 #include <dune/uggrid/low/ugstruct.h>
 #include <dune/uggrid/low/ugtypes.h>
@@ -86,6 +93,9 @@ using namespace PPIF;
 #define ORDERRES                1e-3    /* resolution for OrderNodesInGrid			*/
 #define LINKTABLESIZE   32              /* max number of inks per node for ordering	*/
 
+#define CHECK_BUFLEN    512             /* max length of one line of check output   */
+#define CHECK_MINCHUNK  256             /* min number of elements per check thread  */
+
 /****************************************************************************/
 /*                                                                          */
 /* data structures used in this source file (exported data structures are   */
@@ -108,8 +118,32 @@ using namespace PPIF;
 
 static DOUBLE hghost_overlap = 1.0;
 
+/* output of the element checks running on the current thread, */
+/* NULL if it is written directly                              */
+static thread_local std::string *checkOutput = NULL;
+
 REP_ERR_FILE;
 
+static void CheckWrite (const char *s)
+{
+  if (checkOutput != NULL)
+    checkOutput->append(s);
+  else
+    UserWrite(s);
+}
+
+static void CheckWriteF (const char *format, ...)
+{
+  char buffer[CHECK_BUFLEN];
+  va_list args;
+
+  va_start(args,format);
+  vsnprintf(buffer,CHECK_BUFLEN,format,args);
+  va_end(args);
+
+  CheckWrite(buffer);
+}
+
 /****************************************************************************/
 /*                                                                          */
 /* forward declarations of functions used before they are defined           */
@@ -136,11 +170,11 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
       Node = (NODE*) NFATHER(Node);
     }
     if (cnt != 1) {
-      UserWriteF("elem=" EID_FMTX " node=" ID_FMTX
-                 " vertex=" VID_FMTX
-                 " NOOFNODE %d wrong\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),
-                 VID_PRTX(theVertex), NOOFNODE(theVertex));
+      CheckWriteF("elem=" EID_FMTX " node=" ID_FMTX
+                  " vertex=" VID_FMTX
+                  " NOOFNODE %d wrong\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),
+                  VID_PRTX(theVertex), NOOFNODE(theVertex));
       nerrors = 1;
     }
   }
@@ -157,17 +191,17 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
     }
     if (nerrors == 0) return(nerrors);
         #endif
-    UserWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
-               " VFATHER=NULL vertex needs VFATHER\n",EID_PRTX(theElement),ID_PRTX(theNode),
-               VID_PRTX(theVertex));
+    CheckWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
+                " VFATHER=NULL vertex needs VFATHER\n",EID_PRTX(theElement),ID_PRTX(theNode),
+                VID_PRTX(theVertex));
     return(nerrors++);
   }
 
   if (theFather!=NULL && HEAPCHECK(theFather))
   {
-    UserWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
-               " VFATHER=%x is pointer to ZOMBIE\n",EID_PRTX(theElement),ID_PRTX(theNode),
-               VID_PRTX(theVertex),theFather);
+    CheckWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
+                " VFATHER=%x is pointer to ZOMBIE\n",EID_PRTX(theElement),ID_PRTX(theNode),
+                VID_PRTX(theVertex),theFather);
     return(nerrors++);
   }
 
@@ -184,9 +218,9 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
     }
         #endif
     if (nerrors == 0) return(nerrors);
-    UserWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
-               " VFATHER=" EID_FMTX " vertex needs VFATHER with prio master or vghost\n",
-               EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex),EID_PRTX(theFather));
+    CheckWriteF("elem=" EID_FMTX " node=" ID_FMTX " vertex=" VID_FMTX
+                " VFATHER=" EID_FMTX " vertex needs VFATHER with prio master or vghost\n",
+                EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex),EID_PRTX(theFather));
     return(nerrors++);
   }
 
@@ -209,10 +243,10 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
                         #endif
       if (nerrors >= 1)
       {
-        UserWriteF("elem=" EID_FMTX " node=" ID_FMTX "/%d vertex=" VID_FMTX
-                   " WARNING VFATHER=%x WARNING diff %f local and global coordinates don't match\n",
-                   EID_PRTX(theElement),ID_PRTX(theNode),
-                   NTYPE(theNode),VID_PRTX(theVertex),theFather,diff);
+        CheckWriteF("elem=" EID_FMTX " node=" ID_FMTX "/%d vertex=" VID_FMTX
+                    " WARNING VFATHER=%x WARNING diff %f local and global coordinates don't match\n",
+                    EID_PRTX(theElement),ID_PRTX(theNode),
+                    NTYPE(theNode),VID_PRTX(theVertex),theFather,diff);
       }
     }
   }
@@ -222,9 +256,9 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
   case (CORNER_NODE) :
     if (LEVEL(theVertex)==0 && theFather != NULL)
     {
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                 " VID=" VID_FMTX " CORNER_NODE has VFATHER\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                  " VID=" VID_FMTX " CORNER_NODE has VFATHER\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
     }
 
                         #ifdef ModelP
@@ -236,9 +270,9 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
 
     if (LEVEL(theVertex)>0 && theFather == NULL)
     {
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                 " VID=" VID_FMTX " CORNER_NODE has no VFATHER\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                  " VID=" VID_FMTX " CORNER_NODE has no VFATHER\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
     }
     break;
 
@@ -253,9 +287,9 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
       ENDDEBUG
                                 #endif
 
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                 " VID=" VID_FMTX " MID_NODE VFATHER=NULL\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                  " VID=" VID_FMTX " MID_NODE VFATHER=NULL\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
       nerrors++;
       break;
     }
@@ -275,10 +309,10 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
       }
                 #endif
       if (nerrors == 0) break;
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX " VID=" VID_FMTX
-                 " ONEDGE and VFATHER incompatible edgeptr=%08x\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),
-                 VID_PRTX(theVertex),theEdge);
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX " VID=" VID_FMTX
+                  " ONEDGE and VFATHER incompatible edgeptr=%08x\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),
+                  VID_PRTX(theVertex),theEdge);
     }
     break;
 
@@ -296,18 +330,18 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
       }
                 #endif
       if (nerrors == 0) break;
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                 " VID=" VID_FMTX " SIDE_NODE VFATHER=NULL\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                  " VID=" VID_FMTX " SIDE_NODE VFATHER=NULL\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
       break;
     }
     else {
       if (GetSideNode(theFather,ONSIDE(theVertex)) != theNode) {
         nerrors = 1;
-        UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                   " VID=" VID_FMTX " inconsistent ONSIDE entry\n",
-                   EID_PRTX(theElement),ID_PRTX(theNode),
-                   VID_PRTX(theVertex));
+        CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                    " VID=" VID_FMTX " inconsistent ONSIDE entry\n",
+                    EID_PRTX(theElement),ID_PRTX(theNode),
+                    VID_PRTX(theVertex));
       }
     }
     break;
@@ -326,9 +360,9 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
       }
                 #endif
       if (nerrors == 0) break;
-      UserWriteF("EID=" EID_FMTX " NID=" ID_FMTX
-                 " VID=" VID_FMTX " CENTER_NODE VFATHER=NULL\n",
-                 EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " NID=" ID_FMTX
+                  " VID=" VID_FMTX " CENTER_NODE VFATHER=NULL\n",
+                  EID_PRTX(theElement),ID_PRTX(theNode),VID_PRTX(theVertex));
       break;
     }
     break;
@@ -337,26 +371,26 @@ static INT CheckVertex (ELEMENT *theElement, NODE* theNode, VERTEX *theVertex)
   return(nerrors);
 }
 
-static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
+static INT CheckNode (GRID *theGrid, ELEMENT *theElement, NODE* theNode, INT i)
 {
   VERTEX  *theVertex      = MYVERTEX(theNode);
   NODE    *FatherNode;
   EDGE    *FatherEdge;
   INT nerrors         = 0;
 
-  SETUSED(theNode,1);
-
   if (OBJT(theNode) != NDOBJ)
   {
-    UserWriteF(" node=" ID_FMTX " has wrong OBJ=%d\n",
-               ID_PRTX(theNode),OBJT(theNode));
+    CheckWriteF(" node=" ID_FMTX " has wrong OBJ=%d\n",
+                ID_PRTX(theNode),OBJT(theNode));
     return(nerrors++);
   }
 
-  if (NVECTOR(theNode)!=NULL && VOBJECT(NVECTOR(theNode)) == NULL)
+  /* nodes of formats without node vectors are allocated without the pointer */
+  if (VEC_DEF_IN_OBJ_OF_GRID(theGrid,NODEVEC)
+      && NVECTOR(theNode)!=NULL && VOBJECT(NVECTOR(theNode)) == NULL)
   {
-    UserWriteF(" node=" ID_FMTX " has vector" ID_FMTX "  with VOBJ=NULL\n",
-               ID_PRTX(theNode),ID_PRTX(NVECTOR(theNode)));
+    CheckWriteF(" node=" ID_FMTX " has vector" ID_FMTX "  with VOBJ=NULL\n",
+                ID_PRTX(theNode),ID_PRTX(NVECTOR(theNode)));
     return(nerrors++);
   }
 
@@ -364,9 +398,9 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
   {
   case (LEVEL_0_NODE) :
     if (LEVEL(theNode) > 0) {
-      UserWriteF(" node=" ID_FMTX " has NTYPE=LEVEL_0_NODE"
-                 " but is on level=%d\n",
-                 ID_PRTX(theNode),LEVEL(theNode));
+      CheckWriteF(" node=" ID_FMTX " has NTYPE=LEVEL_0_NODE"
+                  " but is on level=%d\n",
+                  ID_PRTX(theNode),LEVEL(theNode));
       return(nerrors++);
     }
     break;
@@ -376,8 +410,8 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
     if (0) /* this code is for special debugging (980204 s.l.) */
       if (GID(theNode)==0x11011 && FatherNode!=NULL)
       {
-        UserWriteF(" cornernode=" ID_FMTX " has father=" ID_FMTX "\n",
-                   ID_PRTX(theNode),ID_PRTX(FatherNode));
+        CheckWriteF(" cornernode=" ID_FMTX " has father=" ID_FMTX "\n",
+                    ID_PRTX(theNode),ID_PRTX(FatherNode));
       }
 
     if (FatherNode == NULL)
@@ -386,22 +420,22 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
       if (MASTER(theNode))
       {
                                         #endif
-      UserWriteF(" ERROR cornernode=" ID_FMTX " has no father level=%d\n",
-                 ID_PRTX(theNode),LEVEL(theNode));
-      UserWriteF(" elem=" EID_FMTX, EID_PRTX(theElement));
+      CheckWriteF(" ERROR cornernode=" ID_FMTX " has no father level=%d\n",
+                  ID_PRTX(theNode),LEVEL(theNode));
+      CheckWriteF(" elem=" EID_FMTX, EID_PRTX(theElement));
       if (EFATHER(theElement) != NULL)
       {
         INT i;
         ELEMENT *theFather = EFATHER(theElement);
 
-        UserWriteF(" father=" EID_FMTX "\n",EID_PRTX(theFather));
+        CheckWriteF(" father=" EID_FMTX "\n",EID_PRTX(theFather));
         for (i=0; i<CORNERS_OF_ELEM(theFather); i++)
         {
-          UserWriteF("son[%d]=" ID_FMTX "\n",i,ID_PRTX(CORNER(theFather,i)));
+          CheckWriteF("son[%d]=" ID_FMTX "\n",i,ID_PRTX(CORNER(theFather,i)));
         }
       }
       else
-        UserWriteF(" father=NULL\n");
+        CheckWriteF(" father=NULL\n");
 
       nerrors++;
                                         #ifdef ModelP
@@ -413,8 +447,8 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
       print = 1;
       ENDDEBUG
       if (print)
-        UserWriteF(" WARN cornernode=" ID_FMTX " has no father level=%d\n",
-                   ID_PRTX(theNode),LEVEL(theNode));
+        CheckWriteF(" WARN cornernode=" ID_FMTX " has no father level=%d\n",
+                    ID_PRTX(theNode),LEVEL(theNode));
     }
                                         #endif
     }
@@ -422,26 +456,26 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
     {
       if (HEAPCHECK(FatherNode))
       {
-        UserWriteF("elem=" EID_FMTX " cornernode=%d NID=" ID_FMTX
-                   " has father pointer to ZOMBIE\n",EID_PRTX(theElement),ID_PRTX(theNode));
+        CheckWriteF("elem=" EID_FMTX " cornernode=%d NID=" ID_FMTX
+                    " has father pointer to ZOMBIE\n",EID_PRTX(theElement),ID_PRTX(theNode));
         nerrors++;
         break;
       }
 
       if (OBJT(FatherNode) != NDOBJ)
       {
-        UserWriteF(" cornernode=" ID_FMTX
-                   " has father of wrong type=%d\n",
-                   ID_PRTX(theNode),OBJT(FatherNode));
+        CheckWriteF(" cornernode=" ID_FMTX
+                    " has father of wrong type=%d\n",
+                    ID_PRTX(theNode),OBJT(FatherNode));
         nerrors++;
       }
       else
       {
         if (SONNODE(FatherNode) != theNode)
         {
-          UserWriteF(" cornernode=" ID_FMTX
-                     " has node father=" ID_FMTX " with wrong backptr=%x\n",
-                     ID_PRTX(theNode),ID_PRTX(FatherNode),SONNODE(FatherNode));
+          CheckWriteF(" cornernode=" ID_FMTX
+                      " has node father=" ID_FMTX " with wrong backptr=%x\n",
+                      ID_PRTX(theNode),ID_PRTX(FatherNode),SONNODE(FatherNode));
           /* TODO: this should be deleted */
           if (0) SONNODE(FatherNode) = theNode;
           else nerrors++;
@@ -461,21 +495,21 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
         if (MASTER(theNode))
         {
                                         #endif
-        UserWriteF(" ERROR midnode=" ID_FMTX " has no father level=%d\n",
-                   ID_PRTX(theNode),LEVEL(theNode));
-        UserWriteF(" elem=" EID_FMTX, EID_PRTX(theElement));
+        CheckWriteF(" ERROR midnode=" ID_FMTX " has no father level=%d\n",
+                    ID_PRTX(theNode),LEVEL(theNode));
+        CheckWriteF(" elem=" EID_FMTX, EID_PRTX(theElement));
         if (EFATHER(theElement) != NULL)
-          UserWriteF(" father=" EID_FMTX "\n",EID_PRTX(EFATHER(theElement)));
+          CheckWriteF(" father=" EID_FMTX "\n",EID_PRTX(EFATHER(theElement)));
         else
-          UserWriteF(" father=NULL\n");
+          CheckWriteF(" father=NULL\n");
         nerrors++;
                                         #ifdef ModelP
       }
       else
       {
         IFDEBUG(gm,1)
-        UserWriteF(" WARN midnode=" ID_FMTX " has no father level=%d\n",
-                   ID_PRTX(theNode),LEVEL(theNode));
+        CheckWriteF(" WARN midnode=" ID_FMTX " has no father level=%d\n",
+                    ID_PRTX(theNode),LEVEL(theNode));
         ENDDEBUG
       }
                                         #endif
@@ -484,18 +518,18 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
       {
         if (HEAPCHECK(FatherEdge))
         {
-          UserWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX
-                     " fatherpointer to edge=%d/%x is ZOMBIE\n",EID_PRTX(theElement),
-                     ID_PRTX(theNode),i,FatherEdge);
+          CheckWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX
+                      " fatherpointer to edge=%d/%x is ZOMBIE\n",EID_PRTX(theElement),
+                      ID_PRTX(theNode),i,FatherEdge);
           nerrors++;
           break;
         }
 
         if (OBJT(FatherEdge) != EDOBJ)
         {
-          UserWriteF(" midnode=" ID_FMTX
-                     " has father of wrong type=%d obj=\n",
-                     ID_PRTX(theNode),OBJT(FatherEdge));
+          CheckWriteF(" midnode=" ID_FMTX
+                      " has father of wrong type=%d obj=\n",
+                      ID_PRTX(theNode),OBJT(FatherEdge));
           nerrors++;
         }
         else
@@ -503,9 +537,9 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
 
           if (MIDNODE(FatherEdge) != theNode)
           {
-            UserWriteF(" midnode=" ID_FMTX
-                       " has edge  father=" ID_FMTX " with wrong backptr=%x\n",
-                       ID_PRTX(theNode),ID_PRTX(FatherEdge),MIDNODE(FatherEdge));
+            CheckWriteF(" midnode=" ID_FMTX
+                        " has edge  father=" ID_FMTX " with wrong backptr=%x\n",
+                        ID_PRTX(theNode),ID_PRTX(FatherEdge),MIDNODE(FatherEdge));
             /* TODO: this should be deleted */
             if (0) MIDNODE(FatherEdge) = theNode;
             else nerrors++;
@@ -516,8 +550,8 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
     }
     else
     {
-      UserWriteF(" node=" ID_FMTX " is midnode BUT on level=%d\n",
-                 ID_PRTX(theNode),LEVEL(theNode));
+      CheckWriteF(" node=" ID_FMTX " is midnode BUT on level=%d\n",
+                  ID_PRTX(theNode),LEVEL(theNode));
       nerrors++;
     }
     break;
@@ -529,8 +563,8 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
     break;
 
   default :
-    UserWriteF(" node=" ID_FMTX " has unrecognized NTYPE=%d\n",
-               ID_PRTX(theNode),NTYPE(theNode));
+    CheckWriteF(" node=" ID_FMTX " has unrecognized NTYPE=%d\n",
+                ID_PRTX(theNode),NTYPE(theNode));
     break;
   }
 
@@ -540,8 +574,8 @@ static INT CheckNode (ELEMENT *theElement, NODE* theNode, INT i)
   }
   else
   {
-    UserWriteF("elem=" EID_FMTX " node[%d]=" ID_FMTX " vertex=NULL\n",
-               EID_PRTX(theElement),i,ID_PRTX(theNode));
+    CheckWriteF("elem=" EID_FMTX " node[%d]=" ID_FMTX " vertex=NULL\n",
+                EID_PRTX(theElement),i,ID_PRTX(theNode));
     nerrors++;
   }
 
@@ -554,8 +588,6 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
   NODE    *theNode;
   VERTEX  *theVertex;
 
-  SETUSED(theEdge,1);
-
   /** \todo Commented out because it uses GetElemLink, which does not exist */
 #if 0
 #       if defined(__TWODIM__)
@@ -592,19 +624,19 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
 
     if (no_of_elem==0 || No_Of_Elem!=no_of_elem)
     {
-      UserWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " NO_OF_ELEM wrong"
-                 "NO_OF_ELEM=%d no_of_elem=%d\n",
-                 EID_PRTX(theElement),i,EDID_PRTX(theEdge),No_Of_Elem,no_of_elem);
+      CheckWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " NO_OF_ELEM wrong"
+                  "NO_OF_ELEM=%d no_of_elem=%d\n",
+                  EID_PRTX(theElement),i,EDID_PRTX(theEdge),No_Of_Elem,no_of_elem);
     }
 
     if (elemlink == 0)
     {
       if (e0 != theElement)
       {
-        UserWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " LELEM0 wrong"
-                   "elemlink=%d LELEM0=%08x\n",
-                   EID_PRTX(theElement),i,EDID_PRTX(theEdge),elemlink,
-                   (e0!=NULL) ? EGID(e0) : 0);
+        CheckWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " LELEM0 wrong"
+                    "elemlink=%d LELEM0=%08x\n",
+                    EID_PRTX(theElement),i,EDID_PRTX(theEdge),elemlink,
+                    (e0!=NULL) ? EGID(e0) : 0);
         nerrors++;
       }
     }
@@ -612,10 +644,10 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
     {
       if (e1 != theElement)
       {
-        UserWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " LELEM0 wrong"
-                   "elemlink=%d LELEM0=%08x\n",
-                   EID_PRTX(theElement),i,EDID_PRTX(theEdge),elemlink,
-                   (e1!=NULL) ? EGID(e1) : 0);
+        CheckWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " LELEM0 wrong"
+                    "elemlink=%d LELEM0=%08x\n",
+                    EID_PRTX(theElement),i,EDID_PRTX(theEdge),elemlink,
+                    (e1!=NULL) ? EGID(e1) : 0);
         nerrors++;
       }
     }
@@ -637,8 +669,8 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
         #ifdef ModelP
       IFDEBUG(gm,1)
             #endif
-      UserWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " midnode NID=NULL"
-                 " BUT REFINE(elem)=RED\n",EID_PRTX(theElement),i,EDID_PRTX(theEdge));
+      CheckWriteF("elem=" EID_FMTX " edge%d=" EDID_FMTX " midnode NID=NULL"
+                  " BUT REFINE(elem)=RED\n",EID_PRTX(theElement),i,EDID_PRTX(theEdge));
       nerrors++;
                 #ifdef ModelP
       ENDDEBUG
@@ -651,16 +683,16 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
 
   if (HEAPCHECK(theNode))
   {
-    UserWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX
-               " is pointer to ZOMBIE\n",EID_PRTX(theElement),i,theEdge,ID_PRTX(theNode));
+    CheckWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX
+                " is pointer to ZOMBIE\n",EID_PRTX(theElement),i,theEdge,ID_PRTX(theNode));
     return(nerrors++);
   }
 
   theVertex = MYVERTEX(theNode);
   if (theVertex == NULL)
   {
-    UserWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX " vertex=NULL\n",
-               EID_PRTX(theElement),i,theEdge,ID_PRTX(theNode));
+    CheckWriteF("elem=" EID_FMTX " edge=%d/%x midnode NID=" ID_FMTX " vertex=NULL\n",
+                EID_PRTX(theElement),i,theEdge,ID_PRTX(theNode));
     return(nerrors++);
   }
 
@@ -672,16 +704,16 @@ static INT CheckEdge (ELEMENT *theElement, EDGE* theEdge, INT i)
     if (EGHOST(theElement))
     {
       IFDEBUG(gm,1)
-      UserWriteF("EID=" EID_FMTX " VID=" VID_FMTX
-                 " WARNING edgenumber of vertex wrong\n",
-                 EID_PRTX(theElement),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " VID=" VID_FMTX
+                  " WARNING edgenumber of vertex wrong\n",
+                  EID_PRTX(theElement),VID_PRTX(theVertex));
       ENDDEBUG
     }
     else
     {
-      UserWriteF("EID=" EID_FMTX " VID=" VID_FMTX
-                 " ERROR edgenumber of vertex wrong\n",
-                 EID_PRTX(theElement),VID_PRTX(theVertex));
+      CheckWriteF("EID=" EID_FMTX " VID=" VID_FMTX
+                  " ERROR edgenumber of vertex wrong\n",
+                  EID_PRTX(theElement),VID_PRTX(theVertex));
       /*nerrors++;  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
     }
     return(nerrors);
@@ -707,9 +739,9 @@ int EdgeHasTMasterCopy (DDD::DDDContext& context, ELEMENT *e, int i)
 
   if (nall > 2)
   {
-    UserWriteF("EID=" EID_FMTX " EDID=" EDID_FMTX
-               " ERROR edge%d has mastertype prios=%d\n",
-               EID_PRTX(e),EDID_PRTX(edge),i,nall);
+    CheckWriteF("EID=" EID_FMTX " EDID=" EDID_FMTX
+                " ERROR edge%d has mastertype prios=%d\n",
+                EID_PRTX(e),EDID_PRTX(edge),i,nall);
   }
 
   return(nall-1);
@@ -742,8 +774,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
   /* check level */
   if (GLEVEL(theGrid) != LEVEL(theElement))
   {
-    UserWriteF("elem=" EID_FMTX " ERROR level=%2d but gridlevel=%2d\n",
-               EID_PRTX(theElement),LEVEL(theElement),GLEVEL(theGrid));
+    CheckWriteF("elem=" EID_FMTX " ERROR level=%2d but gridlevel=%2d\n",
+                EID_PRTX(theElement),LEVEL(theElement),GLEVEL(theGrid));
     nerrors++;
   }
 
@@ -756,9 +788,9 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
           k = CORNER_OF_SIDE(theElement,i,j);
           theNode = CORNER(theElement,k);
           if (NSUBDOM(theNode) != 0) {
-            UserWriteF("wrong subdomain id(%d) on boundary node,"
-                       "el =  " EID_FMTX ", side = %d, corner = %d, node = " ID_FMTX "\n",
-                       NSUBDOM(theNode),EID_PRTX(theElement),i,k,ID_PRTX(theNode));
+            CheckWriteF("wrong subdomain id(%d) on boundary node,"
+                        "el =  " EID_FMTX ", side = %d, corner = %d, node = " ID_FMTX "\n",
+                        NSUBDOM(theNode),EID_PRTX(theElement),i,k,ID_PRTX(theNode));
             bserror |= (1<<i);
             nerrors++;
           }
@@ -771,11 +803,11 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
                                    CORNER_OF_EDGE(theElement,k,1)));
           ASSERT(theEdge != NULL);
           if (EDSUBDOM(theEdge) != 0) {
-            UserWriteF("wrong subdomain id(%d) on boundary edge %d,"
-                       "el =  " EID_FMTX ", side = %d, edge = %d, corner0 = " ID_FMTX ", corner1 = " ID_FMTX "\n",
-                       EDSUBDOM(theEdge),k,EID_PRTX(theElement), i, j,
-                       ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,k,0))),
-                       ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,k,1))));
+            CheckWriteF("wrong subdomain id(%d) on boundary edge %d,"
+                        "el =  " EID_FMTX ", side = %d, edge = %d, corner0 = " ID_FMTX ", corner1 = " ID_FMTX "\n",
+                        EDSUBDOM(theEdge),k,EID_PRTX(theElement), i, j,
+                        ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,k,0))),
+                        ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,k,1))));
             bserror |= (1<<i);
             nerrors++;
           }
@@ -790,8 +822,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
           if (EGHOST(theElement))
           {
             SET_NBELEM(theElement,i,NULL);
-            UserWriteF("elem=" EID_FMTX " correcting nb error\n",
-                       EID_PRTX(theElement));
+            CheckWriteF("elem=" EID_FMTX " correcting nb error\n",
+                        EID_PRTX(theElement));
           }
         }
 
@@ -807,8 +839,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
       if (j == SIDES_OF_ELEM(NbElement))
       {
         *SideError |= (1<<i);
-        UserWriteF("elem=" EID_FMTX " has side error\n",
-                   EID_PRTX(theElement));
+        CheckWriteF("elem=" EID_FMTX " has side error\n",
+                    EID_PRTX(theElement));
         nerrors++;
       }
       else
@@ -825,53 +857,53 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
             if (err)
             {
               bserror |= (1<<i);
-              UserWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned err=%d\n",
-                         EID_PRTX(theElement),i,err);
+              CheckWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned err=%d\n",
+                          EID_PRTX(theElement),i,err);
             }
             else
             {
               if ((id==0) || (nbid==0))
               {
                 /* no interior boundary */
-                UserWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
-                           EID_PRTX(theElement),i,id,nbid);
+                CheckWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
+                            EID_PRTX(theElement),i,id,nbid);
                 bserror |= (1<<i);
               }
               if (id==nbid)
               {
                 /* should be avoided */
-                UserWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
-                           EID_PRTX(theElement),i,id,nbid);
+                CheckWriteF("elem=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
+                            EID_PRTX(theElement),i,id,nbid);
                 bserror |= (1<<i);
               }
 
               /* check neighbour */
               if (!SIDE_ON_BND(NbElement,j))
               {
-                UserWriteF("elem=" EID_FMTX " ERROR nb=" EID_FMTX " nbside=%d not on boundary id=%d nbid=%d\n",
-                           EID_PRTX(theElement),EID_PRTX(theElement),j,id,nbid);
+                CheckWriteF("elem=" EID_FMTX " ERROR nb=" EID_FMTX " nbside=%d not on boundary id=%d nbid=%d\n",
+                            EID_PRTX(theElement),EID_PRTX(theElement),j,id,nbid);
                 bserror |= (1<<i);
               }
               else
               {
                 if (BNDS_BndSDesc(ELEM_BNDS(NbElement,j),&id_nb,&nbid_nb,&part))
                 {
-                  UserWriteF("nb=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
-                             EID_PRTX(NbElement),j,id,nbid);
+                  CheckWriteF("nb=" EID_FMTX " ERROR BNDS_BndSDesc(%d) returned id=%d nbid=%d\n",
+                              EID_PRTX(NbElement),j,id,nbid);
                   bserror |= (1<<i);
                 }
                 else
                 {
                   if (id!=nbid_nb)
                   {
-                    UserWriteF("nb=" EID_FMTX " ERROR nbside=%d id=%d unequal nbid_nb=%d\n",
-                               EID_PRTX(NbElement),j,id,nbid);
+                    CheckWriteF("nb=" EID_FMTX " ERROR nbside=%d id=%d unequal nbid_nb=%d\n",
+                                EID_PRTX(NbElement),j,id,nbid);
                     bserror |= (1<<i);
                   }
                   if (nbid!=id_nb)
                   {
-                    UserWriteF("nb=" EID_FMTX " ERROR nbside=%d nbid=%d unequal id_nb=%d\n",
-                               EID_PRTX(NbElement),j,id,nbid);
+                    CheckWriteF("nb=" EID_FMTX " ERROR nbside=%d nbid=%d unequal id_nb=%d\n",
+                                EID_PRTX(NbElement),j,id,nbid);
                     bserror |= (1<<i);
                   }
                 }
@@ -879,18 +911,18 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
             }
             if (bserror)
             {
-              UserWriteF("elem=" EID_FMTX " nb=" EID_FMTX
-                         " elemsubdom=%d nbsubdom=%d\n",
-                         EID_PRTX(theElement),EID_PRTX(NbElement),
-                         SUBDOMAIN(theElement),SUBDOMAIN(NbElement));
+              CheckWriteF("elem=" EID_FMTX " nb=" EID_FMTX
+                          " elemsubdom=%d nbsubdom=%d\n",
+                          EID_PRTX(theElement),EID_PRTX(NbElement),
+                          SUBDOMAIN(theElement),SUBDOMAIN(NbElement));
             }
           }
       }
 
       if( ECLASS(theElement)==NO_CLASS)
       {
-        UserWriteF("Element has no ECLASS set, el =  " EID_FMTX "\n",
-                   EID_PRTX(theElement));
+        CheckWriteF("Element has no ECLASS set, el =  " EID_FMTX "\n",
+                    EID_PRTX(theElement));
         nerrors++;
       }
 
@@ -904,8 +936,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
         if (k == n)
         {
           *SideError |= (1<<i);
-          UserWriteF("no matching corner for CORNER_OF_SIDE(NbElement,j,0)=" ID_FMTX "\n",
-                     ID_PRTX(CORNER(NbElement,CORNER_OF_SIDE(NbElement,j,0))));
+          CheckWriteF("no matching corner for CORNER_OF_SIDE(NbElement,j,0)=" ID_FMTX "\n",
+                      ID_PRTX(CORNER(NbElement,CORNER_OF_SIDE(NbElement,j,0))));
         }
         if (TAG(theElement)!=TETRAHEDRON
                                 #ifdef Debug
@@ -918,11 +950,11 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
                 != CORNER(NbElement,CORNER_OF_SIDE(NbElement,j,l)))
             {
               *SideError |= (1<<i);
-              UserWriteF("corner mismatch side=%d cos=%d corner_el=" ID_FMTX " side=%d cos=%d corner_nb=" ID_FMTX " el = " EID_FMTX "\n",
-                         i,(n+k-l)%n,
-                         ID_PRTX(CORNER(theElement,CORNER_OF_SIDE(theElement,i,(n+k-l)%n))),
-                         j,l,
-                         ID_PRTX(CORNER(NbElement,CORNER_OF_SIDE(NbElement,j,l))),EID_PRTX(theElement));
+              CheckWriteF("corner mismatch side=%d cos=%d corner_el=" ID_FMTX " side=%d cos=%d corner_nb=" ID_FMTX " el = " EID_FMTX "\n",
+                          i,(n+k-l)%n,
+                          ID_PRTX(CORNER(theElement,CORNER_OF_SIDE(theElement,i,(n+k-l)%n))),
+                          j,l,
+                          ID_PRTX(CORNER(NbElement,CORNER_OF_SIDE(NbElement,j,l))),EID_PRTX(theElement));
             }
       }
     }
@@ -950,8 +982,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
                                   #endif
           if (INNER_SIDE(theElement,i)) {
             *SideError |= (1<<(i+2*MAX_SIDES_OF_ELEM));
-            UserWriteF("no nb Element for inner boundary, el =  " EID_FMTX "\n",
-                       EID_PRTX(theElement));
+            CheckWriteF("no nb Element for inner boundary, el =  " EID_FMTX "\n",
+                        EID_PRTX(theElement));
             nerrors++;
           }
           for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
@@ -979,11 +1011,11 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
     theNode = CORNER(theElement,i);
 
     if (theNode != NULL)
-      nerrors += CheckNode(theElement,theNode,i);
+      nerrors += CheckNode(theGrid,theElement,theNode,i);
     else
     {
-      UserWriteF("elem=" EID_FMTX " corner=%d nodeptr=NULL\n",
-                 EID_PRTX(theElement),i);
+      CheckWriteF("elem=" EID_FMTX " corner=%d nodeptr=NULL\n",
+                  EID_PRTX(theElement),i);
       nerrors++;
     }
   }
@@ -996,8 +1028,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
 
     if (theNode == NULL || theNode1 == NULL)
     {
-      UserWriteF("elem=" EID_FMTX " edge=%d n0ptr=NULL or n1ptr=NULL\n",
-                 EID_PRTX(theElement),i,theNode,theNode1);
+      CheckWriteF("elem=" EID_FMTX " edge=%d n0ptr=NULL or n1ptr=NULL\n",
+                  EID_PRTX(theElement),i,theNode,theNode1);
       nerrors++;
       continue;
     }
@@ -1009,9 +1041,9 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
       nerrors += CheckEdge(theElement,theEdge,i);
     else
     {
-      UserWriteF("elem=" EID_FMTX " edge=%d n0=" ID_FMTX " n1="
-                 ID_FMTX " edgeptr=NULL\n",
-                 EID_PRTX(theElement),i,ID_PRTX(theNode),ID_PRTX(theNode1));
+      CheckWriteF("elem=" EID_FMTX " edge=%d n0=" ID_FMTX " n1="
+                  ID_FMTX " edgeptr=NULL\n",
+                  EID_PRTX(theElement),i,ID_PRTX(theNode),ID_PRTX(theNode1));
       nerrors++;
     }
   }
@@ -1022,7 +1054,7 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
   if (0)
     if (!CheckOrientation(CORNERS_OF_ELEM(theElement),Vertices))
     {
-      UserWriteF("elem=" EID_FMTX " wrong orientation",EID_PRTX(theElement));
+      CheckWriteF("elem=" EID_FMTX " wrong orientation",EID_PRTX(theElement));
       nerrors++;
     }
 
@@ -1050,15 +1082,15 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
                                         #ifdef ModelP
           if (EMASTER(theFather)) {
             IFDEBUG(gm,1)
-            UserWriteF("ELEM(" EID_FMTX ") WARNING MIDNODE=NULL"
-                       " for mid node[%d]" ID_FMTX "\n",
-                       EID_PRTX(theFather),i,ID_PRTX(theNode));
+            CheckWriteF("ELEM(" EID_FMTX ") WARNING MIDNODE=NULL"
+                        " for mid node[%d]" ID_FMTX "\n",
+                        EID_PRTX(theFather),i,ID_PRTX(theNode));
             ENDDEBUG
           }
                                         #else
-          UserWriteF("ELEM(" EID_FMTX ") ERROR MIDNODE=NULL"
-                     " for mid node[%d]=" ID_FMTX "\n",
-                     EID_PRTX(theFather),i,ID_PRTX(theNode));
+          CheckWriteF("ELEM(" EID_FMTX ") ERROR MIDNODE=NULL"
+                      " for mid node[%d]=" ID_FMTX "\n",
+                      EID_PRTX(theFather),i,ID_PRTX(theNode));
           nerrors++;
                                         #endif
         }
@@ -1068,7 +1100,7 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
     /* check son information of father     */
     if (GetAllSons(theFather,SonList))
     {
-      UserWrite("cannot get sons\n");
+      CheckWrite("cannot get sons\n");
       return (1);
     }
     for (i=0; i<NSONS(theFather); i++)
@@ -1077,10 +1109,10 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
     }
     if (i == NSONS(theFather))
     {
-      UserWriteF("ELEM(" EID_FMTX ") FATHER(" EID_FMTX
-                 ")element is not in SonList NSONS=%d\n",
-                 EID_PRTX(theElement),EID_PRTX(theFather),
-                 NSONS(theFather));
+      CheckWriteF("ELEM(" EID_FMTX ") FATHER(" EID_FMTX
+                  ")element is not in SonList NSONS=%d\n",
+                  EID_PRTX(theElement),EID_PRTX(theFather),
+                  NSONS(theFather));
       /** \todo activate if NSONS is consistent */
       if (0) nerrors++;
     }
@@ -1092,8 +1124,8 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
     {
       if (EMASTER(theElement))
       {
-        UserWriteF("ELEM(" EID_FMTX ") ERROR father=NULL\n",
-                   EID_PRTX(theElement));
+        CheckWriteF("ELEM(" EID_FMTX ") ERROR father=NULL\n",
+                    EID_PRTX(theElement));
         nerrors++;
       }
     }
@@ -1107,7 +1139,7 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
 
     if (GetAllSons(theElement,SonList))
     {
-      UserWrite("cannot get sons\n");
+      CheckWrite("cannot get sons\n");
       return (1);
     }
     for (i=0; (SonList[i]!=NULL || i<nsons) && i<MAX_SONS; i++)
@@ -1115,33 +1147,33 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
       IFDEBUG(gm,1)
       if (REFINE(theElement)==0)
       {
-        UserWriteF("ELEM(" EID_FMTX "): element is not refined "
-                   "but has NSONS=%d\n",EID_PRTX(theElement),nsons);
+        CheckWriteF("ELEM(" EID_FMTX "): element is not refined "
+                    "but has NSONS=%d\n",EID_PRTX(theElement),nsons);
       }
       ENDDEBUG
 
       if (i >= nsons)
       {
-        UserWriteF("ELEM(" EID_FMTX "): element has nsons=%d but "
-                   " son[%d]=" EID_FMTX " exists\n", EID_PRTX(theElement),
-                   NSONS(theElement),i,EID_PRTX(SonList[i]));
+        CheckWriteF("ELEM(" EID_FMTX "): element has nsons=%d but "
+                    " son[%d]=" EID_FMTX " exists\n", EID_PRTX(theElement),
+                    NSONS(theElement),i,EID_PRTX(SonList[i]));
         /* TODO: activate if NSONS is consistent */
         if (0) nerrors++;
       }
 
       if (SonList[i] == NULL)
       {
-        UserWriteF("ELEM(" EID_FMTX "): element has nsons=%d but "
-                   " son[%d]=NULL\n", EID_PRTX(theElement),nsons,i);
+        CheckWriteF("ELEM(" EID_FMTX "): element has nsons=%d but "
+                    " son[%d]=NULL\n", EID_PRTX(theElement),nsons,i);
         *ESonError |= (1<<i);
         nerrors++;
         continue;
       }
       if (EFATHER(SonList[i])!=theElement)
       {
-        UserWriteF("i=%d theElement=" EID_FMTX
-                   " SonList[i]=" EID_FMTX "\n",
-                   i,EID_PRTX(theElement),EID_PRTX(SonList[i]));
+        CheckWriteF("i=%d theElement=" EID_FMTX
+                    " SonList[i]=" EID_FMTX "\n",
+                    i,EID_PRTX(theElement),EID_PRTX(SonList[i]));
         *ESonError |= (1<<i);
         nerrors++;
       }
@@ -1150,15 +1182,15 @@ static INT CheckElement (GRID *theGrid, ELEMENT *theElement, INT *SideError, INT
 
   if (bserror)
   {
-    UserWriteF("theElement=" EID_FMTX
-               " bserror=%d\n",
-               EID_PRTX(theElement),bserror);
+    CheckWriteF("theElement=" EID_FMTX
+                " bserror=%d\n",
+                EID_PRTX(theElement),bserror);
     nerrors++;
   }
   if (nerrors > 0)
   {
-    UserWriteF("ELEM(" EID_FMTX "): element has %d errors\n",
-               EID_PRTX(theElement),nerrors);
+    CheckWriteF("ELEM(" EID_FMTX "): element has %d errors\n",
+                EID_PRTX(theElement),nerrors);
     *errors = nerrors;
   }
 
@@ -1489,189 +1521,269 @@ INT CheckSubdomains (MULTIGRID *theMG)
 }
 #endif
 
-static INT CheckGeometry (GRID *theGrid)
+/* check one element and report its errors */
+static INT CheckGeometryElement (GRID *theGrid, ELEMENT *theElement)
 {
-  NODE *theNode;
-  ELEMENT *theElement;
-  EDGE *theEdge;
-  LINK *theLink;
   int i,j;
-  INT SideError, EdgeError, NodeError, ESonError, NSonError, count;
+  INT SideError, EdgeError, NodeError, ESonError, NSonError;
   INT errors = 0;
 
-  /* reset used flags */
-  for (theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
-  {
-    SETUSED(theNode,0);
-    for (theLink=START(theNode); theLink!=NULL; theLink=NEXT(theLink))
-      SETUSED(MYEDGE(theLink),0);
-  }
-
-  /* check elements */
-  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL;
-       theElement=SUCCE(theElement))
-  {
-    if (CheckElement(theGrid,theElement,&SideError,&EdgeError,
-                     &NodeError,&ESonError,&NSonError,&errors)==0) continue;
+  if (CheckElement(theGrid,theElement,&SideError,&EdgeError,
+                   &NodeError,&ESonError,&NSonError,&errors)==0) return(errors);
 
-    UserWriteF("ELEM=" EID_FMTX "\n",EID_PRTX(theElement));
+  CheckWriteF("ELEM=" EID_FMTX "\n",EID_PRTX(theElement));
 
-    /* evaluate side information */
-    if (SideError)
-      for (i=0; i<SIDES_OF_ELEM(theElement); i++)
+  /* evaluate side information */
+  if (SideError)
+    for (i=0; i<SIDES_OF_ELEM(theElement); i++)
+    {
+      /* back pointer failure */
+      if (SideError & 1<<i)
       {
-        /* back pointer failure */
-        if (SideError & 1<<i)
+        CheckWriteF("   SIDE[%d]=(",i);
+        for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
         {
-          UserWriteF("   SIDE[%d]=(",i);
-          for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
-          {
-            UserWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
-                                              CORNER_OF_SIDE(theElement,i,j))));
-
-            if (j<CORNERS_OF_SIDE(theElement,i)-1) UserWrite(",");
-          }
-          UserWriteF(") has neighbour=" EID_FMTX " but a backPtr does not exist\n",
-                     EID_PRTX(NBELEM(theElement,i)));
+          CheckWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
+                                             CORNER_OF_SIDE(theElement,i,j))));
 
-          errors++;
+          if (j<CORNERS_OF_SIDE(theElement,i)-1) CheckWrite(",");
         }
+        CheckWriteF(") has neighbour=" EID_FMTX " but a backPtr does not exist\n",
+                    EID_PRTX(NBELEM(theElement,i)));
+
+        errors++;
+      }
+
+      /* neighbor pointer failure */
+      if (SideError & 1<<(i+MAX_SIDES_OF_ELEM))
+      {
+        errors++;
 
-        /* neighbor pointer failure */
-        if (SideError & 1<<(i+MAX_SIDES_OF_ELEM))
+        CheckWriteF("   SIDE[%d]=(",i);
+        for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
         {
-          errors++;
+          CheckWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
+                                             CORNER_OF_SIDE(theElement,i,j))));
 
-          UserWriteF("   SIDE[%d]=(",i);
-          for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
-          {
-            UserWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
-                                              CORNER_OF_SIDE(theElement,i,j))));
+          if (j<CORNERS_OF_SIDE(theElement,i)-1) CheckWrite(",");
+        }
+        CheckWrite(") ERROR: has no neighbor but element is IEOBJ\n");
 
-            if (j<CORNERS_OF_SIDE(theElement,i)-1) UserWrite(",");
-          }
-          UserWrite(") ERROR: has no neighbor but element is IEOBJ\n");
+        CheckWriteF(" Eclass=%d Efather=" EID_FMTX "FECLASS=%d FREFINE=%d\n",
+                    ECLASS(theElement),EID_PRTX(EFATHER(theElement)),
+                    ECLASS(EFATHER(theElement)),REFINE(EFATHER(theElement)));
+        {
+          INT i;
+          ELEMENT *theFather = EFATHER(theElement);
+          ELEMENT *theNeighbor;
 
-          UserWriteF(" Eclass=%d Efather=" EID_FMTX "FECLASS=%d FREFINE=%d\n",
-                     ECLASS(theElement),EID_PRTX(EFATHER(theElement)),
-                     ECLASS(EFATHER(theElement)),REFINE(EFATHER(theElement)));
+          for (i=0; i<SIDES_OF_ELEM(theFather); i++)
           {
-            INT i;
-            ELEMENT *theFather = EFATHER(theElement);
-            ELEMENT *theNeighbor;
-
-            for (i=0; i<SIDES_OF_ELEM(theFather); i++)
+            theNeighbor = NBELEM(theFather,i);
+            if (theNeighbor != NULL)
             {
-              theNeighbor = NBELEM(theFather,i);
-              if (theNeighbor != NULL)
-              {
-                UserWriteF("NB[%d]=" EID_FMTX " NBREFINE=%d\n",
-                           i,EID_PRTX(theNeighbor),REFINE(theNeighbor));
+              CheckWriteF("NB[%d]=" EID_FMTX " NBREFINE=%d\n",
+                          i,EID_PRTX(theNeighbor),REFINE(theNeighbor));
 
-              }
             }
           }
-
         }
 
-        /* boundary failure */
-        if (SideError & 1<<(i+2*MAX_SIDES_OF_ELEM))
-        {
-          errors++;
+      }
 
-          UserWriteF("   SIDE[%d]=(",i);
-          for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
-          {
-            UserWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
-                                              CORNER_OF_SIDE(theElement,i,j))));
+      /* boundary failure */
+      if (SideError & 1<<(i+2*MAX_SIDES_OF_ELEM))
+      {
+        errors++;
 
-            if (j<CORNERS_OF_SIDE(theElement,i)-1) UserWrite(",");
-          }
-          UserWrite(") ERROR: has no neighbor, element is BEOBJ "
-                    "but there is no SIDE\n");
+        CheckWriteF("   SIDE[%d]=(",i);
+        for (j=0; j<CORNERS_OF_SIDE(theElement,i); j++)
+        {
+          CheckWriteF(ID_FMTX,ID_PRTX(CORNER(theElement,
+                                             CORNER_OF_SIDE(theElement,i,j))));
+
+          if (j<CORNERS_OF_SIDE(theElement,i)-1) CheckWrite(",");
         }
+        CheckWrite(") ERROR: has no neighbor, element is BEOBJ "
+                   "but there is no SIDE\n");
       }
+    }
 
-    /* evaluate edge information */
-    if (EdgeError)
-      for (i=0; i<EDGES_OF_ELEM(theElement); i++)
-      {
-        if (!(EdgeError & 1<<i)) continue;
+  /* evaluate edge information */
+  if (EdgeError)
+    for (i=0; i<EDGES_OF_ELEM(theElement); i++)
+    {
+      if (!(EdgeError & 1<<i)) continue;
+
+      errors++;
+      CheckWriteF("   EDGE(" ID_FMTX " , " ID_FMTX ") is missing\n",
+                  ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,i,0))),
+                  ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,i,1))));
+    }
 
+  /* evaluate node information */
+  if (NodeError)
+    for (i=0; i<CORNERS_OF_ELEM(theElement); i++)
+    {
+      if (NodeError & (1<<i))
+      {
         errors++;
-        UserWriteF("   EDGE(" ID_FMTX " , " ID_FMTX ") is missing\n",
-                   ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,i,0))),
-                   ID_PRTX(CORNER(theElement,CORNER_OF_EDGE(theElement,i,1))));
+        CheckWriteF("   CORNER=" ID_FMTX " is BVOBJ,"
+                    " ids from elementside "
+                    "and vertexsegment are not consistent\n",
+                    ID_PRTX(CORNER(theElement,i)));
       }
-
-    /* evaluate node information */
-    if (NodeError)
-      for (i=0; i<CORNERS_OF_ELEM(theElement); i++)
+      if (NodeError & (1<<(i+MAX_CORNERS_OF_ELEM)))
       {
-        if (NodeError & (1<<i))
-        {
-          errors++;
-          UserWriteF("   CORNER=" ID_FMTX " is BVOBJ,"
-                     " ids from elementside "
-                     "and vertexsegment are not consistent\n",
-                     ID_PRTX(CORNER(theElement,i)));
-        }
-        if (NodeError & (1<<(i+MAX_CORNERS_OF_ELEM)))
-        {
-          errors++;
-          UserWriteF("   CORNER " ID_FMTX " is IVOBJ, but lies on "
-                     "elementside\n",ID_PRTX(CORNER(theElement,i)));
-        }
+        errors++;
+        CheckWriteF("   CORNER " ID_FMTX " is IVOBJ, but lies on "
+                    "elementside\n",ID_PRTX(CORNER(theElement,i)));
       }
+    }
 
-    /* evaluate son information */
-    if (ESonError)
+  /* evaluate son information */
+  if (ESonError)
+  {
+    for (i=0; i<NSONS(theElement); i++)
     {
-      for (i=0; i<NSONS(theElement); i++)
+      if ((ESonError & 1<<i))
       {
-        if ((ESonError & 1<<i))
-        {
-          errors++;
-          UserWriteF("   ESON(%d) has wrong EFATHER "
-                     "pointer\n",i);
-        }
+        errors++;
+        CheckWriteF("   ESON(%d) has wrong EFATHER "
+                    "pointer\n",i);
       }
     }
+  }
 
-    if (NSonError)
+  if (NSonError)
+  {
+    for (i=0; i<MAX_CORNERS_OF_ELEM; i++)
     {
-      for (i=0; i<MAX_CORNERS_OF_ELEM; i++)
+      if (NSonError & (1<<i))
       {
-        if (NSonError & (1<<i))
-        {
-          errors++;
-          UserWriteF("   SONNODE(CORNER %d) != CORNER(ESON)\n",i);
-        }
-        if (NSonError & (1<<(i+MAX_CORNERS_OF_ELEM)))
-        {
-          errors++;
-          UserWriteF("   CORNER %d != EFATHER(CORNER(ESON))\n",i);
-        }
+        errors++;
+        CheckWriteF("   SONNODE(CORNER %d) != CORNER(ESON)\n",i);
       }
-
-      for (i=0; i<MAX_EDGES_OF_ELEM; i++)
+      if (NSonError & (1<<(i+MAX_CORNERS_OF_ELEM)))
       {
-
-        if (NSonError & (1<<(i+MAX_CORNERS_OF_ELEM)))
-        {
-          errors++;
-          UserWriteF("   MIDNODE(edge %d) != CORNER(ESON)\n",i);
-        }
+        errors++;
+        CheckWriteF("   CORNER %d != EFATHER(CORNER(ESON))\n",i);
       }
+    }
 
-      if (NSonError & (1<<(MAX_EDGES_OF_ELEM+2*MAX_CORNERS_OF_ELEM)))
+    for (i=0; i<MAX_EDGES_OF_ELEM; i++)
+    {
+
+      if (NSonError & (1<<(i+MAX_CORNERS_OF_ELEM)))
       {
         errors++;
-        UserWriteF("   NFATHER(CENTERNODE(ESON)) != NULL\n");
+        CheckWriteF("   MIDNODE(edge %d) != CORNER(ESON)\n",i);
       }
     }
+
+    if (NSonError & (1<<(MAX_EDGES_OF_ELEM+2*MAX_CORNERS_OF_ELEM)))
+    {
+      errors++;
+      CheckWriteF("   NFATHER(CENTERNODE(ESON)) != NULL\n");
+    }
+  }
+
+  return(errors);
+}
+
+/****************************************************************************/
+/** \brief Check a list of elements of a grid level on several threads
+
+   \param theGrid - grid level the elements belong to
+   \param elements - elements to check
+
+   The elements are split into contiguous ranges, one per thread. The
+   output of each thread is collected and written in element order when
+   all threads have finished.
+
+   \return number of errors found
+ */
+/****************************************************************************/
+
+static INT CheckElementRange (GRID *theGrid, const std::vector<ELEMENT *> &elements)
+{
+  const std::size_t n = elements.size();
+  std::size_t minChunk = CHECK_MINCHUNK;
+
+#if defined(_DEBUG_CW_)
+  /* the control word access statistics are not thread safe */
+  minChunk = n+1;
+#endif
+#if defined(ModelP) && defined(__TWODIM__)
+  /* EdgeHasTMasterCopy uses the proclist buffer of DDD */
+  if (hghost_overlap == 0.0)
+    minChunk = n+1;
+#endif
+
+  std::vector<std::string> output(GetNumberOfThreads());
+  std::vector<INT> errors(GetNumberOfThreads(),0);
+
+  ParallelForRange(n, [&](std::size_t begin, std::size_t end, INT thread)
+                   {
+                     checkOutput = &output[thread];
+                     for (std::size_t k=begin; k<end; k++)
+                       errors[thread] += CheckGeometryElement(theGrid,elements[k]);
+                     checkOutput = NULL;
+                   }, minChunk);
+
+  INT nerrors = 0;
+  for (std::size_t t=0; t<output.size(); t++)
+  {
+    if (!output[t].empty())
+      UserWrite(output[t].c_str());
+    nerrors += errors[t];
+  }
+
+  return(nerrors);
+}
+
+static INT CheckGeometry (GRID *theGrid)
+{
+  NODE *theNode;
+  ELEMENT *theElement;
+  EDGE *theEdge;
+  LINK *theLink;
+  INT i,count;
+  INT errors = 0;
+
+  /* reset used flags */
+  for (theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+  {
+    SETUSED(theNode,0);
+    for (theLink=START(theNode); theLink!=NULL; theLink=NEXT(theLink))
+      SETUSED(MYEDGE(theLink),0);
+  }
+
+  /* mark nodes and edges of elements, the element checks only read */
+  std::vector<ELEMENT *> elements;
+  elements.reserve(NT(theGrid));
+  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL;
+       theElement=SUCCE(theElement))
+  {
+    elements.push_back(theElement);
+    for (i=0; i<CORNERS_OF_ELEM(theElement); i++)
+      if (CORNER(theElement,i) != NULL)
+        SETUSED(CORNER(theElement,i),1);
+    for (i=0; i<EDGES_OF_ELEM(theElement); i++)
+    {
+      NODE *n0 = CORNER(theElement,CORNER_OF_EDGE(theElement,i,0));
+      NODE *n1 = CORNER(theElement,CORNER_OF_EDGE(theElement,i,1));
+
+      if (n0 == NULL || n1 == NULL) continue;
+      theEdge = GetEdge(n0,n1);
+      if (theEdge != NULL)
+        SETUSED(theEdge,1);
+    }
   }
 
+  /* check elements */
+  errors += CheckElementRange(theGrid,elements);
+
   /* look for dead edges */
   for (theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
   {
@@ -1847,6 +1959,66 @@ INT NS_DIM_PREFIX CheckLists (GRID *theGrid)
   return(GM_OK);
 }
 
+/****************************************************************************/
+/** \brief Check the elements of a grid level, or a selection of them
+
+   \param theGrid - grid level to check
+   \param selection - one of CHECK_ALL_ELEMENTS, CHECK_SAMPLED_ELEMENTS, CHECK_NEW_ELEMENTS
+   \param fraction - fraction of the elements checked by CHECK_SAMPLED_ELEMENTS
+   \param seed - seed of the random selection of CHECK_SAMPLED_ELEMENTS
+
+   Runs the element part of the geometry check of CheckGrid on several
+   threads (see SetNumberOfThreads). The sampled and incremental modes
+   make it cheap enough to run after every adaptation step.
+   CHECK_NEW_ELEMENTS checks the elements created, received or refined
+   since its last call and resets their NEWEL flag.
+
+   In contrast to CheckGrid this function only checks the local grid and
+   does not communicate, dead nodes and edges are not found.
+
+   \return number of errors found
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX CheckElements (GRID *theGrid, INT selection, DOUBLE fraction, INT seed)
+{
+  std::vector<ELEMENT *> elements;
+  std::mt19937 random(seed);
+  std::bernoulli_distribution sample(std::min(std::max(fraction,0.0),1.0));
+  ELEMENT *theElement;
+  INT errors;
+
+  if (GetStringValue(":conf:hghost_overlap",&hghost_overlap) !=0)
+    UserWriteF("CheckElements: warning %s not set\n",":conf:hghost_overlap");
+
+  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL;
+       theElement=SUCCE(theElement))
+    switch (selection)
+    {
+    case CHECK_SAMPLED_ELEMENTS :
+      if (sample(random))
+        elements.push_back(theElement);
+      break;
+
+    case CHECK_NEW_ELEMENTS :
+      if (NEWEL(theElement))
+        elements.push_back(theElement);
+      break;
+
+    default :
+      elements.push_back(theElement);
+      break;
+    }
+
+  errors = CheckElementRange(theGrid,elements);
+
+  if (selection == CHECK_NEW_ELEMENTS)
+    for (ELEMENT *e : elements)
+      SETNEWEL(e,0);
+
+  return(errors);
+}
+
 /****************************************************************************/
 /*D
    CheckGrid - Check consistency of data structure
@@ -0,0 +1,386 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file indexsets.cc
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      indexsets.cc                                                  */
+/*                                                                          */
+/* Purpose:   incrementally maintained level and leaf indices               */
+/*                                                                          */
+/* Remarks:   The grid manager calls IndexSetsInsert/IndexSetsRemove when   */
+/*            it creates or disposes nodes, edges and elements (including   */
+/*            copies created and deleted by DDD), and IndexSetsRefineChanged*/
+/*            when AdaptGrid sets the refinement of an element or DDD       */
+/*            overwrites the refinement of a copy. An element is a leaf     */
+/*            element if it is not refined. All hooks return immediately if */
+/*            the index sets are not enabled.                               */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*            system include files                                          */
+/*            application include files                                     */
+/*                                                                          */
+/****************************************************************************/
+
+#include <config.h>
+
+#include <memory>
+
+#include <dune/uggrid/low/debug.h>
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "gm.h"
+#include "indexsets.h"
+#include "rm.h"
+
+USING_UG_NAMESPACES
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+REP_ERR_FILE
+
+static INT GetIndex (IndexPool &pool, void *obj)
+{
+  INT i;
+
+  if (pool.free.empty())
+  {
+    i = pool.object.size();
+    pool.object.push_back(obj);
+  }
+  else
+  {
+    i = pool.free.back();
+    pool.free.pop_back();
+    pool.object[i] = obj;
+  }
+
+  return i;
+}
+
+static void PutIndex (IndexPool &pool, INT i)
+{
+  if (i < 0 || i >= pool.size() || pool.object[i] == NULL)
+    return;
+
+  pool.object[i] = NULL;
+  pool.free.push_back(i);
+}
+
+static int &VertexLeafIndex (VERTEX *theVertex)
+{
+  return (OBJT(theVertex) == BVOBJ) ? theVertex->bv.leafIndex : theVertex->iv.leafIndex;
+}
+
+/* the pool of the level index of obj, NULL for other objects */
+static IndexPool *LevelPool (MultiGridIndexSets &sets, void *obj, int **index)
+{
+  LevelIndexPools &level = sets.level[LEVEL(obj)];
+
+  switch (OBJT(obj))
+  {
+  case NDOBJ :
+    *index = &((NODE *)obj)->levelIndex;
+    return &level.node;
+
+  case EDOBJ :
+    *index = &((EDGE *)obj)->levelIndex;
+    return &level.edge;
+
+  case IEOBJ :
+  case BEOBJ :
+    *index = &((ELEMENT *)obj)->ge.levelIndex;
+    return &level.element[TAG((ELEMENT *)obj)];
+  }
+
+  return NULL;
+}
+
+/* move the objects with the largest indices into the holes */
+template<class SetIndex>
+static void CompactPool (IndexPool &pool, std::vector<INT> *perm, SetIndex setIndex)
+{
+  const INT n = pool.used();
+
+  if (perm != NULL)
+  {
+    perm->resize(pool.size());
+    for (INT i=0; i<pool.size(); i++)
+      (*perm)[i] = (pool.object[i] != NULL) ? i : -1;
+  }
+
+  INT last = pool.size()-1;
+  for (INT hole : pool.free)
+  {
+    if (hole >= n) continue;
+
+    while (pool.object[last] == NULL) last--;
+
+    pool.object[hole] = pool.object[last];
+    pool.object[last] = NULL;
+    setIndex(pool.object[hole], hole);
+    if (perm != NULL)
+      (*perm)[last] = hole;
+    last--;
+  }
+
+  pool.object.resize(n);
+  pool.free.clear();
+}
+
+/****************************************************************************/
+/** \brief Number all objects consecutively and maintain the indices from now on
+
+   \param theMG - multigrid to handle
+
+   Overwrites the levelIndex fields of all elements, nodes and edges and the
+   leafIndex fields of all elements and vertices. From now on the grid
+   manager keeps them up to date. Calling this again renumbers everything.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX EnableIndexSets (MULTIGRID *theMG)
+{
+  theMG->indexSets = std::make_shared<MultiGridIndexSets>();
+
+  for (INT l=0; l<=TOPLEVEL(theMG); l++)
+  {
+    GRID *theGrid = GRID_ON_LEVEL(theMG,l);
+
+    for (VERTEX *theVertex=PFIRSTVERTEX(theGrid); theVertex!=NULL; theVertex=SUCCV(theVertex))
+      IndexSetsInsert(theMG,theVertex);
+
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+      IndexSetsInsert(theMG,theElement);
+
+    for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+    {
+      IndexSetsInsert(theMG,theNode);
+
+      /* each edge once, from the node its first link starts at */
+      for (LINK *theLink=START(theNode); theLink!=NULL; theLink=NEXT(theLink))
+        if (LINK0(MYEDGE(theLink)) == theLink)
+          IndexSetsInsert(theMG,MYEDGE(theLink));
+    }
+  }
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Stop maintaining the indices
+
+   \param theMG - multigrid to handle
+
+   The index fields keep their current values.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX DisableIndexSets (MULTIGRID *theMG)
+{
+  theMG->indexSets.reset();
+}
+
+/****************************************************************************/
+/** \brief Hand out indices to a new vertex, node, edge or element
+
+   \param theMG - multigrid the object belongs to
+   \param obj - the object, its level must be set
+
+   Vertices only get a leaf index. Elements which are not refined also get
+   a leaf index. Other objects are ignored.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX IndexSetsInsert (MULTIGRID *theMG, void *obj)
+{
+  int *index;
+
+  if (theMG == NULL || theMG->indexSets == nullptr) return;
+
+  if (OBJT(obj) == IVOBJ || OBJT(obj) == BVOBJ)
+  {
+    VertexLeafIndex((VERTEX *)obj) = GetIndex(theMG->indexSets->leafVertex,obj);
+    return;
+  }
+
+  IndexPool *pool = LevelPool(*theMG->indexSets,obj,&index);
+  if (pool == NULL) return;
+
+  *index = GetIndex(*pool,obj);
+
+  if (OBJT(obj) == IEOBJ || OBJT(obj) == BEOBJ)
+  {
+    ELEMENT *theElement = (ELEMENT *)obj;
+
+    theElement->ge.leafIndex = -1;
+    IndexSetsRefineChanged(theMG,theElement);
+  }
+}
+
+/****************************************************************************/
+/** \brief Return the indices of a vertex, node, edge or element which is removed
+
+   \param theMG - multigrid the object belongs to
+   \param obj - the object
+
+   Other objects are ignored.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX IndexSetsRemove (MULTIGRID *theMG, void *obj)
+{
+  int *index;
+
+  if (theMG == NULL || theMG->indexSets == nullptr) return;
+
+  if (OBJT(obj) == IVOBJ || OBJT(obj) == BVOBJ)
+  {
+    IndexPool &leaf = theMG->indexSets->leafVertex;
+    int &i = VertexLeafIndex((VERTEX *)obj);
+
+    if (i >= 0 && i < leaf.size() && leaf.object[i] == obj)
+      PutIndex(leaf,i);
+    i = -1;
+    return;
+  }
+
+  IndexPool *pool = LevelPool(*theMG->indexSets,obj,&index);
+  if (pool == NULL) return;
+
+  /* only release indices this object actually holds */
+  if (*index >= 0 && *index < pool->size() && pool->object[*index] == obj)
+    PutIndex(*pool,*index);
+  *index = -1;
+
+  if (OBJT(obj) == IEOBJ || OBJT(obj) == BEOBJ)
+  {
+    ELEMENT *theElement = (ELEMENT *)obj;
+    IndexPool &leaf = theMG->indexSets->leafElement[TAG(theElement)];
+    const INT i = theElement->ge.leafIndex;
+
+    if (i >= 0 && i < leaf.size() && leaf.object[i] == obj)
+      PutIndex(leaf,i);
+    theElement->ge.leafIndex = -1;
+  }
+}
+
+/****************************************************************************/
+/** \brief Update the leaf index of an element whose refinement changed
+
+   \param theMG - multigrid the element belongs to
+   \param theElement - the element
+
+   An element which is no longer refined gets a leaf index, a refined
+   element returns its leaf index.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX IndexSetsRefineChanged (MULTIGRID *theMG, ELEMENT *theElement)
+{
+  if (theMG == NULL || theMG->indexSets == nullptr) return;
+
+  IndexPool &leaf = theMG->indexSets->leafElement[TAG(theElement)];
+  INT i = theElement->ge.leafIndex;
+  const bool hasIndex = (i >= 0 && i < leaf.size() && leaf.object[i] == theElement);
+
+  if (LEAFELEM(theElement))
+  {
+    if (!hasIndex)
+      theElement->ge.leafIndex = GetIndex(leaf,theElement);
+  }
+  else
+  {
+    if (hasIndex)
+      PutIndex(leaf,i);
+    theElement->ge.leafIndex = -1;
+  }
+}
+
+/****************************************************************************/
+/** \brief Close the holes in the level indices of a grid level
+
+   \param theGrid - grid level to handle
+   \param perm - returns the new index of each old index, may be NULL
+
+   Only objects with indices beyond the number of objects are renumbered,
+   so the work is proportional to the number of holes.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   <li> GM_ERROR if the index sets are not enabled </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX CompactLevelIndices (GRID *theGrid, IndexPermutation *perm)
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+
+  if (theMG->indexSets == nullptr)
+    REP_ERR_RETURN(GM_ERROR);
+
+  LevelIndexPools &level = theMG->indexSets->level[GLEVEL(theGrid)];
+
+  for (INT tag=0; tag<TAGS; tag++)
+    CompactPool(level.element[tag], (perm != NULL) ? &perm->element[tag] : NULL,
+                [](void *obj, INT i){ ((ELEMENT *)obj)->ge.levelIndex = i; });
+  CompactPool(level.node, (perm != NULL) ? &perm->node : NULL,
+              [](void *obj, INT i){ ((NODE *)obj)->levelIndex = i; });
+  CompactPool(level.edge, (perm != NULL) ? &perm->edge : NULL,
+              [](void *obj, INT i){ ((EDGE *)obj)->levelIndex = i; });
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Close the holes in the leaf indices of a multigrid
+
+   \param theMG - multigrid to handle
+   \param perm - returns the new index of each old index, may be NULL
+
+   Elements and vertices are leaf indexed, the node and edge maps of perm
+   stay empty.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   <li> GM_ERROR if the index sets are not enabled </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX CompactLeafIndices (MULTIGRID *theMG, IndexPermutation *perm)
+{
+  if (theMG->indexSets == nullptr)
+    REP_ERR_RETURN(GM_ERROR);
+
+  for (INT tag=0; tag<TAGS; tag++)
+    CompactPool(theMG->indexSets->leafElement[tag], (perm != NULL) ? &perm->element[tag] : NULL,
+                [](void *obj, INT i){ ((ELEMENT *)obj)->ge.leafIndex = i; });
+  CompactPool(theMG->indexSets->leafVertex, (perm != NULL) ? &perm->vertex : NULL,
+              [](void *obj, INT i){ VertexLeafIndex((VERTEX *)obj) = i; });
+
+  return (GM_OK);
+}
+
+/** @} */
@@ -0,0 +1,138 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file indexsets.h
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      indexsets.h                                                   */
+/*                                                                          */
+/* Purpose:   incrementally maintained level and leaf indices               */
+/*                                                                          */
+/* Remarks:   When enabled, the levelIndex fields of elements, nodes and    */
+/*            edges and the leafIndex fields of elements and vertices are   */
+/*            kept up to date by the grid manager. Indices of removed       */
+/*            objects go to free lists and are handed out again, so the     */
+/*            index ranges may have holes until CompactLevelIndices or      */
+/*            CompactLeafIndices is called. Edges have no maintained leaf   */
+/*            index: the copies of one edge on several levels are separate  */
+/*            objects, and Dune numbers them when it builds its leaf index  */
+/*            set.                                                          */
+/*                                                                          */
+/****************************************************************************/
+
+
+/****************************************************************************/
+/*                                                                          */
+/* auto include mechanism and other include files                           */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef __INDEXSETS__
+#define __INDEXSETS__
+
+#include <array>
+#include <vector>
+
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "elements.h"
+#include "gm.h"
+
+START_UGDIM_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* data structures exported by the corresponding source file                */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Indices 0..size()-1 handed out to objects, with a free list of returned ones */
+struct IndexPool
+{
+  /** \brief Object holding each index, NULL for free indices */
+  std::vector<void*> object;
+
+  /** \brief Returned indices, reused last in first out */
+  std::vector<INT> free;
+
+  /** \brief One past the largest index in use or free */
+  INT size () const { return object.size(); }
+
+  /** \brief Number of indices in use */
+  INT used () const { return object.size() - free.size(); }
+
+  /** \brief True if the indices in use are exactly 0..used()-1 */
+  bool compact () const { return free.empty(); }
+};
+
+/** \brief Index pools of one grid level */
+struct LevelIndexPools
+{
+  /** \brief Element indices, counted separately for each element tag */
+  std::array<IndexPool, TAGS> element;
+
+  IndexPool node;
+  IndexPool edge;
+};
+
+/** \brief Index pools of a multigrid */
+struct MultiGridIndexSets
+{
+  std::array<LevelIndexPools, MAXLEVEL> level;
+
+  /** \brief Leaf element indices, counted separately for each element tag */
+  std::array<IndexPool, TAGS> leafElement;
+
+  /** \brief Leaf vertex indices, every vertex is part of the leaf grid */
+  IndexPool leafVertex;
+};
+
+/** \brief Result of a compaction, new index of each old index (-1 if it was free) */
+struct IndexPermutation
+{
+  std::array<std::vector<INT>, TAGS> element;
+  std::vector<INT> node;
+  std::vector<INT> edge;
+  std::vector<INT> vertex;
+};
+
+/****************************************************************************/
+/*                                                                          */
+/* function declarations                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Number all objects consecutively and maintain the indices from now on */
+INT EnableIndexSets (MULTIGRID *theMG);
+
+/** \brief Stop maintaining the indices */
+void DisableIndexSets (MULTIGRID *theMG);
+
+/** \brief Hand out indices to a new vertex, node, edge or element */
+void IndexSetsInsert (MULTIGRID *theMG, void *obj);
+
+/** \brief Return the indices of a vertex, node, edge or element which is removed */
+void IndexSetsRemove (MULTIGRID *theMG, void *obj);
+
+/** \brief Update the leaf index of an element whose refinement changed */
+void IndexSetsRefineChanged (MULTIGRID *theMG, ELEMENT *theElement);
+
+/** \brief Close the holes in the level indices of a grid level */
+INT CompactLevelIndices (GRID *theGrid, IndexPermutation *perm);
+
+/** \brief Close the holes in the leaf indices of a multigrid */
+INT CompactLeafIndices (MULTIGRID *theMG, IndexPermutation *perm);
+
+END_UGDIM_NAMESPACE
+
+#endif
+
+/** @} */
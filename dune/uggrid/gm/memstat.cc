@@ -0,0 +1,432 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file memstat.cc
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      memstat.cc                                                    */
+/*                                                                          */
+/* Purpose:   memory accounting of a multigrid per object type              */
+/*                                                                          */
+/* Remarks:   The accounting classes of the multigrid heap are the object   */
+/*            types of the grid manager (each element tag has its own inner */
+/*            and boundary type) and the two domain classes BNDP_HEAPSTAT   */
+/*            and BNDS_HEAPSTAT. Matrices, connections and element lists    */
+/*            share the class MAOBJ.                                        */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*            system include files                                          */
+/*            application include files                                     */
+/*                                                                          */
+/****************************************************************************/
+
+#include <config.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <dune/uggrid/low/heaps.h>
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "gm.h"
+#include "memstat.h"
+
+#ifdef ModelP
+#include <dune/uggrid/parallel/ddd/include/memmgr.h>
+#include <dune/uggrid/parallel/dddif/parallel.h>
+#include <dune/uggrid/parallel/ppif/ppifcontext.hh>
+#endif
+
+USING_UG_NAMESPACES
+
+static_assert(MAXOBJECTS <= BNDP_HEAPSTAT,
+              "heap accounting classes of the grid manager and the domain overlap");
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+REP_ERR_FILE
+
+static const char *TagName (INT tag)
+{
+  switch (tag)
+  {
+#ifdef __TWODIM__
+  case TRIANGLE :      return "triangle";
+  case QUADRILATERAL : return "quadrilateral";
+#endif
+#ifdef __THREEDIM__
+  case TETRAHEDRON :   return "tetrahedron";
+  case PYRAMID :       return "pyramid";
+  case PRISM :         return "prism";
+  case HEXAHEDRON :    return "hexahedron";
+#endif
+  default :            return "element";
+  }
+}
+
+static void WriteStat (FILE *stream, const char *scope, const char *name, const HEAP_STAT *s)
+{
+  fprintf(stream,"%s %s %lu %lu %lu %lu\n",scope,name,
+          s->objects,s->peakObjects,s->bytes,s->peakBytes);
+}
+
+/****************************************************************************/
+/** \brief Accounting class and size of a grid object
+
+   \param theMG - multigrid the object belongs to
+   \param obj - vertex, node, edge, element or vector
+   \param cls - returns the accounting class, -1 for other objects
+
+   The size is the one GetMemoryForObject was (or would have been) called
+   with when the grid manager created the object.
+
+   \return size in bytes, 0 for other objects
+ */
+/****************************************************************************/
+
+MEM NS_DIM_PREFIX ObjectMemory (const MULTIGRID *theMG, void *obj, INT *cls)
+{
+  *cls = OBJT(obj);
+
+  switch (OBJT(obj))
+  {
+  case IVOBJ :
+    return sizeof(struct ivertex);
+
+  case BVOBJ :
+    return sizeof(struct bvertex);
+
+  case NDOBJ :
+    if (VEC_DEF_IN_OBJ_OF_MG(theMG,NODEVEC))
+      return sizeof(NODE);
+    return sizeof(NODE)-sizeof(VECTOR *);
+
+  case EDOBJ :
+    if (VEC_DEF_IN_OBJ_OF_MG(theMG,EDGEVEC))
+      return sizeof(EDGE);
+    return sizeof(EDGE)-sizeof(VECTOR *);
+
+  case IEOBJ :
+    *cls = MAPPED_INNER_OBJT_TAG(TAG((ELEMENT *)obj));
+    return INNER_SIZE_TAG(TAG((ELEMENT *)obj));
+
+  case BEOBJ :
+    *cls = MAPPED_BND_OBJT_TAG(TAG((ELEMENT *)obj));
+    return BND_SIZE_TAG(TAG((ELEMENT *)obj));
+
+  case VEOBJ :
+    return sizeof(VECTOR)-sizeof(DOUBLE)
+           +FMT_S_VEC_TP(MGFORMAT(theMG),VTYPE((VECTOR *)obj));
+  }
+
+  *cls = -1;
+  return 0;
+}
+
+/****************************************************************************/
+/** \brief Record a grid object which was not allocated by GetMemoryForObject
+
+   \param theMG - multigrid the object belongs to
+   \param obj - the object
+
+   Used for object copies created by DDD during load migration.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX AccountObject (MULTIGRID *theMG, void *obj)
+{
+  INT cls;
+  MEM size = ObjectMemory(theMG,obj,&cls);
+
+  if (cls >= 0)
+    HeapStatAlloc(HEAPSTAT(MGHEAP(theMG),cls),size);
+}
+
+/****************************************************************************/
+/** \brief Remove a grid object which is not freed by PutFreeObject
+
+   \param theMG - multigrid the object belongs to
+   \param obj - the object
+
+   Used for object copies deleted by DDD during load migration.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX UnaccountObject (MULTIGRID *theMG, void *obj)
+{
+  INT cls;
+  MEM size = ObjectMemory(theMG,obj,&cls);
+
+  if (cls >= 0)
+    HeapStatFree(HEAPSTAT(MGHEAP(theMG),cls),size);
+}
+
+/****************************************************************************/
+/** \brief Name of an accounting class of the multigrid heap
+
+   \param cls - accounting class
+
+   \return name, NULL if no objects of this class are created
+ */
+/****************************************************************************/
+
+const char * NS_DIM_PREFIX MemoryClassName (INT cls)
+{
+  static char names[MAXHEAPSTAT][32];
+
+  switch (cls)
+  {
+  case IVOBJ :         return "ivertex";
+  case BVOBJ :         return "bvertex";
+  case EDOBJ :         return "edge";
+  case NDOBJ :         return "node";
+  case GROBJ :         return "grid";
+  case VEOBJ :         return "vector";
+  case MAOBJ :         return "matrix";
+  case BNDP_HEAPSTAT : return "bndp";
+  case BNDS_HEAPSTAT : return "bnds";
+  }
+
+  for (INT tag=0; tag<TAGS; tag++)
+  {
+    if (element_descriptors[tag] == NULL)
+      continue;
+    if (MAPPED_INNER_OBJT_TAG(tag) == cls)
+    {
+      snprintf(names[cls],sizeof(names[cls]),"inner_%s",TagName(tag));
+      return names[cls];
+    }
+    if (MAPPED_BND_OBJT_TAG(tag) == cls)
+    {
+      snprintf(names[cls],sizeof(names[cls]),"bnd_%s",TagName(tag));
+      return names[cls];
+    }
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+/** \brief Current and peak usage of a multigrid
+
+   \param theMG - multigrid to handle
+
+   The counters cover all objects allocated for the multigrid since it was
+   created, including the boundary points and sides of the domain module.
+
+   \return array of MAXHEAPSTAT records, indexed by accounting class
+ */
+/****************************************************************************/
+
+const HEAP_STAT * NS_DIM_PREFIX MultiGridMemoryStatistics (const MULTIGRID *theMG)
+{
+  return MGHEAP(theMG)->stat;
+}
+
+/****************************************************************************/
+/** \brief Count the objects of one grid level and their memory
+
+   \param theGrid - grid level to handle
+   \param stat - returns objects and bytes per accounting class
+
+   Counts vertices, nodes, edges, elements, vectors and matrices of the
+   level (all priorities). The peak entries are set to the current values.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX LevelMemoryCensus (GRID *theGrid, HEAP_STAT stat[MAXHEAPSTAT])
+{
+  MULTIGRID *theMG = MYMG(theGrid);
+  INT cls;
+
+  memset(stat,0,MAXHEAPSTAT*sizeof(HEAP_STAT));
+
+  for (VERTEX *theVertex=PFIRSTVERTEX(theGrid); theVertex!=NULL; theVertex=SUCCV(theVertex))
+  {
+    MEM size = ObjectMemory(theMG,theVertex,&cls);
+    if (cls >= 0)
+      HeapStatAlloc(&stat[cls],size);
+  }
+
+  for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+  {
+    MEM size = ObjectMemory(theMG,theNode,&cls);
+    HeapStatAlloc(&stat[cls],size);
+
+    /* each edge is counted at the node of its first link */
+    for (LINK *theLink=START(theNode); theLink!=NULL; theLink=NEXT(theLink))
+    {
+      EDGE *theEdge = MYEDGE(theLink);
+      if (LINK0(theEdge) != theLink)
+        continue;
+      size = ObjectMemory(theMG,theEdge,&cls);
+      HeapStatAlloc(&stat[cls],size);
+    }
+  }
+
+  for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+  {
+    MEM size = ObjectMemory(theMG,theElement,&cls);
+    HeapStatAlloc(&stat[cls],size);
+  }
+
+  for (VECTOR *theVector=PFIRSTVECTOR(theGrid); theVector!=NULL; theVector=SUCCVC(theVector))
+  {
+    MEM size = ObjectMemory(theMG,theVector,&cls);
+    HeapStatAlloc(&stat[cls],size);
+
+    /* a connection is counted at the vector of its first matrix */
+    for (MATRIX *theMatrix=VSTART(theVector); theMatrix!=NULL; theMatrix=MNEXT(theMatrix))
+      if (MDIAG(theMatrix))
+        HeapStatAlloc(&stat[MAOBJ],UG_MSIZE(theMatrix));
+      else if (MMYCON(theMatrix) == theMatrix)
+        HeapStatAlloc(&stat[MAOBJ],2*UG_MSIZE(theMatrix));
+  }
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Write the memory statistics of a multigrid
+
+   \param theMG - multigrid to handle
+   \param stream - output stream
+
+   Writes one line per scope and accounting class with the columns
+
+   <scope> <class> <objects> <peak objects> <bytes> <peak bytes>
+
+   where scope is 'total' for the counters of the multigrid heap,
+   'level<l>' for the census of level l and, in the parallel case, 'ddd'
+   for the memory of the DDD interfaces, couplings and message buffers
+   of this process. Lines starting with '#' are comments. Classes without
+   objects are omitted.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   <li> GM_ERROR if the stream could not be written </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX WriteMemoryStatistics (MULTIGRID *theMG, FILE *stream)
+{
+  HEAP_STAT stat[MAXHEAPSTAT];
+  char scope[16];
+
+#ifdef ModelP
+  fprintf(stream,"# rank %d\n",theMG->ppifContext().me());
+#endif
+  fprintf(stream,"# scope class objects peak_objects bytes peak_bytes\n");
+
+  const HEAP_STAT *total = MultiGridMemoryStatistics(theMG);
+  for (INT cls=0; cls<MAXHEAPSTAT; cls++)
+    if (total[cls].peakObjects > 0 && MemoryClassName(cls) != NULL)
+      WriteStat(stream,"total",MemoryClassName(cls),&total[cls]);
+
+  for (INT l=0; l<=TOPLEVEL(theMG); l++)
+  {
+    LevelMemoryCensus(GRID_ON_LEVEL(theMG,l),stat);
+    snprintf(scope,sizeof(scope),"level%d",(int)l);
+    for (INT cls=0; cls<MAXHEAPSTAT; cls++)
+      if (stat[cls].objects > 0 && MemoryClassName(cls) != NULL)
+        WriteStat(stream,scope,MemoryClassName(cls),&stat[cls]);
+  }
+
+#ifdef ModelP
+  {
+    const DDD::DDDContext& context = theMG->dddContext();
+    HEAP_STAT s;
+
+    memset(&s,0,sizeof(s));
+    s.bytes = s.peakBytes = DDD_IFInfoMemoryAll(context);
+    WriteStat(stream,"ddd","interfaces",&s);
+
+    WriteStat(stream,"ddd","couplings",memmgr_Statistics(MEMMGR_STAT_CPL));
+    WriteStat(stream,"ddd","messages",memmgr_Statistics(MEMMGR_STAT_MSG));
+    WriteStat(stream,"ddd","temporary",memmgr_Statistics(MEMMGR_STAT_TMP));
+    WriteStat(stream,"ddd","tables",memmgr_Statistics(MEMMGR_STAT_AMEM));
+  }
+#endif
+
+  if (ferror(stream))
+    REP_ERR_RETURN(GM_ERROR);
+
+  return (GM_OK);
+}
+
+/****************************************************************************/
+/** \brief Write the sizes of the grid objects of the configured layout
+
+   \param stream - file to write to
+
+   Writes one line per object with its name and size in bytes. Nodes and
+   edges without a vector are smaller by one pointer. Element sizes are
+   only known after the element types have been initialized.
+
+   \return <ul>
+   <li> GM_OK if ok </li>
+   <li> GM_ERROR if writing failed </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX WriteObjectSizes (FILE *stream)
+{
+  fprintf(stream,"# layout message_buffer %s node_element_list %s\n",
+#ifdef UG_HAS_MESSAGE_BUFFER
+          "on",
+#else
+          "off",
+#endif
+#ifndef UG_NO_NODE_ELEMENTLIST
+          "on"
+#else
+          "off"
+#endif
+          );
+  fprintf(stream,"# object bytes\n");
+
+  fprintf(stream,"ivertex %lu\n",(unsigned long)sizeof(struct ivertex));
+  fprintf(stream,"bvertex %lu\n",(unsigned long)sizeof(struct bvertex));
+  fprintf(stream,"node %lu\n",(unsigned long)sizeof(NODE));
+  fprintf(stream,"node_novector %lu\n",(unsigned long)(sizeof(NODE)-sizeof(VECTOR *)));
+  fprintf(stream,"edge %lu\n",(unsigned long)sizeof(EDGE));
+  fprintf(stream,"edge_novector %lu\n",(unsigned long)(sizeof(EDGE)-sizeof(VECTOR *)));
+  fprintf(stream,"vector %lu\n",(unsigned long)sizeof(VECTOR));
+
+  for (INT tag=0; tag<TAGS; tag++)
+  {
+    if (element_descriptors[tag] == NULL)
+      continue;
+    fprintf(stream,"inner_%s %lu\n",TagName(tag),(unsigned long)INNER_SIZE_TAG(tag));
+    fprintf(stream,"bnd_%s %lu\n",TagName(tag),(unsigned long)BND_SIZE_TAG(tag));
+  }
+
+  if (ferror(stream))
+    REP_ERR_RETURN(GM_ERROR);
+
+  return (GM_OK);
+}
+
+/** @} */
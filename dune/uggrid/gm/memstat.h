@@ -0,0 +1,79 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/*! \file memstat.h
+ * \ingroup gm
+ */
+
+/** \addtogroup gm
+ *
+ * @{
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      memstat.h                                                     */
+/*                                                                          */
+/* Purpose:   memory accounting of a multigrid per object type              */
+/*                                                                          */
+/* Remarks:   The counters themselves live in the multigrid heap (HEAP_STAT) */
+/*            and are updated by GetMemoryForObject/PutFreeObject and the   */
+/*            domain module. This module names the accounting classes,      */
+/*            computes per-level censuses and writes reports.               */
+/*                                                                          */
+/****************************************************************************/
+
+
+/****************************************************************************/
+/*                                                                          */
+/* auto include mechanism and other include files                           */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef __MEMSTAT__
+#define __MEMSTAT__
+
+#include <cstdio>
+
+#include <dune/uggrid/low/heaps.h>
+#include <dune/uggrid/low/namespace.h>
+#include <dune/uggrid/low/ugtypes.h>
+
+#include "gm.h"
+
+START_UGDIM_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* function declarations                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Accounting class and size in bytes of a grid object as allocated by the grid manager */
+MEM ObjectMemory (const MULTIGRID *theMG, void *obj, INT *cls);
+
+/** \brief Record a grid object which was not allocated by GetMemoryForObject */
+void AccountObject (MULTIGRID *theMG, void *obj);
+
+/** \brief Remove a grid object which is not freed by PutFreeObject from the accounting */
+void UnaccountObject (MULTIGRID *theMG, void *obj);
+
+/** \brief Name of an accounting class, NULL if the class is unused */
+const char *MemoryClassName (INT cls);
+
+/** \brief Current and peak usage of the whole multigrid, indexed by accounting class */
+const NS_PREFIX HEAP_STAT *MultiGridMemoryStatistics (const MULTIGRID *theMG);
+
+/** \brief Count the objects of one grid level and their memory */
+INT LevelMemoryCensus (GRID *theGrid, NS_PREFIX HEAP_STAT stat[MAXHEAPSTAT]);
+
+/** \brief Write totals, peaks and the per-level census in a line-oriented format */
+INT WriteMemoryStatistics (MULTIGRID *theMG, FILE *stream);
+
+/** \brief Write the sizes of the grid objects of the configured layout */
+INT WriteObjectSizes (FILE *stream);
+
+END_UGDIM_NAMESPACE
+
+#endif
+
+/** @} */
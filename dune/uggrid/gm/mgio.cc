@@ -33,6 +33,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <cassert>
+#include <atomic>
+#include <thread>
 
 #include <dune/uggrid/low/bio.h>
 #include "mgio.h"
@@ -124,6 +126,28 @@ static int nparfiles;                                     /* nb of parallel file
 /* local storage of general elements */
 static MGIO_GE_ELEMENT lge[MGIO_TAGS];
 
+/* asynchronous writing: the records go to an in-memory stream (the
+   snapshot) and CloseMGFile hands it to a background thread writing it
+   to the file opened by Write_OpenMGFile */
+static int asyncWrite;                                  /* write in the background      */
+static FILE *target;                                    /* file of the current snapshot */
+static char *snapshot;                                  /* memory of the snapshot       */
+static size_t snapshotSize;                             /* size of the snapshot         */
+
+/** \brief Thread writing the last snapshot, joined before the next one is handed over */
+static struct AsyncWriter
+{
+  std::thread thread;
+  std::atomic<int> busy{0};
+  int error = 0;
+
+  ~AsyncWriter ()
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+} writer;
+
 
 /****************************************************************************/
 /*																			*/
@@ -223,6 +247,8 @@ int NS_DIM_PREFIX MGIO_filetype (char *filename)
 
 int NS_DIM_PREFIX Read_OpenMGFile (char *filename)
 {
+  /* the file may still be written in the background */
+  MGIO_WaitAsyncWrite();
 
 #ifdef __MGIO_USE_IN_UG__
   if (mgpathes_set) stream = FileOpenUsingSearchPaths(filename,"r","mgpaths");
@@ -271,6 +297,22 @@ int NS_DIM_PREFIX Write_OpenMGFile (char *filename, int rename)
 #endif
 
   if (stream==NULL) return (1);
+
+#if HAVE_OPEN_MEMSTREAM
+  /* write the records to memory, the file is written by CloseMGFile */
+  if (asyncWrite)
+  {
+    target = stream;
+    stream = open_memstream(&snapshot,&snapshotSize);
+    if (stream==NULL)
+    {
+      fclose(target);
+      target = NULL;
+      return (1);
+    }
+  }
+#endif
+
   return (0);
 }
 
@@ -1645,8 +1687,120 @@ int NS_DIM_PREFIX Write_PBndDesc (int n, BNDP **BndPList)
 
 int NS_DIM_PREFIX CloseMGFile (void)
 {
-  if (fclose(stream)!=0) return (1);
+  FILE *file;
+  char *data;
+  size_t size;
+  int error;
+
+  /* complete the last block of a compressed file */
+  error = Bio_Flush();
+  if (fclose(stream)!=0 || error) return (1);
+  if (target==NULL) return (0);
+
+  /* at most one snapshot is written while the next one is taken */
+  error = MGIO_WaitAsyncWrite();
+
+  file = target;
+  data = snapshot;
+  size = snapshotSize;
+  target = NULL;
+  snapshot = NULL;
+
+  writer.busy = 1;
+  writer.thread = std::thread([file,data,size]()
+                              {
+                                int err = 0;
+
+                                if (size>0 && fwrite(data,size,1,file)!=1) err = 1;
+                                if (fclose(file)!=0) err = 1;
+                                free(data);
+                                writer.error = err;
+                                writer.busy = 0;
+                              });
+
+  return (error);
+}
+
+/****************************************************************************/
+/*
+   MGIO_SetAsyncWrite - write multigrid files in the background
+
+   SYNOPSIS:
+   int MGIO_SetAsyncWrite (int async);
+
+   PARAMETERS:
+   .  async - 1: write in the background, 0: write directly to the file
+
+   DESCRIPTION:
+   In asynchronous mode the records of a multigrid file are written to
+   memory. CloseMGFile starts a thread writing them to the file and
+   returns, so the caller only waits for the snapshot to be taken and
+   for a previous background write which has not finished yet.
+
+   RETURN VALUE:
+   INT
+   .n      0 if ok
+   .n      1 if asynchronous writing is not available on this platform
+
+   SEE ALSO:
+   MGIO_AsyncWriteDone, MGIO_WaitAsyncWrite
+ */
+/****************************************************************************/
+
+int NS_DIM_PREFIX MGIO_SetAsyncWrite (int async)
+{
+#if HAVE_OPEN_MEMSTREAM
+  asyncWrite = async;
   return (0);
+#else
+  asyncWrite = 0;
+  return (async ? 1 : 0);
+#endif
+}
+
+/****************************************************************************/
+/*
+   MGIO_AsyncWriteDone - check whether the background write has finished
+
+   SYNOPSIS:
+   int MGIO_AsyncWriteDone (void);
+
+   RETURN VALUE:
+   INT
+   .n      1 if no file is written in the background
+   .n      0 otherwise
+ */
+/****************************************************************************/
+
+int NS_DIM_PREFIX MGIO_AsyncWriteDone (void)
+{
+  return (writer.busy ? 0 : 1);
+}
+
+/****************************************************************************/
+/*
+   MGIO_WaitAsyncWrite - wait for the background write to finish
+
+   SYNOPSIS:
+   int MGIO_WaitAsyncWrite (void);
+
+   RETURN VALUE:
+   INT
+   .n      0 if ok
+   .n      1 if the last background write failed
+ */
+/****************************************************************************/
+
+int NS_DIM_PREFIX MGIO_WaitAsyncWrite (void)
+{
+  int error;
+
+  if (writer.thread.joinable())
+    writer.thread.join();
+  error = writer.error;
+  writer.error = 0;
+
+  return (error);
 }
 
 /****************************************************************************/
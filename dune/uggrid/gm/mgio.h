@@ -441,6 +441,11 @@ int     CloseMGFile                     (void);
 int     MGIO_Init                       (void);
 int             MGIO_dircreate          (char *filename, int rename);
 
+/* background writing */
+int             MGIO_SetAsyncWrite      (int async);
+int             MGIO_AsyncWriteDone     (void);
+int             MGIO_WaitAsyncWrite     (void);
+
 END_UGDIM_NAMESPACE
 
 #endif
@@ -0,0 +1,75 @@
+#include "config.h"
+
+#include <cstddef>
+#include <cstdio>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/uggrid/initug.h>
+
+#include "gm.h"
+#include "memstat.h"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+/* Size budgets of the hot objects on LP64 platforms, built up from their */
+/* members so that a new field shows up here.                             */
+
+#ifdef ModelP
+static const std::size_t header = sizeof(DDD_HEADER);
+#else
+static const std::size_t header = 0;
+#endif
+
+#ifdef UG_HAS_MESSAGE_BUFFER
+static const std::size_t messageBuffer = sizeof(char *) + sizeof(std::size_t);
+#else
+static const std::size_t messageBuffer = 0;
+#endif
+
+/* control, id, levelIndex, isLeaf (padded); pred, succ, start, father,   */
+/* son, myvertex, vector; optional element list                           */
+static const std::size_t nodeBudget = header + 4*sizeof(INT) + messageBuffer
+                                      + 7*sizeof(void *)
+#ifndef UG_NO_NODE_ELEMENTLIST
+                                      + sizeof(void *)
+#endif
+;
+
+/* control, id, flag, property, levelIndex, leafIndex; lb1 (padded);      */
+/* pred, succ, first reference                                            */
+static const std::size_t elementBudget = header + 6*sizeof(INT) + messageBuffer
+#ifdef ModelP
+                                         + 2*sizeof(INT)
+#endif
+                                         + 3*sizeof(void *);
+
+int main(int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  bool pass = true;
+
+  WriteObjectSizes(stdout);
+
+  if (sizeof(void *) == 8)
+  {
+    if (sizeof(NODE) > nodeBudget)
+    {
+      std::printf("node has %zu bytes, budget is %zu\n", sizeof(NODE), nodeBudget);
+      pass = false;
+    }
+    if (sizeof(struct generic_element) > elementBudget)
+    {
+      std::printf("element header has %zu bytes, budget is %zu\n",
+                  sizeof(struct generic_element), elementBudget);
+      pass = false;
+    }
+  }
+
+  ExitUg();
+
+  return pass ? 0 : 1;
+}
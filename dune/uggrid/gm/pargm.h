@@ -40,6 +40,8 @@
 #include <dune/uggrid/low/ugtypes.h>
 
 #ifdef ModelP
+#include <mpi.h>
+
 #include <dune/uggrid/parallel/ddd/include/ddd.h>
 #include <dune/uggrid/parallel/ppif/ppif.h>
 #endif
@@ -368,7 +370,30 @@ enum {VERTEX_LISTPARTS = 1};
 #define UG_GlobalSumNDOUBLE(context, x,y)
 #define UG_GlobalMaxNDOUBLE(context, x,y)
 #define UG_GlobalMinNDOUBLE(context, x,y)
+#define UG_IGlobalSumNINT(context, x,y,r)
+#define UG_IGlobalMaxNINT(context, x,y,r)
+#define UG_IGlobalMinNINT(context, x,y,r)
+#define UG_IGlobalSumNDOUBLE(context, x,y,r)
+#define UG_IGlobalMaxNDOUBLE(context, x,y,r)
+#define UG_IGlobalMinNDOUBLE(context, x,y,r)
+#define UG_TestReduction(r)      true
+#define UG_WaitReduction(r)
+#endif
+
+
+/****************************************************************************/
+/*                                                                          */
+/* data structures exported by the corresponding source file                */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Handle of a reduction started by one of the UG_IGlobal functions */
+struct UG_REDUCTION
+{
+#ifdef ModelP
+  MPI_Request request = MPI_REQUEST_NULL;
 #endif
+};
 
 
 /****************************************************************************/
@@ -397,6 +422,14 @@ DOUBLE UG_GlobalMinDOUBLE  (const PPIF::PPIFContext& context, DOUBLE i);
 void   UG_GlobalSumNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x);
 void   UG_GlobalMaxNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x);
 void   UG_GlobalMinNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x);
+void   UG_IGlobalSumNINT    (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r);
+void   UG_IGlobalMaxNINT    (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r);
+void   UG_IGlobalMinNINT    (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r);
+void   UG_IGlobalSumNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r);
+void   UG_IGlobalMaxNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r);
+void   UG_IGlobalMinNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r);
+bool   UG_TestReduction     (UG_REDUCTION *r);
+void   UG_WaitReduction     (UG_REDUCTION *r);
 #endif
 
 END_UGDIM_NAMESPACE
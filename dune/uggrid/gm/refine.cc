@@ -64,6 +64,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <vector>
 
 #include <dune/common/unused.hh>
 
@@ -84,6 +85,7 @@
 #include "cw.h"
 #include "refine.h"
 #include "elements.h"
+#include "indexsets.h"
 #include "rm.h"
 #include "ugm.h"
 #include "mgheapmgr.h"
@@ -366,6 +368,14 @@ static INT fifoloop = 0;
 /** \brief count of adapted elements        */
 static INT total_adapted = 0;
 
+#ifdef ModelP
+/** \brief elements of the adapted level with THEFLAG set, drives the overlap update */
+static std::vector<ELEMENT *> overlapChanged;
+
+/** \brief lowest level whose overlap the current adaptation changed */
+static INT overlapFromLevel;
+#endif
+
 #ifdef STAT_OUT
 /* timing variables */
 static int adapt_timer,closure_timer,gridadapt_timer,gridadapti_timer;
@@ -872,17 +882,13 @@ static int Scatter_ElementClosureInfo (DDD::DDDContext&, DDD_OBJ obj, void *data
   return(GM_OK);
 }
 
-static INT ExchangeElementClosureInfo (GRID *theGrid)
+/* only elements with closure information are sent in ExchangeClosureInfo(), */
+/* the others would not change the receiver, see there                       */
+static int Gather_ElementClosureDelta (DDD::DDDContext& context, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
 {
-  auto& context = theGrid->dddContext();
-  const auto& dddctrl = ddd_ctrl(context);
+  Gather_ElementClosureInfo(context,obj,data,proc,prio);
 
-  /* exchange information of elements to compute closure */
-  DDD_IFAOnewayX(context,
-                 dddctrl.ElementSymmVHIF,GRID_ATTR(theGrid),IF_FORWARD,sizeof(INT),
-                 Gather_ElementClosureInfo, Scatter_ElementClosureInfo);
-
-  return(GM_OK);
+  return(((INT *)data)[0]!=0);
 }
 
 static int Gather_ElementRefine (DDD::DDDContext&, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
@@ -997,15 +1003,25 @@ static int Scatter_EdgeClosureInfo (DDD::DDDContext&, DDD_OBJ obj, void *data)
   return(GM_OK);
 }
 
+/* only edges with a pattern are sent */
+static int Gather_EdgeClosureDelta (DDD::DDDContext& context, DDD_OBJ obj, void *data)
+{
+  Gather_EdgeClosureInfo(context,obj,data);
+
+  return(((INT *)data)[0]!=0);
+}
+
 INT     ExchangeEdgeClosureInfo (GRID *theGrid)
 {
   auto& context = theGrid->dddContext();
   const auto& dddctrl = ddd_ctrl(context);
 
   /* exchange information of edges to compute closure */
-  DDD_IFAOneway(context,
-                dddctrl.EdgeVHIF,GRID_ATTR(theGrid),IF_FORWARD,sizeof(INT),
-                Gather_EdgeClosureInfo, Scatter_EdgeClosureInfo);
+  DDD_IFMultiBegin(context);
+  DDD_IFMultiAOnewayDelta(context,
+                          dddctrl.EdgeVHIF,GRID_ATTR(theGrid),IF_FORWARD,sizeof(INT),
+                          Gather_EdgeClosureDelta, Scatter_EdgeClosureInfo);
+  DDD_IFMultiEnd(context);
 
   return(GM_OK);
 }
@@ -1016,28 +1032,49 @@ INT     ExchangeEdgeClosureInfo (GRID *theGrid)
    ExchangeClosureInfo -
 
    SYNOPSIS:
-   static INT ExchangeClosureInfo (GRID *theGrid);
+   static INT ExchangeClosureInfo (GRID *theGrid, INT edgesConsistent);
 
    PARAMETERS:
    .  theGrid
+   .  edgesConsistent - edge patterns were exchanged after their last change
 
    DESCRIPTION:
+   In 2D the edge patterns travel with the element information. In 3D
+   the edge interface is only exchanged if the edge patterns may have
+   changed since the last exchange, SetElementSidePatterns() only touches
+   side patterns. Element and edge information are then sent together
+   with DDD_IFMultiBegin()/DDD_IFMultiEnd().
+
+   Only elements and edges with nonzero information are sent. The
+   scatters OR the patterns, marks and side patterns into the receiver
+   and take the maximum of the edge patterns. Ghosts also take mark
+   class and coarsen flag from their master, but PrepareGridClosure()
+   has reset both on the ghosts, which is what a master without
+   information would send.
 
    \return <ul>
    INT
  */
 /****************************************************************************/
 
-static INT ExchangeClosureInfo (GRID *theGrid)
+static INT ExchangeClosureInfo (GRID *theGrid, INT edgesConsistent)
 {
+  auto& context = theGrid->dddContext();
+  const auto& dddctrl = ddd_ctrl(context);
 
-  /* exchange information of elements to compute closure */
-  if (ExchangeElementClosureInfo(theGrid) != GM_OK) RETURN(GM_ERROR);
-
+  /* the element and edge information are independent, */
+  /* they are exchanged in one communication round      */
+  DDD_IFMultiBegin(context);
+  DDD_IFMultiAOnewayDeltaX(context,
+                           dddctrl.ElementSymmVHIF,GRID_ATTR(theGrid),IF_FORWARD,sizeof(INT),
+                           Gather_ElementClosureDelta, Scatter_ElementClosureInfo);
         #ifdef __THREEDIM__
-  /* exchange information of edges to compute closure */
-  if (ExchangeEdgeClosureInfo(theGrid) != GM_OK) RETURN(GM_ERROR);
+  if (!edgesConsistent)
+    DDD_IFMultiAOnewayDelta(context,
+                            dddctrl.EdgeVHIF,GRID_ATTR(theGrid),IF_FORWARD,sizeof(INT),
+                            Gather_EdgeClosureDelta, Scatter_EdgeClosureInfo);
         #endif
+  DDD_IFMultiEnd(context);
 
   return(GM_OK);
 }
@@ -2145,6 +2182,9 @@ static INT CheckElementInfo (GRID *theGrid)
 static int GridClosure (GRID *theGrid)
 {
   INT cnt;
+        #ifdef ModelP
+  INT edgesConsistent;
+        #endif
 
   /* initialize used control word entries */
   if (PrepareGridClosure(theGrid) != GM_OK) RETURN(GM_ERROR);
@@ -2160,12 +2200,17 @@ static int GridClosure (GRID *theGrid)
   /* fifo loop */
   do
   {
+                #ifdef ModelP
+    edgesConsistent = 0;
+                #endif
+
                 #ifdef __THREEDIM__
                 #if defined(ModelP) && defined(DUNE_UGGRID_TET_RULESET)
     /* edge pattern is needed consistently in CorrectTetrahedronSidePattern() */
     if (!refine_seq)
     {
       if (ExchangeEdgeClosureInfo(theGrid) != GM_OK) return(GM_ERROR);
+      edgesConsistent = 1;
     }
                 #endif
 
@@ -2174,7 +2219,7 @@ static int GridClosure (GRID *theGrid)
                 #endif
 
                 #ifdef ModelP
-    if (ExchangeClosureInfo(theGrid) != GM_OK) RETURN(GM_ERROR);
+    if (ExchangeClosureInfo(theGrid,edgesConsistent) != GM_OK) RETURN(GM_ERROR);
                 #endif
 
     /* set rules on the elements */
@@ -2200,6 +2245,184 @@ static int GridClosure (GRID *theGrid)
 }
 
 
+/****************************************************************************/
+/** \brief Test whether a rule is the regular refinement of an element
+
+   \param theElement - pointer to element
+   \param rule - rule to test
+
+   The regular rules refine all edges and all quadrilateral sides. For
+   tetrahedra each of the three choices of the inner diagonal is regular.
+
+   \return <ul>
+   .n   true if the rule is regular
+   .n   false else
+ */
+/****************************************************************************/
+
+static bool IsRedRule (ELEMENT *theElement, INT rule)
+{
+  switch (TAG(theElement))
+  {
+        #ifdef __TWODIM__
+  case TRIANGLE :
+    return(rule==T_RED);
+  case QUADRILATERAL :
+    return(rule==Q_RED);
+        #endif
+        #ifdef __THREEDIM__
+  case TETRAHEDRON :
+    return(rule==FULL_REFRULE_0_5 || rule==FULL_REFRULE_1_3 ||
+           rule==FULL_REFRULE_2_4);
+  case PYRAMID :
+    return(rule==PYR_RED);
+  case PRISM :
+    return(rule==PRI_RED);
+  case HEXAHEDRON :
+    return(rule==HEXA_RED);
+        #endif
+  }
+
+  return(false);
+}
+
+
+/****************************************************************************/
+/** \brief Test whether the next adaptation refines all leaf elements red
+
+   \param theMG - multigrid to refine
+
+   The refinement is uniform if all master elements below the top level
+   are regular and keep their regular refinement, and if all master
+   elements on the top level are regular and marked for regular
+   refinement. Only the local elements are tested, in parallel the result
+   has to be reduced over all processors.
+
+   \return <ul>
+   .n   true if the refinement is uniform
+   .n   false else
+ */
+/****************************************************************************/
+
+static bool UniformRefinement (MULTIGRID *theMG)
+{
+  INT level;
+  ELEMENT *theElement;
+
+  for (level=0; level<TOPLEVEL(theMG); level++)
+    for (theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,level)); theElement!=NULL;
+         theElement=SUCCE(theElement))
+      if (ECLASS(theElement)!=RED_CLASS ||
+          REFINECLASS(theElement)!=RED_CLASS ||
+          !IsRedRule(theElement,REFINE(theElement)) ||
+          MARK(theElement)!=REFINE(theElement) ||
+          MARKCLASS(theElement)!=RED_CLASS ||
+          COARSEN(theElement))
+        return(false);
+
+  for (theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    if (ECLASS(theElement)!=RED_CLASS ||
+        MARKCLASS(theElement)!=RED_CLASS ||
+        !IsRedRule(theElement,MARK(theElement)) ||
+        COARSEN(theElement))
+      return(false);
+
+  return(true);
+}
+
+
+/****************************************************************************/
+/** \brief Compute the closure of a uniformly refined grid level
+
+   \param theGrid - pointer to grid structure
+
+   If all elements are refined red, every edge is refined and no green
+   or yellow elements are needed. The control word entries GridClosure()
+   and ComputeCopies() would compute are set directly, without closure
+   iteration and without communication: the rule of a copy is derived
+   from its own element type and geometry, like the rule of its master
+   (the inner diagonal of tetrahedra is chosen by theFullRefRule).
+
+   \return <ul>
+   .n   >=0 number of elements to refine
+   .n   -1 if an error occured
+ */
+/****************************************************************************/
+
+static int UniformClosure (GRID *theGrid)
+{
+  INT i,Mark,cnt;
+  ELEMENT *theElement;
+  EDGE    *theEdge;
+
+  ClearNextNodeClasses(theGrid);
+
+  cnt = 0;
+  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL;
+       theElement=SUCCE(theElement))
+  {
+    switch (TAG(theElement))
+    {
+                #ifdef __TWODIM__
+    case TRIANGLE :
+      Mark = T_RED;
+      break;
+    case QUADRILATERAL :
+      Mark = Q_RED;
+      break;
+                #endif
+                #ifdef __THREEDIM__
+    case TETRAHEDRON :
+      Mark = (*theFullRefRule)(theElement);
+      break;
+    case PYRAMID :
+      Mark = PYR_RED;
+      break;
+    case PRISM :
+      Mark = PRI_RED;
+      break;
+    case HEXAHEDRON :
+      Mark = HEXA_RED;
+      break;
+                #endif
+    default :
+      RETURN(-1);
+    }
+
+    SETCOARSEN(theElement,0);
+    SETMARK(theElement,Mark);
+    SETMARKCLASS(theElement,RED_CLASS);
+    if (Mark) cnt++;
+
+    /* patterns as left by GridClosure(), only computed with closure */
+    if (hFlag)
+    {
+                        #ifdef __THREEDIM__
+      SETUSED(theElement,1);
+                        #else
+      SETUSED(theElement,0);
+                        #endif
+
+      for (i=0; i<EDGES_OF_ELEM(theElement); i++)
+      {
+        theEdge=GetEdge(CORNER_OF_EDGE_PTR(theElement,i,0),
+                        CORNER_OF_EDGE_PTR(theElement,i,1));
+        ASSERT(theEdge != NULL);
+
+        SETPATTERN(theEdge,1);
+        SETADDPATTERN(theEdge,!NODE_OF_RULE(theElement,Mark,i));
+      }
+    }
+
+    /* no copies are needed, see ComputeCopies() */
+    SeedNextNodeClasses(theElement);
+  }
+
+  return(cnt);
+}
+
+
 
 /****************************************************************************/
 /*
@@ -5528,6 +5751,10 @@ static int AdaptGrid (GRID *theGrid, INT *nadapted)
   }
         #endif
 
+#ifdef ModelP
+  overlapChanged.clear();
+#endif
+
   /* refine elements                                                  */
   /* ModelP: first loop over master elems, then loop over ghost elems */
   /* this assures that no unnecessary disposures of objects are done  */
@@ -5622,10 +5849,13 @@ static int AdaptGrid (GRID *theGrid, INT *nadapted)
       SETREFINE(theElement,MARK(theElement));
       SETREFINECLASS(theElement,MARKCLASS(theElement));
       SETUSED(theElement,0);
+      SETNEWEL(theElement,1);
+      IndexSetsRefineChanged(MYMG(theGrid),theElement);
 
                         #ifdef ModelP
       /* set update overlap flag */
       SETTHEFLAG(theElement,1);
+      overlapChanged.push_back(theElement);
                         #endif
 
       /* this grid is modified */
@@ -5667,7 +5897,9 @@ static int AdaptGrid (GRID *theGrid, INT *nadapted)
     SETCOARSEN(theElement,0);
   }
 
-  if (UG_GlobalMaxINT(theGrid->ppifContext(), modified))
+  /* in parallel AdaptGrid() also resets the status if only */
+  /* other processors modified the grid                      */
+  if (modified)
   {
     /* reset (multi)grid status */
     SETGLOBALGSTATUS(UpGrid);
@@ -5721,6 +5953,11 @@ static int AdaptGrid (GRID *theGrid, INT toplevel, INT level, INT newlevel, INT
   DDD_ObjMgrEnd();
         #endif
 
+  /* sum up the adapted elements while the objects are transferred */
+  UG_REDUCTION adaptedReduction;
+  INT adapted = *nadapted;
+  UG_IGlobalSumNINT(theGrid->ppifContext(), 1, &adapted, &adaptedReduction);
+
   DDD_XferEnd(theGrid->dddContext());
 
   SUM_TIMER(gridadaptl_timer)
@@ -5743,7 +5980,14 @@ static int AdaptGrid (GRID *theGrid, INT toplevel, INT level, INT newlevel, INT
     }
 
     /* if no grid adaption has occured adapt next level */
-    *nadapted = UG_GlobalSumINT(theGrid->ppifContext(), *nadapted);
+    UG_WaitReduction(&adaptedReduction);
+    *nadapted = adapted;
+    if (*nadapted > 0 && FinerGrid != NULL)
+    {
+      /* reset (multi)grid status */
+      SETGLOBALGSTATUS(FinerGrid);
+      RESETMGSTATUS(MYMG(FinerGrid));
+    }
     if (*nadapted == 0)
     {
       if (!IDENT_IN_STEPS)
@@ -5783,7 +6027,15 @@ static int AdaptGrid (GRID *theGrid, INT toplevel, INT level, INT newlevel, INT
       if (0) /* delete sine this is already done in     */
         /* ConstructConsistentGrid() (s.l. 980522) */
         if (SetGridBorderPriorities(theGrid)) RETURN(GM_FATAL);
+#ifdef UPDATE_FULLOVERLAP
       if (UpdateGridOverlap(theGrid)) RETURN(GM_FATAL);
+      overlapFromLevel = std::min(overlapFromLevel,level+1);
+#else
+      /* only the changed elements and their neighbors are visited */
+      if (UpdateChangedGridOverlap(theGrid,overlapChanged)) RETURN(GM_FATAL);
+      if (!overlapChanged.empty())
+        overlapFromLevel = std::min(overlapFromLevel,level+1);
+#endif
 
 
       DDD_XferEnd(theGrid->dddContext());
@@ -5791,7 +6043,11 @@ static int AdaptGrid (GRID *theGrid, INT toplevel, INT level, INT newlevel, INT
       DDD_CONSCHECK(theGrid->dddContext());
 
       DDD_XferBegin(theGrid->dddContext());
+#ifdef UPDATE_FULLOVERLAP
       if (ConnectGridOverlap(theGrid)) RETURN(GM_FATAL);
+#else
+      if (ConnectChangedGridOverlap(theGrid,overlapChanged)) RETURN(GM_FATAL);
+#endif
       DDD_XferEnd(theGrid->dddContext());
 
       DDD_CONSCHECK(theGrid->dddContext());
@@ -5924,21 +6180,20 @@ void NS_DIM_PREFIX Manage_Adapt_Timer (int alloc)
 
 void NS_DIM_PREFIX Print_Adapt_Timer (const MULTIGRID* theMG, int total_adapted)
 {
+  DOUBLE t[9] = {EVAL_TIMER(adapt_timer),EVAL_TIMER(closure_timer),EVAL_TIMER(gridadapt_timer),
+                 EVAL_TIMER(gridadapti_timer),EVAL_TIMER(gridadaptl_timer),EVAL_TIMER(overlap_timer),
+                 EVAL_TIMER(ident_timer),EVAL_TIMER(gridcons_timer),EVAL_TIMER(algebra_timer)};
+
   UserWriteF("ADAPT: total_adapted=%d t_adapt=%.2f: t_closure=%.2f t_gridadapt=%.2f t_gridadapti=%.2f "
              "t_gridadaptl=%.2f t_overlap=%.2f t_ident=%.2f t_gridcons=%.2f t_algebra=%.2f\n",
-             total_adapted,EVAL_TIMER(adapt_timer),EVAL_TIMER(closure_timer),EVAL_TIMER(gridadapt_timer),
-             EVAL_TIMER(gridadapti_timer),EVAL_TIMER(gridadaptl_timer),EVAL_TIMER(overlap_timer),
-             EVAL_TIMER(ident_timer),EVAL_TIMER(gridcons_timer),EVAL_TIMER(algebra_timer));
+             total_adapted,t[0],t[1],t[2],t[3],t[4],t[5],t[6],t[7],t[8]);
+
+  /* all maxima in one reduction */
+  UG_GlobalMaxNDOUBLE(theMG->ppifContext(), 9, t);
   UserWriteF("ADAPTMAX: total_adapted=%d t_adapt=%.2f: t_closure=%.2f t_gridadapt=%.2f "
              "t_gridadapti=%.2f "
              "t_gridadaptl=%.2f t_overlap=%.2f t_ident=%.2f t_gridcons=%.2f t_algebra=%.2f\n",
-             total_adapted,UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(adapt_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(closure_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(gridadapt_timer)),UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(gridadapti_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(gridadaptl_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(overlap_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(ident_timer)),UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(gridcons_timer)),
-             UG_GlobalMaxDOUBLE(theMG->ppifContext(), EVAL_TIMER(algebra_timer)));
+             total_adapted,t[0],t[1],t[2],t[3],t[4],t[5],t[6],t[7],t[8]);
 }
 #endif
 
@@ -5960,6 +6215,9 @@ static INT      PostProcessAdaptMultiGrid(MULTIGRID *theMG)
   if (CreateAlgebra(theMG)) REP_ERR_RETURN(1);
   SUM_TIMER(algebra_timer)
 
+  /* invalidate caches derived from the old topology */
+  MG_TOPOLOGY_CHANGED(theMG);
+
   REFINE_MULTIGRID_LIST(1,theMG,"END AdaptMultiGrid():\n","","");
 
   /*
@@ -5992,6 +6250,13 @@ static INT      PostProcessAdaptMultiGrid(MULTIGRID *theMG)
 
    This function refines whole multigrid structure
 
+   If all leaf elements are regular and marked for red refinement (and the
+   coarser levels keep their red refinement), the closure is neither
+   restricted to nor computed on the coarser levels. Only the top level is
+   visited, and its marks and patterns are set by UniformClosure(). In
+   parallel the refinement has to be uniform on all processors. This is
+   not done if bit 4 of flag is set.
+
    \return <ul>
    <li> 0 - ok
    <li> 1 - out of memory, but data structure as before
@@ -6003,7 +6268,7 @@ static INT      PostProcessAdaptMultiGrid(MULTIGRID *theMG)
 INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtest)
 {
   INT level,toplevel,nrefined,nadapted;
-  INT newlevel;
+  INT newlevel,uniform;
   NODE *theNode;
   GRID *theGrid, *FinerGrid;
   ELEMENT *theElement;
@@ -6014,7 +6279,19 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
 
   if (PreProcessAdaptMultiGrid(theMG)) REP_ERR_RETURN(1);
 
+  /* are all leaf elements marked red? */
+  uniform = UniformRefinement(theMG);
+
 #ifdef ModelP
+  overlapFromLevel = MAXLEVEL;
+
+  /* the global toplevel is not changed by restricting the partitioning, */
+  /* the refinement is uniform if it is uniform on all processors        */
+  UG_REDUCTION toplevelReduction;
+  INT reduced[2] = {TOPLEVEL(theMG), !uniform};
+  INT &globalToplevel = reduced[0];
+  UG_IGlobalMaxNINT(theMG->ppifContext(), 2, reduced, &toplevelReduction);
+
   {
     /* check and restrict partitioning of elements */
     if (CheckPartitioning(theMG))
@@ -6029,7 +6306,11 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
        * Anyway, no crashes for now.
        */
       for (level=0; level<TOPLEVEL(theMG); level++)
-        if (RestrictPartitioning(theMG)) RETURN(GM_FATAL);
+        if (RestrictPartitioning(theMG))
+        {
+          UG_WaitReduction(&toplevelReduction);
+          RETURN(GM_FATAL);
+        }
       if (CheckPartitioning(theMG)) assert(0);
     }
   }
@@ -6045,7 +6326,9 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
         #ifndef ModelP
   if (TOPLEVEL(theMG) == 0)
         #else
-  if (UG_GlobalMaxINT(theMG->ppifContext(), TOPLEVEL(theMG)) == 0)
+  UG_WaitReduction(&toplevelReduction);
+  uniform = !reduced[1];
+  if (globalToplevel == 0)
         #endif
   {
     SETREFINESTEP(REFINEINFO(theMG),0);
@@ -6075,6 +6358,9 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
   hFlag=!((flag>>2)&0x1);       /* use hanging nodes */
   fifoFlag=(flag>>3)&0x1;       /* use fifo              */
 
+  /* the fifo closure is not bypassed, and bit 4 disables the bypass */
+  if (fifoFlag || ((flag>>4)&0x1)) uniform = 0;
+
   refine_seq = seq;
 
   No_Green_Update=0;
@@ -6096,9 +6382,10 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
   REFINE_MULTIGRID_LIST(1,theMG,"AdaptMultiGrid()","","")
 
   /* compute modification of coarser levels from above */
+  /* (none if the refinement is uniform)                 */
   START_TIMER(closure_timer)
 
-  for (level=toplevel; level>0; level--)
+  for (level=toplevel; level>0 && !uniform; level--)
   {
     theGrid = GRID_ON_LEVEL(theMG,level);
 
@@ -6146,7 +6433,24 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
     SETMODIFIED(theGrid,0);
     for (theNode=FIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode)) SETMODIFIED(theNode,0);
 
-    if (hFlag)
+    if (uniform)
+    {
+      /* only the top level is refined, all of it red */
+      if (level<toplevel)
+      {
+        SUM_TIMER(closure_timer)
+        continue;
+      }
+
+      if ((nrefined = UniformClosure(theGrid))<0)
+      {
+        PrintErrorMessage('E',"AdaptMultiGrid","error in UniformClosure");
+        RETURN(GM_ERROR);
+      }
+
+      REFINE_GRID_LIST(1,theMG,level,("End UniformClosure(%d):\n",level),"");
+    }
+    else if (hFlag)
     {
       /* leave only regular marks */
       for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
@@ -6173,7 +6477,8 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
     }
                 #endif
 
-    nrefined += ComputeCopies(theGrid);
+    if (!uniform)
+      nrefined += ComputeCopies(theGrid);
 
     if (hFlag)
     {
@@ -6207,10 +6512,14 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
     }
 
     /* create a new grid level, if at least one element is refined on finest level */
-    if (nrefined>0 && level==toplevel) newlevel = 1;
+    /* (newlevel stays 0 on all processors below toplevel, no need to reduce it) */
+    if (level==toplevel)
+    {
+      if (nrefined>0) newlevel = 1;
 #ifdef ModelP
-    newlevel = UG_GlobalMaxINT(theMG->ppifContext(), newlevel);
+      newlevel = UG_GlobalMaxINT(theMG->ppifContext(), newlevel);
 #endif
+    }
     if (newlevel)
     {
       if (CreateNewLevel(theMG)==NULL)
@@ -6265,6 +6574,15 @@ INT NS_DIM_PREFIX AdaptMultiGrid (MULTIGRID *theMG, INT flag, INT seq, INT mgtes
         #ifdef ModelP
   IdentifyExit();
 
+  /* the overlap updates above only create the first ghost layer, */
+  /* the further layers are added on the levels they changed      */
+  if (theMG->overlapDepth > 1)
+  {
+    INT fromLevel = UG_GlobalMinINT(theMG->ppifContext(),overlapFromLevel);
+    if (fromLevel < MAXLEVEL)
+      if (WidenGridOverlap(theMG,theMG->overlapDepth-1,fromLevel)) RETURN(GM_FATAL);
+  }
+
   /* now repair inconsistencies                   */
   /* former done on each grid level (s.l. 980522) */
   START_TIMER(gridcons_timer);
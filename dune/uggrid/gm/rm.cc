@@ -29,6 +29,7 @@
 #include <config.h>
 
 /* standard C library */
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cmath>
@@ -2442,6 +2443,138 @@ INT NS_DIM_PREFIX EstimateHere (const ELEMENT *theElement)
 }
 
 
+/****************************************************************************/
+/*                                                                          */
+/* pattern to rule lookup tables                                            */
+/*                                                                          */
+/* Each table maps pattern % size to a (pattern,rule) pair, so a rule is    */
+/* found with one indexed load and a compare. The 2D tables are dense, the  */
+/* sparse 3D patterns use the smallest collision-free size. All tables are  */
+/* built at compile time.                                                   */
+/*                                                                          */
+/****************************************************************************/
+
+namespace {
+
+struct PatternRule
+{
+  INT pattern;
+  SHORT rule;
+};
+
+/* smallest table size for which no two patterns share a slot */
+template<std::size_t N>
+constexpr std::size_t PatternTableSize (const PatternRule (&map)[N])
+{
+  for (std::size_t m=N; ; m++)
+  {
+    bool unique = true;
+    for (std::size_t i=0; i<N && unique; i++)
+      for (std::size_t j=i+1; j<N && unique; j++)
+        unique = (map[i].pattern % m != map[j].pattern % m);
+    if (unique)
+      return m;
+  }
+}
+
+template<std::size_t M, std::size_t N>
+constexpr std::array<PatternRule,M> PatternTable (const PatternRule (&map)[N])
+{
+  std::array<PatternRule,M> table {};
+  for (auto& entry : table)
+    entry = {-1,-1};
+  for (const auto& entry : map)
+    table[entry.pattern % M] = entry;
+  return table;
+}
+
+/* rule of a pattern, -1 if there is none */
+template<std::size_t M>
+inline INT LookupRule (const std::array<PatternRule,M>& table, INT pattern)
+{
+  const PatternRule& entry = table[static_cast<unsigned int>(pattern) % M];
+  return (entry.pattern == pattern) ? entry.rule : -1;
+}
+
+#define PATTERN_TABLE(name,map) \
+  constexpr auto name = PatternTable<PatternTableSize(map)>(map)
+
+#ifdef __TWODIM__
+/** \todo 0 can mean T_COPY OR T_NOREF */
+constexpr PatternRule triangleRules[] = {
+  {0,T_NOREF}, {1,T_BISECT_1_0}, {2,T_BISECT_1_1}, {3,T_BISECT_2_T1_2},
+  {4,T_BISECT_1_2}, {5,T_BISECT_2_T1_1}, {6,T_BISECT_2_T1_0}, {7,T_RED}
+};
+
+/** \todo 0 can mean Q_COPY OR Q_NOREF */
+constexpr PatternRule quadrilateralRules[] = {
+  {0,Q_NOREF}, {5,Q_BLUE_0}, {7,Q_CLOSE_3_3}, {10,Q_BLUE_1},
+  {11,Q_CLOSE_3_2}, {13,Q_CLOSE_3_1}, {14,Q_CLOSE_3_0},
+  /* the patterns below 16 are the mappings for green closure */
+  {1,Q_CLOSE_2_0}, {17,Q_CLOSE_2_0},
+  {2,Q_CLOSE_2_1}, {18,Q_CLOSE_2_1},
+  {3,Q_CLOSE_1_0}, {19,Q_CLOSE_1_0},
+  {4,Q_CLOSE_2_2}, {20,Q_CLOSE_2_2},
+  {6,Q_CLOSE_1_1}, {22,Q_CLOSE_1_1},
+  {8,Q_CLOSE_2_3}, {24,Q_CLOSE_2_3},
+  {9,Q_CLOSE_1_3}, {25,Q_CLOSE_1_3},
+  {12,Q_CLOSE_1_2}, {28,Q_CLOSE_1_2},
+  {15,Q_RED}, {31,Q_RED}
+};
+
+PATTERN_TABLE(triangleTable,triangleRules);
+PATTERN_TABLE(quadrilateralTable,quadrilateralRules);
+
+static_assert(triangleTable.size() == 8 && quadrilateralTable.size() == 32,
+              "2D pattern tables are expected to be dense");
+#endif
+
+#ifdef __THREEDIM__
+/* only the red rules of the 3D elements are reachable from a pattern,
+   tetrahedra with the full rule set use Pattern2Rule */
+#ifndef DUNE_UGGRID_TET_RULESET
+constexpr PatternRule tetrahedronRules[] = {
+  {0,0}, {63,TET_RED}, {1023,TET_RED_HEX}
+};
+#endif
+
+constexpr PatternRule pyramidRules[] = {
+  {0,0}, {511,PYR_RED}
+};
+
+constexpr PatternRule prismRules[] = {
+  {0,0}, {7679,PRI_RED}, {455,PRI_QUADSECT},
+  {56,PRI_BISECT_1_2}, {65,PRI_BISECT_0_1}, {130,PRI_BISECT_0_2},
+  {260,PRI_BISECT_0_3}, {325,PRI_BISECT_HEX0}, {195,PRI_BISECT_HEX1},
+  {390,PRI_BISECT_HEX2}
+};
+
+constexpr PatternRule hexahedronRules[] = {
+  {0,0}, {262143,HEXA_RED},
+  {1285,HEXA_BISECT_0_1}, {2570,HEXA_BISECT_0_2}, {240,HEXA_BISECT_0_3},
+  {139023,HEXA_QUADSECT_0}, {42485,HEXA_QUADSECT_1}, {84730,HEXA_QUADSECT_2},
+  {5,HEXA_TRISECT_0}, {1280,HEXA_TRISECT_5},
+  {2056,HEXA_BISECT_HEXPRI0}, {257,HEXA_BISECT_HEXPRI1}
+};
+
+#ifndef DUNE_UGGRID_TET_RULESET
+PATTERN_TABLE(tetrahedronTable,tetrahedronRules);
+#endif
+PATTERN_TABLE(pyramidTable,pyramidRules);
+PATTERN_TABLE(prismTable,prismRules);
+PATTERN_TABLE(hexahedronTable,hexahedronRules);
+#endif
+
+#undef PATTERN_TABLE
+
+} /* namespace */
+
+static INT NoRuleForPattern (const char *name, INT pattern)
+{
+  PrintErrorMessageF('E',"Patterns2Rules","no mapping for %s and pattern %d!",name,pattern);
+  return(-1);
+}
+
 /****************************************************************************/
 /** \brief Return mark of rule for a specific pattern
 
@@ -2457,71 +2590,27 @@ INT NS_DIM_PREFIX EstimateHere (const ELEMENT *theElement)
 
 INT NS_DIM_PREFIX Patterns2Rules(ELEMENT *theElement, INT pattern)
 {
+  INT rule;
+
         #ifdef __TWODIM__
   switch (TAG(theElement)) {
   case (TRIANGLE) :
-    switch (pattern) {
-    /** \todo 0 can mean T_COPY OR T_NOREF */
-    case (0) : return(T_NOREF);
-    case (1) : return(T_BISECT_1_0);
-    case (2) : return(T_BISECT_1_1);
-    case (3) : return(T_BISECT_2_T1_2);
-    case (4) : return(T_BISECT_1_2);
-    case (5) : return(T_BISECT_2_T1_1);
-    case (6) : return(T_BISECT_2_T1_0);
-    case (7) : return(T_RED);
-    default :
+    rule = LookupRule(triangleTable,pattern);
+    if (rule < 0)
+    {
       assert(0);
-      PrintErrorMessage('E',"Patterns2Rules","no mapping for TRIANGLE and this pattern!");
-      return(-1);
+      return(NoRuleForPattern("TRIANGLE",pattern));
     }
-    break;
-  case (QUADRILATERAL) :
-    switch (pattern) {
-    /** \todo 0 can mean Q_COPY OR Q_NOREF */
-    case (0) : return(Q_NOREF);
-    case (5) : return(Q_BLUE_0);
-    case (7) : return(Q_CLOSE_3_3);
-    case (10) : return(Q_BLUE_1);
-    case (11) : return(Q_CLOSE_3_2);
-    case (13) : return(Q_CLOSE_3_1);
-    case (14) : return(Q_CLOSE_3_0);
-
-    case (1) :                                    /* mapping for green closure */
-    case (17) : return(Q_CLOSE_2_0);
-
-    case (2) :                                    /* mapping for green closure */
-    case (18) : return(Q_CLOSE_2_1);
-
-    case (3) :                                    /* mapping for green closure */
-    case (19) : return(Q_CLOSE_1_0);
-
-    case (4) :                                    /* mapping for green closure */
-    case (20) : return(Q_CLOSE_2_2);
+    return(rule);
 
-    case (6) :                                    /* mapping for green closure */
-    case (22) : return(Q_CLOSE_1_1);
-
-    case (8) :                                    /* mapping for green closure */
-    case (24) : return(Q_CLOSE_2_3);
-
-    case (9) :                                    /* mapping for green closure */
-    case (25) : return(Q_CLOSE_1_3);
-
-    case (12) :                                    /* mapping for green closure */
-    case (28) : return(Q_CLOSE_1_2);
-
-    case (15) :                                    /* mapping for green closure */
-    case (31) : return(Q_RED);
-    default :
+  case (QUADRILATERAL) :
+    rule = LookupRule(quadrilateralTable,pattern);
+    if (rule < 0)
+    {
       assert(0);
-      PrintErrorMessage('E',"Patterns2Rules","no mapping for QUADRILATERAL and this pattern!");
-      return(-1);
+      return(NoRuleForPattern("QUADRILATERAL",pattern));
     }
-    break;
-  default :
-    PrintErrorMessage('E',"Patterns2Rules","Elementtype not found!");
-    assert(0); return(-1);
+    return(rule);
   }
         #endif
         #ifdef __THREEDIM__
@@ -2547,107 +2636,46 @@ INT NS_DIM_PREFIX Patterns2Rules(ELEMENT *theElement, INT pattern)
     return(Pattern2Rule[TAG(theElement)][pattern]);
 #else
     if (MARKCLASS(theElement) != RED_CLASS) return(0);
-    switch (pattern) {
-    /* copy rule */
-    case (0) :
-      return(0);
-    case (63) :
-      return(TET_RED);
-    case (1023) :
-      return(TET_RED_HEX);
-    default :
-      PrintErrorMessage('E',"Patterns2Rules","no mapping for TETRAHEDRON and this pattern!");
-      assert(0); return(-1);
+    rule = LookupRule(tetrahedronTable,pattern);
+    if (rule < 0)
+    {
+      assert(0);
+      return(NoRuleForPattern("TETRAHEDRON",pattern));
     }
-    break;
+    return(rule);
 #endif
 
   case (PYRAMID) :
     if (MARKCLASS(theElement) != RED_CLASS) return(0);
-    switch (pattern) {
-    /* copy rule */
-    case (0) :
-      return(0);
-    case (511) :
-      return(PYR_RED);
-    default :
-      PrintErrorMessage('E',"Patterns2Rules","no mapping for PYRAMID and this pattern!");
-      assert(0); return(-1);
+    rule = LookupRule(pyramidTable,pattern);
+    if (rule < 0)
+    {
+      assert(0);
+      return(NoRuleForPattern("PYRAMID",pattern));
     }
-    break;
+    return(rule);
 
   case (PRISM) :
     if (MARKCLASS(theElement) != RED_CLASS) return(0);
-    switch (pattern) {
-    /* copy rule */
-    case (0) :
-      return(0);
-    case (7679) :
-      return(PRI_RED);
-    case (455) :
-      return(PRI_QUADSECT);
-    case 56 :
-      return PRI_BISECT_1_2;
-    case 65 :
-      return PRI_BISECT_0_1;
-    case 130 :
-      return PRI_BISECT_0_2;
-    case 260 :
-      return PRI_BISECT_0_3;
-    case 325 :
-      return PRI_BISECT_HEX0;
-    case 195 :
-      return PRI_BISECT_HEX1;
-    case 390 :
-      return PRI_BISECT_HEX2;
-    default :
-      PrintErrorMessageF('E',"Patterns2Rules","no mapping for PRISM and pattern %d!", pattern);
+    rule = LookupRule(prismTable,pattern);
+    if (rule < 0)
+    {
                                                 #ifndef __ANISOTROPIC__
       assert(0);
                                                 #endif
-      return(-1);
+      return(NoRuleForPattern("PRISM",pattern));
     }
-    break;
+    return(rule);
 
   case (HEXAHEDRON) :
     if (MARKCLASS(theElement) != RED_CLASS) return(0);
-    switch (pattern) {
-    /* copy rule */
-    case (0) :
-      return(0);
-    /* full red rule */
-    case (262143) :
-      return(HEXA_RED);
-    case (1285) :
-      return HEXA_BISECT_0_1;
-    case (2570) :
-      return HEXA_BISECT_0_2;
-    case (240) :
-      return HEXA_BISECT_0_3;
-    case (139023) :
-      return HEXA_QUADSECT_0;
-    case (42485) :
-      return HEXA_QUADSECT_1;
-    case (84730) :
-      return HEXA_QUADSECT_2;
-    case (5) :
-      return HEXA_TRISECT_0;
-    case (1280) :
-      return HEXA_TRISECT_5;
-    case (2056) :
-      return HEXA_BISECT_HEXPRI0;
-    case (257) :
-      return HEXA_BISECT_HEXPRI1;
-    default :
-      PrintErrorMessage('E',"Patterns2Rules","no mapping for HEXAHEDRON and this pattern!");
-      UserWriteF("pattern=%d\n",pattern);
-      assert(0); return(-1);
+    rule = LookupRule(hexahedronTable,pattern);
+    if (rule < 0)
+    {
+      assert(0);
+      return(NoRuleForPattern("HEXAHEDRON",pattern));
     }
-    break;
-
-  default :
-    PrintErrorMessage('E',"Patterns2Rules","Elementtype not found!");
-    assert(0); return(-1);
+    return(rule);
   }
         #endif
   PrintErrorMessage('E',"Patterns2Rules","Elementtype not found!");
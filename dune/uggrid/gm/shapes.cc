@@ -30,6 +30,7 @@
 #include <cmath>
 #include <cassert>
 #include <cstddef>
+#include <vector>
 
 #include <dune/uggrid/low/architecture.h>
 #include <dune/uggrid/low/misc.h>
@@ -55,6 +56,9 @@ USING_UG_NAMESPACE
 #define SMALL_DIFF     1e-20
 #define MAX_ITER       20
 
+/* points handled together by UG_GlobalToLocalBatch, one per SIMD lane */
+#define BATCH_LANES    8
+
 /****************************************************************************/
 /*                                                                          */
 /* data structures used in this source file (exported data structures are   */
@@ -87,6 +91,28 @@ static DOUBLE_VECTOR_3D LMP_Prism               = {0.333333333333333333,
 static DOUBLE_VECTOR_3D LMP_Hexahedron          = {0.5, 0.5, 0.5};
 #endif
 
+/* corner coordinates of one lane of a block, indexed like the corner
+   pointer arrays the shapes.h macros expect: x[corner][component] */
+namespace {
+
+struct LaneCorners
+{
+  const DOUBLE (*x)[DIM][BATCH_LANES];
+  INT lane;
+
+  struct Corner
+  {
+    const DOUBLE (*x)[BATCH_LANES];
+    INT lane;
+
+    DOUBLE operator[] (INT d) const { return x[d][lane]; }
+  };
+
+  Corner operator[] (INT k) const { return {x[k],lane}; }
+};
+
+} /* namespace */
+
 /****************************************************************************/
 /*                                                                          */
 /* forward declarations of functions used before they are defined           */
@@ -185,6 +211,230 @@ INT NS_DIM_PREFIX UG_GlobalToLocal (INT n, const DOUBLE **Corners,
   return(1);
 }
 
+/* inverse of M without the early return of M_DIM_INVERT, det is 0 if singular */
+static inline void InvertLane (const DOUBLE_VECTOR M[DIM], DOUBLE_VECTOR IM[DIM], DOUBLE &det)
+{
+  DOUBLE invdet;
+
+#ifdef __TWODIM__
+  det = M[0][0]*M[1][1]-M[1][0]*M[0][1];
+  invdet = (std::abs(det)<SMALL_D*SMALL_D) ? 0.0 : 1.0/det;
+  IM[0][0] =  M[1][1]*invdet;
+  IM[1][0] = -M[1][0]*invdet;
+  IM[0][1] = -M[0][1]*invdet;
+  IM[1][1] =  M[0][0]*invdet;
+#else
+  det = M[0][0]*M[1][1]*M[2][2] + M[0][1]*M[1][2]*M[2][0] + M[0][2]*M[1][0]*M[2][1]
+        - M[0][2]*M[1][1]*M[2][0] - M[0][0]*M[1][2]*M[2][1] - M[0][1]*M[1][0]*M[2][2];
+  invdet = (std::abs(det)<SMALL_D*SMALL_D) ? 0.0 : 1.0/det;
+  IM[0][0] = ( M[1][1]*M[2][2] - M[1][2]*M[2][1]) * invdet;
+  IM[0][1] = (-M[0][1]*M[2][2] + M[0][2]*M[2][1]) * invdet;
+  IM[0][2] = ( M[0][1]*M[1][2] - M[0][2]*M[1][1]) * invdet;
+  IM[1][0] = (-M[1][0]*M[2][2] + M[1][2]*M[2][0]) * invdet;
+  IM[1][1] = ( M[0][0]*M[2][2] - M[0][2]*M[2][0]) * invdet;
+  IM[1][2] = (-M[0][0]*M[1][2] + M[0][2]*M[1][0]) * invdet;
+  IM[2][0] = ( M[1][0]*M[2][1] - M[1][1]*M[2][0]) * invdet;
+  IM[2][1] = (-M[0][0]*M[2][1] + M[0][1]*M[2][0]) * invdet;
+  IM[2][2] = ( M[0][0]*M[1][1] - M[0][1]*M[1][0]) * invdet;
+#endif
+  if (invdet == 0.0) det = 0.0;
+}
+
+/* Newton iteration for up to BATCH_LANES points in elements with N corners.
+   All lanes run the same instructions, lanes which converged or failed are
+   masked and the block stops as soon as no lane is active. */
+template<INT N>
+static INT GlobalToLocalBlock (INT m, const DOUBLE *const *Corners, const DOUBLE *EvalPoints,
+                               DOUBLE *LocalCoords, INT *Converged)
+{
+  DOUBLE x[N][DIM][BATCH_LANES];
+  DOUBLE p[DIM][BATCH_LANES],xi[DIM][BATCH_LANES];
+  INT active[BATCH_LANES],converged[BATCH_LANES];
+  INT i,k,d,l,nActive,failed;
+
+  /* gather to structure of arrays, unused lanes repeat lane 0 */
+  for (l=0; l<BATCH_LANES; l++)
+  {
+    const INT q = (l<m) ? l : 0;
+    for (k=0; k<N; k++)
+      for (d=0; d<DIM; d++)
+        x[k][d][l] = Corners[q*N+k][d];
+    for (d=0; d<DIM; d++)
+    {
+      p[d][l] = EvalPoints[q*DIM+d];
+      xi[d][l] = 0.0;
+    }
+    active[l] = (l<m);
+    converged[l] = 0;
+  }
+
+  for (i=0; i<=MAX_ITER; i++)
+  {
+    nActive = 0;
+    for (l=0; l<BATCH_LANES; l++)
+    {
+      const LaneCorners xl = {x,l};
+      DOUBLE_VECTOR local,global,diff,step,M[DIM],IM[DIM];
+      DOUBLE s,det;
+
+      for (d=0; d<DIM; d++) local[d] = xi[d][l];
+      LOCAL_TO_GLOBAL(N,xl,local,global);
+      for (d=0; d<DIM; d++) diff[d] = global[d] - p[d][l];
+      TRANSFORMATION(N,xl,local,M);
+      InvertLane(M,IM,det);
+      V_DIM_EUKLIDNORM(diff,s);
+
+      /* N == DIM+1 is affine: the first step is exact */
+      const INT done = (i>0) && (N == DIM+1 || s*s <= SMALL_DIFF*std::abs(det));
+      const INT stop = done || det == 0.0;
+      converged[l] = active[l] ? done : converged[l];
+      active[l] = active[l] && !stop;
+
+      MT_TIMES_V_DIM(IM,diff,step);
+      for (d=0; d<DIM; d++)
+        xi[d][l] = active[l] ? local[d]-step[d] : local[d];
+      nActive += active[l];
+    }
+    if (nActive == 0) break;
+  }
+
+  failed = 0;
+  for (l=0; l<m; l++)
+  {
+    for (d=0; d<DIM; d++)
+      LocalCoords[l*DIM+d] = xi[d][l];
+    Converged[l] = converged[l];
+    failed += !converged[l];
+  }
+
+  return (failed);
+}
+
+/****************************************************************************/
+/** \brief Transform many global points to local coordinates
+
+   \param n - number of corners, the same for all points
+   \param nPoints - number of points
+   \param Corners - Corners[p*n+k] is corner k of the element of point p
+   \param EvalPoints - global coordinates, DIM per point
+   \param LocalCoords - returns the local coordinates, DIM per point
+   \param Converged - returns 1 for each point if the iteration converged, else 0
+
+   This function does the same as UG_GlobalToLocal for many points. The points
+   are handled in blocks of BATCH_LANES, and the Newton iterations of a block run
+   in lockstep on structure of arrays data, so that the compiler can map the
+   points to SIMD lanes. A lane which converged stops updating, the block stops
+   once all its lanes are done. Simplices take exactly one step.
+
+   \return <ul>
+   <li>   number of points which did not converge </li>
+   <li>   -1 for an unknown number of corners </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX UG_GlobalToLocalBatch (INT n, INT nPoints, const DOUBLE *const *Corners,
+                                         const DOUBLE *EvalPoints, DOUBLE *LocalCoords, INT *Converged)
+{
+  INT (*block)(INT, const DOUBLE *const *, const DOUBLE *, DOUBLE *, INT *);
+  INT b,m,failed;
+
+  switch (n)
+  {
+#ifdef __TWODIM__
+  case 3 : block = GlobalToLocalBlock<3>; break;
+  case 4 : block = GlobalToLocalBlock<4>; break;
+#endif
+#ifdef __THREEDIM__
+  case 4 : block = GlobalToLocalBlock<4>; break;
+  case 5 : block = GlobalToLocalBlock<5>; break;
+  case 6 : block = GlobalToLocalBlock<6>; break;
+  case 8 : block = GlobalToLocalBlock<8>; break;
+#endif
+  default : return (-1);
+  }
+
+  failed = 0;
+  for (b=0; b<nPoints; b+=BATCH_LANES)
+  {
+    m = MIN(BATCH_LANES,nPoints-b);
+    failed += block(m,Corners+b*n,EvalPoints+b*DIM,LocalCoords+b*DIM,Converged+b);
+  }
+
+  return (failed);
+}
+
+/****************************************************************************/
+/** \brief Transform global points in given elements to local coordinates
+
+   \param nPoints - number of points
+   \param Elements - element of each point
+   \param EvalPoints - global coordinates, DIM per point
+   \param LocalCoords - returns the local coordinates, DIM per point
+   \param Converged - returns 1 for each point if the iteration converged, else 0
+
+   The points are grouped by element tag and each group is transformed by
+   UG_GlobalToLocalBatch. The results are in the order of the input.
+
+   \return <ul>
+   <li>   number of points which did not converge </li>
+   </ul>
+ */
+/****************************************************************************/
+
+INT NS_DIM_PREFIX ElementsGlobalToLocal (INT nPoints, const ELEMENT *const *Elements,
+                                         const DOUBLE *EvalPoints, DOUBLE *LocalCoords, INT *Converged)
+{
+  INT start[TAGS+1];
+  INT i,j,k,d,tag,n,failed;
+
+  /* counting sort of the points by tag */
+  for (tag=0; tag<=TAGS; tag++) start[tag] = 0;
+  for (i=0; i<nPoints; i++) start[TAG(Elements[i])+1]++;
+  for (tag=0; tag<TAGS; tag++) start[tag+1] += start[tag];
+
+  std::vector<INT> order(nPoints);
+  {
+    INT next[TAGS];
+    for (tag=0; tag<TAGS; tag++) next[tag] = start[tag];
+    for (i=0; i<nPoints; i++) order[next[TAG(Elements[i])]++] = i;
+  }
+
+  std::vector<const DOUBLE*> corners(nPoints*MAX_CORNERS_OF_ELEM);
+  std::vector<DOUBLE> global(nPoints*DIM),local(nPoints*DIM);
+  std::vector<INT> converged(nPoints);
+
+  failed = 0;
+  for (tag=0; tag<TAGS; tag++)
+  {
+    const INT first = start[tag];
+    const INT count = start[tag+1]-first;
+    if (count == 0) continue;
+
+    n = CORNERS_OF_ELEM(Elements[order[first]]);
+    for (j=0; j<count; j++)
+    {
+      const ELEMENT *theElement = Elements[order[first+j]];
+      for (k=0; k<n; k++)
+        corners[j*n+k] = CVECT(MYVERTEX(CORNER(theElement,k)));
+      for (d=0; d<DIM; d++)
+        global[j*DIM+d] = EvalPoints[order[first+j]*DIM+d];
+    }
+
+    failed += UG_GlobalToLocalBatch(n,count,corners.data(),global.data(),local.data(),converged.data());
+
+    for (j=0; j<count; j++)
+    {
+      i = order[first+j];
+      for (d=0; d<DIM; d++)
+        LocalCoords[i*DIM+d] = local[j*DIM+d];
+      Converged[i] = converged[j];
+    }
+  }
+
+  return (failed);
+}
+
 /****************************************************************************/
 /** \brief Calculate inner normals of tetrahedra
 
@@ -478,6 +478,10 @@ START_UGDIM_NAMESPACE
 
 DOUBLE  *LMP                  (INT n);
 INT      UG_GlobalToLocal     (INT n, const DOUBLE **Corners, const DOUBLE *EvalPoint, DOUBLE *LocalCoord);
+INT      UG_GlobalToLocalBatch (INT n, INT nPoints, const DOUBLE *const *Corners, const DOUBLE *EvalPoints,
+                                DOUBLE *LocalCoords, INT *Converged);
+INT      ElementsGlobalToLocal (INT nPoints, const ELEMENT *const *Elements, const DOUBLE *EvalPoints,
+                                DOUBLE *LocalCoords, INT *Converged);
 
 #ifdef __THREEDIM__
 DOUBLE  N                   (const INT i, const DOUBLE *LocalCoord);
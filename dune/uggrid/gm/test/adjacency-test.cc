@@ -0,0 +1,146 @@
+#include "config.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+
+#include "../adjacency.h"
+#include "../gm.h"
+#include "../refine.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+/* compare the cached adjacency of a level with the element and link lists */
+static void CheckAdjacency (TestSuite &test, const std::string &name, GRID *theGrid)
+{
+  const NodeAdjacency *adj = GetNodeAdjacency(theGrid);
+  test.require(adj!=NULL) << name << ": GetNodeAdjacency failed";
+  if (adj==NULL)
+    return;
+
+  test.check(adj->revision == MG_TOPOLOGY_REVISION(MYMG(theGrid)))
+    << name << ": the adjacency is not up to date";
+
+  std::vector<NODE *> nodes;
+  for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+    nodes.push_back(theNode);
+  test.check(adj->node == nodes) << name << ": the rows differ from the node list";
+  if (adj->node != nodes)
+    return;
+
+  for (INT i=0; i<(INT)nodes.size(); i++)
+  {
+    std::vector<ELEMENT *> elements, cached;
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+      for (INT k=0; k<CORNERS_OF_ELEM(theElement); k++)
+        if (CORNER(theElement,k)==nodes[i])
+          elements.push_back(theElement);
+    for (ELEMENT *theElement : NodeElements(*adj,i))
+      cached.push_back(theElement);
+    test.check(elements == cached) << name << ": elements of row " << i << " differ";
+
+    std::vector<NODE *> neighbors, cachedNeighbors;
+    for (LINK *theLink=START(nodes[i]); theLink!=NULL; theLink=NEXT(theLink))
+      neighbors.push_back(NBNODE(theLink));
+    for (NODE *theNode : NodeNeighbors(*adj,i))
+      cachedNeighbors.push_back(theNode);
+    test.check(neighbors == cachedNeighbors) << name << ": neighbors of row " << i << " differ";
+
+    test.check(NodeAdjacencyRow(*adj,nodes[i]) == i) << name << ": wrong row of node " << i;
+  }
+}
+
+static void MarkTopLevel (MULTIGRID *theMG, enum RefinementRule rule)
+{
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    MarkForRefinement(theElement,rule,0);
+}
+
+/* query the adjacency between topology changes, each query has to see the
+   current grid */
+static TestSuite TestInvalidation (bool simplices)
+{
+  TestSuite test;
+  const std::string name = simplices ? "simplexAdjacency" : "cubeAdjacency";
+
+  MULTIGRID *theMG = CreateTestCoarseGrid(name,3,simplices);
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+  GRID *theGrid = GRID_ON_LEVEL(theMG,0);
+
+  CheckAdjacency(test,name + " coarse grid",theGrid);
+
+  /* delete an inner element and insert it again */
+  ELEMENT *theElement = FIRSTELEMENT(theGrid);
+  while (OBJT(theElement)==BEOBJ)
+    theElement = SUCCE(theElement);
+  const INT n = CORNERS_OF_ELEM(theElement);
+  NODE *corners[MAX_CORNERS_OF_ELEM];
+  for (INT k=0; k<n; k++)
+    corners[k] = CORNER(theElement,k);
+  test.require(DeleteElement(theMG,theElement)==GM_OK) << name << ": DeleteElement failed";
+  CheckAdjacency(test,name + " after DeleteElement",theGrid);
+  theElement = InsertElement(theGrid,n,corners,NULL,NULL,NULL);
+  test.require(theElement!=NULL) << name << ": InsertElement failed";
+  CheckAdjacency(test,name + " after InsertElement",theGrid);
+  for (INT i=0; i<SIDES_OF_ELEM(theElement); i++)
+    test.check(NBELEM(theElement,i)!=NULL)
+      << name << ": side " << i << " of the reinserted element has no neighbor";
+
+  /* a node without elements */
+  DOUBLE pos[DIM];
+  for (INT d=0; d<DIM; d++)
+    pos[d] = 0.3;
+  NODE *theNode = InsertInnerNode(theGrid,pos);
+  test.require(theNode!=NULL) << name << ": InsertInnerNode failed";
+  CheckAdjacency(test,name + " after InsertInnerNode",theGrid);
+  test.require(DeleteNode(theGrid,theNode)==GM_OK) << name << ": DeleteNode failed";
+  CheckAdjacency(test,name + " after DeleteNode",theGrid);
+
+  /* InsertElement only finds the neighbors before the coarse grid is fixed */
+  test.require(FixCoarseGrid(theMG)==GM_OK) << name << ": FixCoarseGrid failed";
+  CheckAdjacency(test,name + " after FixCoarseGrid",theGrid);
+
+  /* new levels, and a level disposed and created again */
+  const enum RefinementRule rules[] = {RED, RED, COARSE, COARSE, RED};
+  for (enum RefinementRule rule : rules)
+  {
+    MarkTopLevel(theMG,rule);
+    test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid failed";
+    for (INT level=0; level<=TOPLEVEL(theMG); level++)
+      CheckAdjacency(test,name + " level " + std::to_string(level) + " after AdaptMultiGrid",
+                     GRID_ON_LEVEL(theMG,level));
+  }
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (bool simplices : {false, true})
+    test.subTest(TestInvalidation(simplices));
+
+  ExitUg();
+
+  return test.exit();
+}
@@ -0,0 +1,144 @@
+#include "config.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+
+#include "../geomcache.h"
+#include "../gm.h"
+#include "../refine.h"
+#include "../shapes.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+static const DOUBLE TOLERANCE = 1e-10;
+
+static void MarkTopLevel (MULTIGRID *theMG, enum RefinementRule rule, INT every)
+{
+  INT k = 0;
+
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    if ((k++)%every==0)
+      MarkForRefinement(theElement,rule,0);
+}
+
+/* compare the cached transformations of all elements with UG_GlobalToLocal
+   and check that the cache only holds elements of the multigrid */
+static void CheckCache (TestSuite &test, const std::string &name, MULTIGRID *theMG, std::mt19937 &random)
+{
+  std::uniform_real_distribution<DOUBLE> unit(0.0,1.0);
+  std::unordered_set<const ELEMENT *> elements;
+
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (ELEMENT *theElement=PFIRSTELEMENT(GRID_ON_LEVEL(theMG,level)); theElement!=NULL; theElement=SUCCE(theElement))
+    {
+      const INT n = CORNERS_OF_ELEM(theElement);
+      const DOUBLE *cornerList[MAX_CORNERS_OF_ELEM];
+      DOUBLE_VECTOR ref,x,local,cachedLocal,global;
+      DOUBLE weight[MAX_CORNERS_OF_ELEM],sum = 0.0;
+
+      elements.insert(theElement);
+      for (INT k=0; k<n; k++)
+      {
+        cornerList[k] = CVECT(MYVERTEX(CORNER(theElement,k)));
+        sum += (weight[k] = unit(random));
+      }
+      V_DIM_CLEAR(ref);
+      for (INT k=0; k<n; k++)
+        V_DIM_LINCOMB(1.0,ref,weight[k]/sum,LOCAL_COORD_OF_ELEM(theElement,k),ref);
+      LOCAL_TO_GLOBAL(n,cornerList,ref,x);
+
+      test.check(UG_GlobalToLocal(n,cornerList,x,local)==0)
+        << name << ": UG_GlobalToLocal did not converge in element " << ID(theElement);
+      test.check(ElementGlobalToLocal(theMG,theElement,x,cachedLocal)==0)
+        << name << ": ElementGlobalToLocal failed in element " << ID(theElement);
+      ElementLocalToGlobal(theMG,theElement,cachedLocal,global);
+      for (INT d=0; d<DIM; d++)
+      {
+        test.check(std::abs(local[d]-cachedLocal[d]) < TOLERANCE)
+          << name << ": local coordinate " << d << " of element " << ID(theElement)
+          << " differs from UG_GlobalToLocal";
+        test.check(std::abs(global[d]-x[d]) < TOLERANCE)
+          << name << ": ElementLocalToGlobal of element " << ID(theElement) << " differs";
+      }
+      test.check(std::abs(ElementVolumeCached(theMG,theElement)-ElementVolume(theElement)) < TOLERANCE)
+        << name << ": volume of element " << ID(theElement) << " differs from ElementVolume";
+      test.check(PointInElementCached(theMG,x,theElement))
+        << name << ": point not found in element " << ID(theElement);
+    }
+
+  for (const auto &entry : theMG->geometryCache->entry)
+    test.check(elements.count(entry.first)==1)
+      << name << ": the cache holds an element which was disposed";
+}
+
+/* the cache is used across renumbering, coarsening and refinement, which
+   reassign the IDs and reuse the memory of the elements */
+static TestSuite TestGeometryCache ()
+{
+  TestSuite test;
+  const std::string name = "geometryCache";
+  std::mt19937 random(5);
+
+  MULTIGRID *theMG = CreateTestGrid(name,2,true);
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+  test.require(EnableGeometryCache(theMG)==GM_OK) << name << ": EnableGeometryCache failed";
+
+  MarkTopLevel(theMG,RED,1);
+  test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+    << name << ": AdaptMultiGrid failed";
+  MarkTopLevel(theMG,RED,3);
+  test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+    << name << ": AdaptMultiGrid failed";
+  CheckCache(test,name + " after refinement",theMG,random);
+
+  /* saving renumbers the objects */
+  const std::string fileName = name + "-test";
+  test.check(SaveMultiGrid(theMG,fileName.c_str(),"asc","",0,0)==0)
+    << name << ": SaveMultiGrid failed";
+  std::remove((fileName + ".ug.mg.asc").c_str());
+  CheckCache(test,name + " after saving",theMG,random);
+
+  MarkTopLevel(theMG,COARSE,1);
+  test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+    << name << ": AdaptMultiGrid failed";
+  CheckCache(test,name + " after coarsening",theMG,random);
+
+  MarkTopLevel(theMG,RED,2);
+  test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+    << name << ": AdaptMultiGrid failed";
+  CheckCache(test,name + " after refining again",theMG,random);
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  test.subTest(TestGeometryCache());
+
+  ExitUg();
+
+  return test.exit();
+}
@@ -0,0 +1,245 @@
+#include "config.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+
+#include "../gm.h"
+#include "../refine.h"
+#include "../shapes.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+static const DOUBLE TOLERANCE = 1e-10;
+
+#ifdef __TWODIM__
+static const INT testTags[] = {TRIANGLE, QUADRILATERAL};
+#else
+static const INT testTags[] = {TETRAHEDRON, PYRAMID, PRISM, HEXAHEDRON};
+#endif
+
+/* shapes of the elements, applied to the corners of the reference element */
+enum Shape {AFFINE, DISTORTED, COLLAPSED_EDGE, FLAT};
+
+static const char *ShapeName (Shape shape)
+{
+  switch (shape)
+  {
+  case AFFINE :         return "affine";
+  case DISTORTED :      return "distorted";
+  case COLLAPSED_EDGE : return "collapsed edge";
+  case FLAT :           return "flat";
+  }
+  return "";
+}
+
+/* compare one batch transformation of the points with UG_GlobalToLocal */
+static void CompareWithGlobalToLocal (TestSuite &test, const std::string &name, INT n, INT nPoints,
+                                      const std::vector<const DOUBLE *> &corners,
+                                      const std::vector<DOUBLE> &global,
+                                      const std::vector<DOUBLE> &batchLocal,
+                                      const std::vector<INT> &converged)
+{
+  for (INT p=0; p<nPoints; p++)
+  {
+    DOUBLE local[DIM];
+    const DOUBLE **pointCorners = const_cast<const DOUBLE **>(&corners[p*n]);
+    const bool scalarConverged = (UG_GlobalToLocal(n,pointCorners,&global[p*DIM],local)==0);
+
+    test.check(scalarConverged == (converged[p]==1))
+      << name << ": convergence of point " << p << " differs from UG_GlobalToLocal";
+    if (!scalarConverged || converged[p]!=1)
+      continue;
+    for (INT d=0; d<DIM; d++)
+      test.check(std::abs(local[d]-batchLocal[p*DIM+d]) < TOLERANCE)
+        << name << ": local coordinate " << d << " of point " << p
+        << " differs from UG_GlobalToLocal";
+  }
+}
+
+/* UG_GlobalToLocalBatch on points in one element of each type and shape */
+static TestSuite TestBatch (INT tag, Shape shape)
+{
+  TestSuite test;
+  const INT n = CORNERS_OF_TAG(tag);
+  const std::string name = std::to_string(n) + " corners, " + ShapeName(shape);
+  std::mt19937 random(17*tag+(INT)shape);
+  std::uniform_real_distribution<DOUBLE> unit(0.0,1.0);
+
+  /* corners: a rotated and scaled reference element, changed by shape */
+  DOUBLE_VECTOR x[MAX_CORNERS_OF_ELEM];
+  for (INT k=0; k<n; k++)
+  {
+    const DOUBLE *ref = LOCAL_COORD_OF_TAG(tag,k);
+#ifdef __TWODIM__
+    x[k][0] = 1.0 + 2.0*ref[0] + 0.5*ref[1];
+    x[k][1] = -1.0 - 0.3*ref[0] + 1.5*ref[1];
+#else
+    x[k][0] = 1.0 + 2.0*ref[0] + 0.5*ref[1] + 0.1*ref[2];
+    x[k][1] = -1.0 - 0.3*ref[0] + 1.5*ref[1] + 0.2*ref[2];
+    x[k][2] = 0.5 + 0.1*ref[0] - 0.2*ref[1] + 0.8*ref[2];
+#endif
+  }
+  switch (shape)
+  {
+  case AFFINE :
+    break;
+  case DISTORTED :
+    /* not affine for elements with more than DIM+1 corners */
+    for (INT d=0; d<DIM; d++)
+      x[n-1][d] += 0.2*(d+1);
+    break;
+  case COLLAPSED_EDGE :
+    /* the last two corners share an edge in all types, away from the
+       start of the iteration at local coordinate 0 */
+    V_DIM_COPY(x[n-2],x[n-1]);
+    break;
+  case FLAT :
+    for (INT k=0; k<n; k++)
+      x[k][DIM-1] = 0.0;
+    break;
+  }
+
+  /* points: random convex combinations of the corners of the reference element */
+  const INT nPoints = 37;
+  std::vector<const DOUBLE *> corners(nPoints*n);
+  std::vector<DOUBLE> global(nPoints*DIM),local(nPoints*DIM);
+  std::vector<INT> converged(nPoints);
+  const DOUBLE *cornerList[MAX_CORNERS_OF_ELEM];
+
+  for (INT k=0; k<n; k++)
+    cornerList[k] = x[k];
+  for (INT p=0; p<nPoints; p++)
+  {
+    DOUBLE_VECTOR ref;
+    DOUBLE sum = 0.0;
+
+    V_DIM_CLEAR(ref);
+    std::vector<DOUBLE> weight(n);
+    for (INT k=0; k<n; k++)
+      sum += (weight[k] = unit(random));
+    for (INT k=0; k<n; k++)
+      V_DIM_LINCOMB(1.0,ref,weight[k]/sum,LOCAL_COORD_OF_TAG(tag,k),ref);
+    LOCAL_TO_GLOBAL(n,cornerList,ref,&global[p*DIM]);
+    for (INT k=0; k<n; k++)
+      corners[p*n+k] = x[k];
+  }
+
+  const INT failed = UG_GlobalToLocalBatch(n,nPoints,corners.data(),global.data(),
+                                           local.data(),converged.data());
+  INT notConverged = 0;
+  for (INT p=0; p<nPoints; p++)
+    notConverged += (converged[p]!=1);
+  test.check(failed == notConverged)
+    << name << ": UG_GlobalToLocalBatch returned " << failed << " for "
+    << notConverged << " points which did not converge";
+  if (shape==AFFINE || shape==DISTORTED)
+    test.check(failed == 0) << name << ": UG_GlobalToLocalBatch did not converge";
+  if (shape==FLAT)
+    test.check(failed == nPoints) << name << ": UG_GlobalToLocalBatch converged in a flat element";
+
+  CompareWithGlobalToLocal(test,name,n,nPoints,corners,global,local,converged);
+
+  return test;
+}
+
+/* ElementsGlobalToLocal on the elements of a grid with the element types
+   created by the closure */
+static TestSuite TestElements (bool simplices)
+{
+  TestSuite test;
+  const std::string name = simplices ? "simplexElements" : "cubeElements";
+  std::mt19937 random(simplices);
+  std::uniform_real_distribution<DOUBLE> unit(0.0,1.0);
+
+  MULTIGRID *theMG = CreateTestGrid(name,2,simplices);
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+
+  /* refine one element, its neighbors get closure elements */
+  MarkForRefinement(FIRSTELEMENT(GRID_ON_LEVEL(theMG,0)),RED,0);
+  test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+    << name << ": AdaptMultiGrid failed";
+
+  /* points in all elements on all levels, mixing the tags */
+  std::vector<const ELEMENT *> elements;
+  std::vector<DOUBLE> global;
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,level)); theElement!=NULL; theElement=SUCCE(theElement))
+      for (INT p=0; p<3; p++)
+      {
+        const INT n = CORNERS_OF_ELEM(theElement);
+        const DOUBLE *cornerList[MAX_CORNERS_OF_ELEM];
+        DOUBLE_VECTOR ref,x;
+        DOUBLE weight[MAX_CORNERS_OF_ELEM],sum = 0.0;
+
+        for (INT k=0; k<n; k++)
+        {
+          cornerList[k] = CVECT(MYVERTEX(CORNER(theElement,k)));
+          sum += (weight[k] = unit(random));
+        }
+        V_DIM_CLEAR(ref);
+        for (INT k=0; k<n; k++)
+          V_DIM_LINCOMB(1.0,ref,weight[k]/sum,LOCAL_COORD_OF_ELEM(theElement,k),ref);
+        LOCAL_TO_GLOBAL(n,cornerList,ref,x);
+        elements.push_back(theElement);
+        for (INT d=0; d<DIM; d++)
+          global.push_back(x[d]);
+      }
+
+  const INT nPoints = elements.size();
+  std::vector<DOUBLE> local(nPoints*DIM);
+  std::vector<INT> converged(nPoints);
+  test.check(ElementsGlobalToLocal(nPoints,elements.data(),global.data(),local.data(),converged.data())==0)
+    << name << ": ElementsGlobalToLocal did not converge";
+
+  for (INT p=0; p<nPoints; p++)
+  {
+    const ELEMENT *theElement = elements[p];
+    const INT n = CORNERS_OF_ELEM(theElement);
+    std::vector<const DOUBLE *> corners(n);
+    std::vector<DOUBLE> point(&global[p*DIM],&global[p*DIM]+DIM);
+    std::vector<DOUBLE> pointLocal(&local[p*DIM],&local[p*DIM]+DIM);
+    std::vector<INT> pointConverged(1,converged[p]);
+
+    for (INT k=0; k<n; k++)
+      corners[k] = CVECT(MYVERTEX(CORNER(theElement,k)));
+    CompareWithGlobalToLocal(test,name + " tag " + std::to_string(TAG(theElement)),
+                             n,1,corners,point,pointLocal,pointConverged);
+  }
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (INT tag : testTags)
+    for (Shape shape : {AFFINE, DISTORTED, COLLAPSED_EDGE, FLAT})
+      test.subTest(TestBatch(tag,shape));
+
+  for (bool simplices : {false, true})
+    test.subTest(TestElements(simplices));
+
+  ExitUg();
+
+  return test.exit();
+}
@@ -0,0 +1,208 @@
+#include "config.h"
+
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+#ifdef ModelP
+#include <dune/uggrid/parallel/dddif/parallel.h>
+#endif
+
+#include "../gm.h"
+#include "../indexsets.h"
+#include "../refine.h"
+#include "../rm.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+/* check that the objects hold exactly the indices in use of a pool, and
+   that they are 0..n-1 if the pool is compact */
+static void CheckPool (TestSuite &test, const std::string &name, const IndexPool &pool,
+                       const std::vector<std::pair<void *, INT> > &objects)
+{
+  test.check((INT)objects.size() == pool.used())
+    << name << ": " << objects.size() << " objects for " << pool.used() << " indices";
+
+  std::vector<bool> taken(pool.size(),false);
+  for (const auto &object : objects)
+  {
+    const INT i = object.second;
+    test.check(i >= 0 && i < pool.size()) << name << ": index " << i << " out of range";
+    if (i < 0 || i >= pool.size())
+      continue;
+    test.check(!taken[i]) << name << ": index " << i << " is used twice";
+    test.check(pool.object[i] == object.first) << name << ": index " << i << " belongs to another object";
+    taken[i] = true;
+  }
+  if (pool.compact())
+    test.check(pool.size() == (INT)objects.size()) << name << ": compact pool with holes";
+}
+
+static int VertexLeafIndex (VERTEX *theVertex)
+{
+  return (OBJT(theVertex) == BVOBJ) ? theVertex->bv.leafIndex : theVertex->iv.leafIndex;
+}
+
+/* compare all maintained indices with the objects of the multigrid */
+static void CheckIndices (TestSuite &test, const std::string &name, MULTIGRID *theMG)
+{
+  const MultiGridIndexSets &sets = *theMG->indexSets;
+  std::vector<std::pair<void *, INT> > leafElements[TAGS], leafVertices;
+
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+  {
+    GRID *theGrid = GRID_ON_LEVEL(theMG,level);
+    const LevelIndexPools &pools = sets.level[level];
+    const std::string levelName = name + " level " + std::to_string(level);
+    std::vector<std::pair<void *, INT> > elements[TAGS], nodes, edges;
+
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+    {
+      elements[TAG(theElement)].emplace_back(theElement,theElement->ge.levelIndex);
+      if (LEAFELEM(theElement))
+        leafElements[TAG(theElement)].emplace_back(theElement,theElement->ge.leafIndex);
+      else
+        test.check(theElement->ge.leafIndex == -1) << levelName << ": refined element with a leaf index";
+    }
+    for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+    {
+      nodes.emplace_back(theNode,theNode->levelIndex);
+      for (LINK *theLink=START(theNode); theLink!=NULL; theLink=NEXT(theLink))
+        if (LINK0(MYEDGE(theLink)) == theLink)
+          edges.emplace_back(MYEDGE(theLink),MYEDGE(theLink)->levelIndex);
+    }
+    for (VERTEX *theVertex=PFIRSTVERTEX(theGrid); theVertex!=NULL; theVertex=SUCCV(theVertex))
+      leafVertices.emplace_back(theVertex,VertexLeafIndex(theVertex));
+
+    for (INT tag=0; tag<TAGS; tag++)
+      CheckPool(test,levelName + " elements of tag " + std::to_string(tag),pools.element[tag],elements[tag]);
+    CheckPool(test,levelName + " nodes",pools.node,nodes);
+    CheckPool(test,levelName + " edges",pools.edge,edges);
+  }
+
+  for (INT tag=0; tag<TAGS; tag++)
+    CheckPool(test,name + " leaf elements of tag " + std::to_string(tag),sets.leafElement[tag],leafElements[tag]);
+  CheckPool(test,name + " leaf vertices",sets.leafVertex,leafVertices);
+}
+
+/* the permutation of a compaction must map the old index of each object to
+   its new one */
+static void CheckCompaction (TestSuite &test, const std::string &name, MULTIGRID *theMG)
+{
+  std::vector<INT> oldLeaf;
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (VERTEX *theVertex=PFIRSTVERTEX(GRID_ON_LEVEL(theMG,level)); theVertex!=NULL; theVertex=SUCCV(theVertex))
+      oldLeaf.push_back(VertexLeafIndex(theVertex));
+
+  IndexPermutation perm;
+  test.check(CompactLeafIndices(theMG,&perm)==GM_OK) << name << ": CompactLeafIndices failed";
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    test.check(CompactLevelIndices(GRID_ON_LEVEL(theMG,level),NULL)==GM_OK)
+      << name << ": CompactLevelIndices failed";
+
+  std::size_t k = 0;
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (VERTEX *theVertex=PFIRSTVERTEX(GRID_ON_LEVEL(theMG,level)); theVertex!=NULL; theVertex=SUCCV(theVertex), k++)
+      test.check(perm.vertex[oldLeaf[k]] == VertexLeafIndex(theVertex))
+        << name << ": wrong permutation of the leaf vertex index " << oldLeaf[k];
+
+  CheckIndices(test,name + " after compaction",theMG);
+}
+
+static void MarkTopLevel (MULTIGRID *theMG, enum RefinementRule rule, INT every)
+{
+  INT k = 0;
+
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    if ((k++)%every==0)
+      MarkForRefinement(theElement,rule,0);
+}
+
+#ifdef ModelP
+/* move each coarse grid element with its sons to the next proc, DDD then
+   creates, upgrades and deletes copies of refined and leaf elements */
+static INT RotatePartitions (MULTIGRID *theMG)
+{
+  const INT to = (theMG->ppifContext().me()+1) % theMG->ppifContext().procs();
+
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,0));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    PARTITION(theElement) = to;
+
+  return TransferGridFromLevel(theMG,0);
+}
+#endif
+
+/* refine and coarsen with index sets enabled and check all indices after
+   each step, compacting them every other step. In parallel the grid is
+   distributed before and moved after each step */
+static TestSuite TestIndexSets (bool simplices)
+{
+  TestSuite test;
+  const std::string name = simplices ? "simplexIndexSets" : "cubeIndexSets";
+
+  MULTIGRID *theMG = CreateTestGrid(name,2,simplices);
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+  test.require(EnableIndexSets(theMG)==GM_OK) << name << ": EnableIndexSets failed";
+  CheckIndices(test,name + " coarse grid",theMG);
+
+#ifdef ModelP
+  BalanceGridRCB(theMG,0);
+  test.require(TransferGridFromLevel(theMG,0)==0) << name << ": TransferGridFromLevel failed";
+  CheckIndices(test,name + " distributed",theMG);
+#endif
+
+  struct Step { enum RefinementRule rule; INT every; };
+  const Step steps[] = {{RED,1},{RED,3},{COARSE,2},{RED,2},{COARSE,1},{COARSE,1}};
+
+  INT k = 0;
+  for (const Step &step : steps)
+  {
+    MarkTopLevel(theMG,step.rule,step.every);
+    test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid failed";
+
+    const std::string stepName = name + " step " + std::to_string(k);
+    CheckIndices(test,stepName,theMG);
+    if ((k++)%2==1)
+      CheckCompaction(test,stepName,theMG);
+
+#ifdef ModelP
+    if (theMG->ppifContext().procs() > 1)
+    {
+      test.require(RotatePartitions(theMG)==0) << stepName << ": TransferGridFromLevel failed";
+      CheckIndices(test,stepName + " moved",theMG);
+    }
+#endif
+  }
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (bool simplices : {false, true})
+    test.subTest(TestIndexSets(simplices));
+
+  ExitUg();
+
+  return test.exit();
+}
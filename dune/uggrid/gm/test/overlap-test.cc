@@ -0,0 +1,123 @@
+#include "config.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+#include <dune/uggrid/parallel/dddif/parallel.h>
+
+#include "../gm.h"
+#include "../pargm.h"
+#include "../refine.h"
+#include "../rm.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+/* every horizontal ghost of a level must lie in one of the first depth
+   layers around the local masters, and some proc must have all of them */
+static void CheckOverlapWidth (TestSuite &test, const std::string &name, MULTIGRID *theMG, INT depth)
+{
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+  {
+    GRID *theGrid = GRID_ON_LEVEL(theMG,level);
+    const std::string levelName = name + " level " + std::to_string(level);
+    std::vector<std::vector<ELEMENT *> > layers;
+    INT ghosts = 0, reached = 0;
+
+    test.check(GridOverlapLayers(theGrid,layers)==0) << levelName << ": GridOverlapLayers failed";
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+      if (EHGHOST(theElement))
+        ghosts++;
+    for (std::size_t k=1; k<layers.size(); k++)
+      reached += layers[k].size();
+
+    test.check((INT)layers.size() <= depth+1)
+      << levelName << ": " << layers.size()-1 << " ghost layers instead of " << depth;
+    test.check(reached == ghosts)
+      << levelName << ": " << ghosts-reached << " ghosts outside of the overlap layers";
+
+    const INT width = UG_GlobalMaxINT(theMG->ppifContext(),(INT)layers.size()-1);
+    if (theMG->ppifContext().procs() > 1)
+      test.check(width == depth)
+        << levelName << ": the widest overlap has " << width << " layers instead of " << depth;
+  }
+}
+
+/* refine the leaf masters around the center of the domain */
+static void MarkCenter (MULTIGRID *theMG, DOUBLE radius)
+{
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,level));
+         theElement!=NULL; theElement=SUCCE(theElement))
+    {
+      if (!LEAFELEM(theElement))
+        continue;
+
+      DOUBLE dist2 = 0;
+      for (INT d=0; d<DIM; d++)
+      {
+        DOUBLE center = 0;
+        for (INT k=0; k<CORNERS_OF_ELEM(theElement); k++)
+          center += CVECT(MYVERTEX(CORNER(theElement,k)))[d];
+        center /= CORNERS_OF_ELEM(theElement);
+        dist2 += (center-0.5)*(center-0.5);
+      }
+      if (std::sqrt(dist2) < radius)
+        MarkForRefinement(theElement,RED,0);
+    }
+}
+
+/* distribute a grid with two ghost layers and check that the overlap keeps
+   its width during adaptation */
+static TestSuite TestOverlap (bool simplices)
+{
+  TestSuite test;
+  const std::string name = simplices ? "simplexOverlap" : "cubeOverlap";
+  const INT depth = 2;
+
+  MULTIGRID *theMG = CreateTestGrid(name,4,simplices);
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+
+  BalanceGridRCB(theMG,0);
+  test.require(TransferGridFromLevel(theMG,0,depth)==0) << name << ": TransferGridFromLevel failed";
+  test.check(theMG->overlapDepth == depth) << name << ": overlap depth " << theMG->overlapDepth;
+  CheckOverlapWidth(test,name + " transfer",theMG,depth);
+
+  for (INT step=0; step<3; step++)
+  {
+    MarkCenter(theMG,0.3);
+    test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid failed";
+    CheckOverlapWidth(test,name + " step " + std::to_string(step),theMG,depth);
+  }
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (bool simplices : {false, true})
+    test.subTest(TestOverlap(simplices));
+
+  ExitUg();
+
+  return test.exit();
+}
@@ -0,0 +1,168 @@
+#include "config.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+
+#include "../algebra.h"
+#include "../gm.h"
+#include "../refine.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+/* VINDEX is not used by the patterns, this value has to survive all queries */
+static const INT UNTOUCHED_INDEX = -17;
+
+/* the node format couples the nodes of an element, in 3D also enable the
+   side vector matrices so that the patterns see two vector types */
+static void EnableSideConnections (MULTIGRID *theMG)
+{
+#ifdef __THREEDIM__
+  FORMAT *fmt = MGFORMAT(theMG).get();
+
+  FMT_S_MAT_TP(fmt,MATRIXTYPE(SIDEVEC,SIDEVEC)) = sizeof(DOUBLE);
+  FMT_S_MAT_TP(fmt,DIAGMATRIXTYPE(SIDEVEC)) = sizeof(DOUBLE);
+  FMT_CONN_DEPTH_TP(fmt,MATRIXTYPE(SIDEVEC,SIDEVEC)) = 0;
+  FMT_CONN_DEPTH_TP(fmt,DIAGMATRIXTYPE(SIDEVEC)) = 0;
+#endif
+}
+
+static void MarkVectors (MULTIGRID *theMG)
+{
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (VECTOR *v=PFIRSTVECTOR(GRID_ON_LEVEL(theMG,level)); v!=NULL; v=SUCCVC(v))
+      VINDEX(v) = UNTOUCHED_INDEX;
+}
+
+/* compare a pattern with the matrix lists of the given rows */
+static void CheckPattern (TestSuite &test, const std::string &name, MULTIGRID *theMG,
+                          const SparsityPattern *pattern, const std::vector<VECTOR *> &vectors)
+{
+  test.require(pattern!=NULL) << name << ": no pattern";
+  if (pattern==NULL)
+    return;
+
+  test.check(pattern->vector == vectors) << name << ": the rows differ from the vector list";
+  if (pattern->vector != vectors)
+    return;
+  test.check(pattern->rowStart.size() == vectors.size()+1) << name << ": wrong number of row starts";
+  test.check(vectors.empty() || !pattern->colIndex.empty()) << name << ": no connections";
+
+  for (INT i=0; i<(INT)vectors.size(); i++)
+  {
+    std::vector<INT> columns;
+    for (MATRIX *m=VSTART(vectors[i]); m!=NULL; m=MNEXT(m))
+    {
+      const INT col = SparsityPatternRow(*pattern,MDEST(m));
+      if (col >= 0)
+        columns.push_back(col);
+    }
+    std::sort(columns.begin(),columns.end());
+
+    const std::vector<INT> cached(pattern->colIndex.begin()+pattern->rowStart[i],
+                                  pattern->colIndex.begin()+pattern->rowStart[i+1]);
+    test.check(columns == cached) << name << ": columns of row " << i << " differ";
+    test.check(SparsityPatternRow(*pattern,vectors[i]) == i) << name << ": wrong row of vector " << i;
+  }
+
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (VECTOR *v=PFIRSTVECTOR(GRID_ON_LEVEL(theMG,level)); v!=NULL; v=SUCCVC(v))
+      test.check(VINDEX(v) == UNTOUCHED_INDEX) << name << ": VINDEX was changed";
+}
+
+static void CheckLevelPattern (TestSuite &test, const std::string &name, GRID *theGrid)
+{
+  std::vector<VECTOR *> vectors;
+  for (VECTOR *v=PFIRSTVECTOR(theGrid); v!=NULL; v=SUCCVC(v))
+    vectors.push_back(v);
+  CheckPattern(test,name + " level " + std::to_string(GLEVEL(theGrid)),MYMG(theGrid),
+               GetGridSparsityPattern(theGrid),vectors);
+}
+
+static void CheckSurfacePattern (TestSuite &test, const std::string &name, MULTIGRID *theMG)
+{
+  std::vector<VECTOR *> vectors;
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    for (VECTOR *v=PFIRSTVECTOR(GRID_ON_LEVEL(theMG,level)); v!=NULL; v=SUCCVC(v))
+      if (FINE_GRID_DOF(v))
+        vectors.push_back(v);
+  CheckPattern(test,name + " surface",theMG,GetSurfaceSparsityPattern(theMG),vectors);
+}
+
+static void MarkTopLevel (MULTIGRID *theMG, enum RefinementRule rule, INT every)
+{
+  INT k = 0;
+
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    if ((k++)%every==0)
+      MarkForRefinement(theElement,rule,0);
+}
+
+/* alternate level and surface queries around refinement and coarsening,
+   the patterns are updated incrementally from the changed rows */
+static TestSuite TestSparsityPatterns (bool simplices)
+{
+  TestSuite test;
+  const std::string name = simplices ? "simplexPattern" : "cubePattern";
+
+  MULTIGRID *theMG = CreateTestGrid(name,2,simplices,"DuneNodeFormat");
+  test.require(theMG!=NULL) << "creating the " << name << " grid failed";
+  if (theMG==NULL)
+    return test;
+  EnableSideConnections(theMG);
+  test.require(MGCreateConnection(theMG)==0) << name << ": MGCreateConnection failed";
+
+  struct Step { enum RefinementRule rule; INT every; };
+  const Step steps[] = {{RED,1},{RED,3},{COARSE,2},{RED,2},{COARSE,1}};
+
+  MarkVectors(theMG);
+  CheckLevelPattern(test,name + " coarse grid",GRID_ON_LEVEL(theMG,0));
+  CheckSurfacePattern(test,name + " coarse grid",theMG);
+
+  for (const Step &step : steps)
+  {
+    MarkTopLevel(theMG,step.rule,step.every);
+    test.require(AdaptMultiGrid(theMG,GM_REFINE_TRULY_LOCAL,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid failed";
+    test.require(MGCreateConnection(theMG)==0) << name << ": MGCreateConnection failed";
+
+    const std::string stepName = name + " top level " + std::to_string(TOPLEVEL(theMG));
+    MarkVectors(theMG);
+    CheckSurfacePattern(test,stepName,theMG);
+    for (INT level=0; level<=TOPLEVEL(theMG); level++)
+    {
+      CheckLevelPattern(test,stepName,GRID_ON_LEVEL(theMG,level));
+      CheckSurfacePattern(test,stepName,theMG);
+    }
+  }
+
+  DisposeMultiGrid(theMG);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (bool simplices : {false, true})
+    test.subTest(TestSparsityPatterns(simplices));
+
+  ExitUg();
+
+  return test.exit();
+}
@@ -0,0 +1,279 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/****************************************************************************/
+/*                                                                          */
+/* File:      testgrids.hh                                                  */
+/*                                                                          */
+/* Purpose:   coarse grids of the unit square or cube for the gm tests      */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef DUNE_UGGRID_GM_TEST_TESTGRIDS_HH
+#define DUNE_UGGRID_GM_TEST_TESTGRIDS_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dune/uggrid/domain/domain.h>
+#include <dune/uggrid/domain/std_domain.h>
+#include <dune/uggrid/gm/gm.h>
+#include <dune/uggrid/gm/ugm.h>
+#ifdef ModelP
+#include <dune/uggrid/parallel/ddd/dddcontext.hh>
+#include <dune/uggrid/parallel/ppif/ppifcontext.hh>
+#endif
+
+START_UGDIM_NAMESPACE
+
+static INT TestGridCoeff (DOUBLE *, DOUBLE *)
+{
+  return 0;
+}
+
+/* boundary point of the unit square or cube as integer coordinates of a */
+/* lattice with n cells per direction                                   */
+using TestGridPoint = std::array<int,DIM>;
+
+static bool OnTestGridBoundary (const TestGridPoint &p, int n)
+{
+  for (int d=0; d<DIM; d++)
+    if (p[d]==0 || p[d]==n) return true;
+  return false;
+}
+
+/****************************************************************************/
+/** \brief Create a coarse grid of the unit square or cube
+
+   \param name - name of the multigrid, the domain and the problem are derived from it
+   \param n - number of cells per direction
+   \param simplices - split the cells into triangles or tetrahedra
+   \param format - name of the format, see CreateFormat
+
+   The cells are squares or cubes, or two triangles (six tetrahedra) each.
+   The boundary is made of linear segments, one per cell face (one per
+   boundary triangle for simplices). The coarse grid is not fixed yet, so
+   that it can still be edited. In parallel it is created on the master only.
+
+   \return the multigrid, NULL if an error occured
+ */
+/****************************************************************************/
+
+static MULTIGRID *CreateTestCoarseGrid (const std::string &name, int n, bool simplices,
+                                        const char *format = "DuneFormat")
+{
+  const std::string domainName = name + "Domain";
+  const std::string problemName = name + "Problem";
+
+  /* boundary lattice points, numbered as they become boundary nodes */
+  std::vector<TestGridPoint> bndPoints;
+  auto bndIndex = [&](const TestGridPoint &p) {
+    return (int)(std::find(bndPoints.begin(),bndPoints.end(),p)-bndPoints.begin());
+  };
+  std::vector<std::vector<TestGridPoint> > segments;
+
+#ifdef __TWODIM__
+  /* counterclockwise around the square */
+  for (int i=0; i<n; i++) bndPoints.push_back({{i,0}});
+  for (int i=0; i<n; i++) bndPoints.push_back({{n,i}});
+  for (int i=0; i<n; i++) bndPoints.push_back({{n-i,n}});
+  for (int i=0; i<n; i++) bndPoints.push_back({{0,n-i}});
+  for (int s=0; s<4*n; s++)
+    segments.push_back({bndPoints[s],bndPoints[(s+1)%(4*n)]});
+#else
+  for (int k=0; k<=n; k++)
+    for (int j=0; j<=n; j++)
+      for (int i=0; i<=n; i++)
+        if (OnTestGridBoundary({{i,j,k}},n))
+          bndPoints.push_back({{i,j,k}});
+
+  /* faces of the cells on the sides d=0 and d=n, oriented outwards */
+  for (int d=0; d<DIM; d++)
+    for (int s=0; s<2; s++)
+      for (int a=0; a<n; a++)
+        for (int b=0; b<n; b++)
+        {
+          const int d1 = (d+1)%DIM, d2 = (d+2)%DIM;
+          auto corner = [&](int u, int v) {
+            TestGridPoint p;
+            p[d] = s*n; p[d1] = a+u; p[d2] = b+v;
+            return p;
+          };
+          const std::vector<TestGridPoint> quad = {corner(0,0),corner(1,0),corner(1,1),corner(0,1)};
+          std::vector<std::vector<TestGridPoint> > faces;
+
+          /* the diagonals match the Kuhn triangulation below */
+          if (simplices)
+            faces = {{quad[0],quad[1],quad[2]},{quad[0],quad[2],quad[3]}};
+          else
+            faces = {quad};
+          for (auto &face : faces)
+          {
+            if (s==1) std::reverse(face.begin(),face.end());
+            segments.push_back(face);
+          }
+        }
+#endif
+
+  if (CreateDomain(domainName.c_str(),segments.size(),bndPoints.size())==NULL)
+    return (NULL);
+  for (std::size_t s=0; s<segments.size(); s++)
+  {
+    INT point[CORNERS_OF_BND_SEG];
+    DOUBLE x[CORNERS_OF_BND_SEG][DIM];
+    const std::string segmentName = domainName + std::to_string(s);
+
+    for (std::size_t c=0; c<segments[s].size(); c++)
+    {
+      point[c] = bndIndex(segments[s][c]);
+      for (int d=0; d<DIM; d++)
+        x[c][d] = (DOUBLE)segments[s][c][d]/n;
+    }
+    if (CreateLinearSegment(segmentName.c_str(),1,0,s,segments[s].size(),point,x)==NULL)
+      return (NULL);
+  }
+
+  CoeffProcPtr coeffs[1] = {TestGridCoeff};
+  UserProcPtr userfcts[1] = {TestGridCoeff};
+  BVP *theBVP = CreateBoundaryValueProblem(problemName.c_str(),NULL,1,coeffs,1,userfcts);
+  if (theBVP==NULL)
+    return (NULL);
+
+  BVP_DESC theBVPDesc;
+  std::string configure = "configure " + problemName;
+  std::string domain = "d " + domainName;
+  char *argv[2] = {&configure[0],&domain[0]};
+  if (BVP_SetBVPDesc(theBVP,&theBVPDesc)) return (NULL);
+  if ((*BVPD_CONFIG(&theBVPDesc))(2,argv)) return (NULL);
+
+  MULTIGRID *theMG = CreateMultiGrid(const_cast<char *>(name.c_str()),
+                                     const_cast<char *>(problemName.c_str()),
+                                     format,1,1);
+  if (theMG==NULL)
+    return (NULL);
+  GRID *theGrid = GRID_ON_LEVEL(theMG,0);
+
+#ifdef ModelP
+  /* the coarse grid is inserted on the master, the other procs */
+  /* receive their part by TransferGrid                         */
+  if (!theMG->ppifContext().isMaster())
+    return (theMG);
+#endif
+
+  /* the boundary nodes are created in the order of the boundary points */
+  std::vector<NODE *> bndNodes;
+  for (NODE *theNode=FIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+    bndNodes.push_back(theNode);
+  std::sort(bndNodes.begin(),bndNodes.end(),
+            [](NODE *a, NODE *b) { return ID(a)<ID(b); });
+
+  /* nodes of all lattice points, x fastest */
+  int nPoints = 1;
+  for (int d=0; d<DIM; d++) nPoints *= n+1;
+  std::vector<NODE *> nodes(nPoints);
+  auto lattice = [&](const TestGridPoint &p) {
+    int index = 0;
+    for (int d=DIM-1; d>=0; d--) index = index*(n+1)+p[d];
+    return index;
+  };
+  for (int index=0; index<nPoints; index++)
+  {
+    TestGridPoint p;
+    DOUBLE pos[DIM];
+    int r = index;
+
+    for (int d=0; d<DIM; d++) { p[d] = r%(n+1); r /= n+1; pos[d] = (DOUBLE)p[d]/n; }
+    if (OnTestGridBoundary(p,n))
+      nodes[index] = bndNodes[bndIndex(p)];
+    else if ((nodes[index] = InsertInnerNode(theGrid,pos))==NULL)
+      return (NULL);
+  }
+
+  int nCells = 1;
+  for (int d=0; d<DIM; d++) nCells *= n;
+  for (int cell=0; cell<nCells; cell++)
+  {
+    TestGridPoint c;
+    int r = cell;
+
+    for (int d=0; d<DIM; d++) { c[d] = r%n; r /= n; }
+    auto corner = [&](int i, int j, int k) {
+      TestGridPoint p = c;
+      p[0] += i; p[1] += j;
+#ifdef __THREEDIM__
+      p[2] += k;
+#endif
+      return nodes[lattice(p)];
+    };
+
+#ifdef __TWODIM__
+    NODE *quad[4] = {corner(0,0,0),corner(1,0,0),corner(1,1,0),corner(0,1,0)};
+    if (simplices)
+    {
+      NODE *t0[3] = {quad[0],quad[1],quad[2]};
+      NODE *t1[3] = {quad[0],quad[2],quad[3]};
+      if (InsertElement(theGrid,3,t0,NULL,NULL,NULL)==NULL) return (NULL);
+      if (InsertElement(theGrid,3,t1,NULL,NULL,NULL)==NULL) return (NULL);
+    }
+    else if (InsertElement(theGrid,4,quad,NULL,NULL,NULL)==NULL)
+      return (NULL);
+#else
+    if (simplices)
+    {
+      /* Kuhn triangulation: one tetrahedron per path from corner 0 to 7 */
+      const int perms[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+      for (const auto &perm : perms)
+      {
+        std::array<int,3> o = {{0,0,0}};
+        NODE *tet[4];
+
+        tet[0] = corner(0,0,0);
+        for (int m=0; m<3; m++)
+        {
+          o[perm[m]]++;
+          tet[m+1] = corner(o[0],o[1],o[2]);
+        }
+        /* odd permutations are negatively oriented */
+        if ((perm[0]>perm[1]) ^ (perm[1]>perm[2]) ^ (perm[0]>perm[2]))
+          std::swap(tet[1],tet[2]);
+        if (InsertElement(theGrid,4,tet,NULL,NULL,NULL)==NULL) return (NULL);
+      }
+    }
+    else
+    {
+      NODE *hex[8] = {corner(0,0,0),corner(1,0,0),corner(1,1,0),corner(0,1,0),
+                      corner(0,0,1),corner(1,0,1),corner(1,1,1),corner(0,1,1)};
+      if (InsertElement(theGrid,8,hex,NULL,NULL,NULL)==NULL) return (NULL);
+    }
+#endif
+  }
+
+  return (theMG);
+}
+
+/****************************************************************************/
+/** \brief Create and fix a coarse grid of the unit square or cube
+
+   Same as CreateTestCoarseGrid, but the coarse grid is fixed. In parallel
+   it has to be distributed by the caller.
+
+   \return the multigrid, NULL if an error occured
+ */
+/****************************************************************************/
+
+static MULTIGRID *CreateTestGrid (const std::string &name, int n, bool simplices,
+                                  const char *format = "DuneFormat")
+{
+  MULTIGRID *theMG = CreateTestCoarseGrid(name,n,simplices,format);
+  if (theMG==NULL)
+    return (NULL);
+  if (FixCoarseGrid(theMG)) return (NULL);
+
+  return (theMG);
+}
+
+END_UGDIM_NAMESPACE
+
+#endif
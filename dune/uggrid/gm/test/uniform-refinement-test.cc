@@ -0,0 +1,171 @@
+#include "config.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/initug.h>
+#ifdef ModelP
+#include <dune/uggrid/parallel/dddif/parallel.h>
+#endif
+
+#include "../gm.h"
+#include "../refine.h"
+#include "../ugm.h"
+#include "testgrids.hh"
+
+USING_UGDIM_NAMESPACE
+USING_UG_NAMESPACE
+
+using Dune::TestSuite;
+
+/* AdaptMultiGrid does not take the uniform shortcut with this flag bit */
+static const INT NO_UNIFORM_SHORTCUT = 16;
+
+/* all refinement and closure state of a multigrid, independent of the
+   order of the lists */
+static std::string Fingerprint (MULTIGRID *theMG)
+{
+  std::string out;
+  char buffer[512];
+
+  for (INT level=0; level<=TOPLEVEL(theMG); level++)
+  {
+    GRID *theGrid = GRID_ON_LEVEL(theMG,level);
+    std::vector<std::string> elements, nodes;
+
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+    {
+      std::snprintf(buffer,sizeof(buffer),
+                    "id%d t%d ec%d r%d rc%d m%d mc%d c%d u%d s%d ug%d |",
+                    (int)ID(theElement),(int)TAG(theElement),(int)ECLASS(theElement),
+                    (int)REFINE(theElement),(int)REFINECLASS(theElement),
+                    (int)MARK(theElement),(int)MARKCLASS(theElement),(int)COARSEN(theElement),
+                    (int)USED(theElement),(int)NSONS(theElement),(int)UPDATE_GREEN(theElement));
+      std::string s = buffer;
+      for (INT i=0; i<CORNERS_OF_ELEM(theElement); i++)
+      {
+        const DOUBLE *x = CVECT(MYVERTEX(CORNER(theElement,i)));
+        std::snprintf(buffer,sizeof(buffer)," n%d(%.5f,%.5f,%.5f)",
+                      (int)ID(CORNER(theElement,i)),x[0],x[1],DIM==3 ? x[DIM-1] : 0.0);
+        s += buffer;
+      }
+      for (INT i=0; i<EDGES_OF_ELEM(theElement); i++)
+      {
+        EDGE *theEdge = GetEdge(CORNER_OF_EDGE_PTR(theElement,i,0),CORNER_OF_EDGE_PTR(theElement,i,1));
+        std::snprintf(buffer,sizeof(buffer)," e%d:p%da%dm%d",
+                      (int)ID(theEdge),(int)PATTERN(theEdge),(int)ADDPATTERN(theEdge),
+                      MIDNODE(theEdge)!=NULL);
+        s += buffer;
+      }
+      elements.push_back(s);
+    }
+    for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+    {
+      std::snprintf(buffer,sizeof(buffer),"n%d nc%d nnc%d nt%d mod%d",
+                    (int)ID(theNode),(int)NCLASS(theNode),(int)NNCLASS(theNode),
+                    (int)NTYPE(theNode),(int)MODIFIED(theNode));
+      nodes.push_back(buffer);
+    }
+    std::sort(elements.begin(),elements.end());
+    std::sort(nodes.begin(),nodes.end());
+
+    out += "level " + std::to_string(level) + "\n";
+    for (const auto &s : elements) out += s + "\n";
+    for (const auto &s : nodes) out += s + "\n";
+  }
+
+  return out;
+}
+
+static void MarkTopLevel (MULTIGRID *theMG, enum RefinementRule rule, INT every)
+{
+  INT k = 0;
+
+  for (ELEMENT *theElement=FIRSTELEMENT(GRID_ON_LEVEL(theMG,TOPLEVEL(theMG)));
+       theElement!=NULL; theElement=SUCCE(theElement))
+    if ((k++)%every==0)
+      MarkForRefinement(theElement,rule,0);
+}
+
+/* refine and coarsen two copies of a grid, one of them without the uniform
+   shortcut, and compare them after each step. In parallel both copies are
+   distributed the same way and each processor compares its part */
+static TestSuite TestUniformRefinement (bool simplices, INT flag)
+{
+  TestSuite test;
+  const std::string name = std::string(simplices ? "simplex" : "cube") + std::to_string(flag);
+  const int n = (DIM==2) ? 4 : 2;
+
+  MULTIGRID *fast = CreateTestGrid(name + "fast",n,simplices);
+  MULTIGRID *full = CreateTestGrid(name + "full",n,simplices);
+  test.require(fast!=NULL && full!=NULL) << "creating the " << name << " grids failed";
+  if (fast==NULL || full==NULL)
+    return test;
+
+#ifdef ModelP
+  for (MULTIGRID *theMG : {fast, full})
+  {
+    BalanceGridRCB(theMG,0);
+    test.require(TransferGridFromLevel(theMG,0)==0) << name << ": TransferGridFromLevel failed";
+  }
+#endif
+
+  struct Step { enum RefinementRule rule; INT every; };
+  const Step steps[] = {{RED,1},{RED,1},{RED,11},{RED,1},{COARSE,1},{COARSE,1},{RED,1}};
+
+  for (const Step &step : steps)
+  {
+#ifdef ModelP
+    /* the identification fails after local refinement with hanging nodes */
+    /* in 2d and before the red refinement of a closure in 3d, in parallel */
+    if (fast->ppifContext().procs() > 1 && step.every > 1)
+      continue;
+#endif
+
+    MarkTopLevel(fast,step.rule,step.every);
+    MarkTopLevel(full,step.rule,step.every);
+    test.check(AdaptMultiGrid(fast,flag,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid failed";
+    test.check(AdaptMultiGrid(full,flag|NO_UNIFORM_SHORTCUT,GM_REFINE_PARALLEL,GM_REFINE_NOHEAPTEST)==GM_OK)
+      << name << ": AdaptMultiGrid without shortcut failed";
+
+    test.check(Fingerprint(fast)==Fingerprint(full))
+      << name << ": grids differ at top level " << TOPLEVEL(fast);
+
+    /* the grid checks do not accept hanging nodes */
+    if (flag!=GM_REFINE_NOT_CLOSED)
+      for (INT level=0; level<=TOPLEVEL(fast); level++)
+#ifdef ModelP
+        test.check(CheckGrid(GRID_ON_LEVEL(fast,level),1,0,1,1)==GM_OK)
+#else
+        test.check(CheckGrid(GRID_ON_LEVEL(fast,level),1,0,1)==GM_OK)
+#endif
+          << name << ": CheckGrid failed on level " << level;
+  }
+
+  DisposeMultiGrid(fast);
+  DisposeMultiGrid(full);
+
+  return test;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+  InitUg(&argc, &argv);
+
+  TestSuite test;
+
+  for (bool simplices : {false, true})
+    for (INT flag : {GM_REFINE_TRULY_LOCAL, GM_COPY_ALL, GM_REFINE_NOT_CLOSED})
+      test.subTest(TestUniformRefinement(simplices,flag));
+
+  ExitUg();
+
+  return test.exit();
+}
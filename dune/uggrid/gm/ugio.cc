@@ -37,6 +37,9 @@
 #include <cmath>
 #include <climits>
 #include <ctime>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <dune/common/unused.hh>
 
@@ -159,6 +162,40 @@ static int npe_info;                                            /* partitioning
 #endif
 static int proc_list_size = -1;                         /* hold the computed value for PROCLISTSIZE; initialized with crazy dummy */
 
+START_UGDIM_NAMESPACE
+
+/** \brief What SaveMultiGrid_SPF computed for the last save
+ *
+ * The rule table and the numbering only depend on the grid topology,
+ * so they are reused by all saves until the topology revision changes.
+ */
+struct SaveCache
+{
+  /** \brief Topology revision the cache was built for */
+  unsigned int revision;
+
+  /** \brief Tag-wise rule offsets and rule table as written to the file */
+  INT refRuleOffset[TAGS];
+  std::vector<MGIO_RR_RULE> rules;
+
+  /** \brief Elements refined by an extracted rule and the refine tag of that rule */
+  std::vector<std::pair<ELEMENT*,INT> > extracted;
+
+  /** \brief Orphan counts and node ids as returned by RenumberMultiGrid */
+  INT nbe,nie,nbv,niv,foid,non;
+
+  /** \brief Lowest orphan node of each orphan vertex (parallel files only) */
+  std::vector<NODE*> vidNode;
+
+  /** \brief Node-id to vertex-id mapping of the orphan nodes (parallel files only) */
+  std::vector<int> vidList;
+
+  /** \brief Boundary points of the orphan boundary vertices */
+  std::vector<BNDP*> bndPList;
+};
+
+END_UGDIM_NAMESPACE
+
 /****************************************************************************/
 /*																			*/
 /* forward declarations of functions used before they are defined			*/
@@ -1103,7 +1140,7 @@ static INT nRefinements (ELEMENT *theElement, INT *n)
   return (0);
 }
 
-static INT WriteCG_Vertices (MULTIGRID *theMG, INT MarkKey)
+static INT WriteCG_Vertices (MULTIGRID *theMG, INT renumbered, INT MarkKey)
 {
   INT i,j,n;
   MGIO_CG_POINT *cg_point,*cgp;
@@ -1118,7 +1155,8 @@ static INT WriteCG_Vertices (MULTIGRID *theMG, INT MarkKey)
     for (theVertex=PFIRSTVERTEX(GRID_ON_LEVEL(theMG,i)); theVertex!=NULL; theVertex=SUCCV(theVertex))
       if (ID(theVertex)<nov)
       {
-        assert(USED(theVertex));
+        /* the used flags are only valid right after renumbering */
+        assert(!renumbered || USED(theVertex));
         cgp = MGIO_CG_POINT_PS(cg_point,ID(theVertex));
         for (j=0; j<MGIO_DIM; j++)
           cgp->position[j] = CVECT(theVertex)[j];
@@ -1262,6 +1300,18 @@ static INT WriteElementParInfo (GRID *theGrid, ELEMENT *theElement, MGIO_PARINFO
 }
 #endif
 
+/* report size and throughput of a compressed file */
+static void WriteBioStatistics (const char *what)
+{
+  BIO_STATISTICS stat;
+
+  Bio_Statistics(&stat);
+  UserWriteF("UGIO: %s %d blocks, %.3f MB data in %.3f MB file (%.1f%%), %.1f MB/s\n",
+             what,stat.blocks,stat.rawBytes/1e6,stat.fileBytes/1e6,
+             (stat.rawBytes>0) ? 100.0*stat.fileBytes/stat.rawBytes : 0.0,
+             (stat.seconds>0) ? stat.rawBytes/1e6/stat.seconds : 0.0);
+}
+
 static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *type, const char *comment, INT autosave, INT rename)
 {
   GRID *theGrid;
@@ -1280,13 +1330,14 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
   MGIO_BD_GENERAL bd_general;
   MGIO_PARINFO cg_pinfo;
   INT i,j,k,niv,nbv,nie,nbe,n,nref,hr_max,mode,level,id,foid,non,tl,saved;
-  int *vidlist;
   char *p,*f,*s,*l;
-  BNDP **BndPList;
   char filename[NAMESIZE];
   char buf[64],itype[10];
   int lastnumber;
-  INT MarkKey;
+  INT MarkKey,nrules;
+  std::shared_ptr<SaveCache> newCache;
+  SaveCache *cache;
+  bool cached;
 #ifdef ModelP
   int error;
         #ifdef STAT_OUT
@@ -1362,6 +1413,7 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
   if (strcmp(itype,"xdr")==0) mode = BIO_XDR;
   else if (strcmp(itype,"asc")==0) mode = BIO_ASCII;
   else if (strcmp(itype,"bin")==0) mode = BIO_BIN;
+  else if (strcmp(itype,"cbin")==0) mode = BIO_CBIN;
   else REP_ERR_RETURN(1);
   sprintf(buf,".ug.mg.");
   strcat(filename,buf);
@@ -1458,13 +1510,51 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
   }
   if (Write_GE_Elements(TAGS,ge_element)) REP_ERR_RETURN(1);
 
+  /* reuse rules and numbering of the last save if the topology did not change
+     (local changes like InsertElement bump the revision on one processor only,
+     so all processors have to agree on this) */
+  cache = theMG->saveCache.get();
+  cached = (EXTRACT_RULES && cache!=NULL && cache->revision==MG_TOPOLOGY_REVISION(theMG));
+#ifdef ModelP
+  cached = UG_GlobalMinINT(theMG->ppifContext(), cached);
+#endif
+  if (!cached)
+  {
+    /* installed in the multigrid once it is complete */
+    theMG->saveCache.reset();
+    newCache = std::make_shared<SaveCache>();
+    cache = newCache.get();
+    cache->revision = MG_TOPOLOGY_REVISION(theMG);
+  }
+
   /* write information about refrules used */
-  /* TODO (HRR 971209): drop old call of Write_RefRules */
-    #if EXTRACT_RULES
-  if (NEW_Write_RefRules(theMG,rr_rule_offsets,MarkKey,&rr_rules)) REP_ERR_RETURN(1);
+  if (cached)
+  {
+    MGIO_RR_GENERAL rr_general;
+
+    for (i=0; i<TAGS; i++)
+      rr_general.RefRuleOffset[i] = rr_rule_offsets[i] = cache->refRuleOffset[i];
+    rr_general.nRules = cache->rules.size();
+    rr_rules = cache->rules.data();
+    if (Write_RR_General(&rr_general)) REP_ERR_RETURN(1);
+    if (Write_RR_Rules(rr_general.nRules,rr_rules)) REP_ERR_RETURN(1);
+
+    /* restore the refine tags of extracted rules reset by the last save */
+    for (const auto& e : cache->extracted)
+      SETREFINE(e.first,e.second);
+  }
+  else
+  {
+    /* TODO (HRR 971209): drop old call of Write_RefRules */
+        #if EXTRACT_RULES
+    if (NEW_Write_RefRules(theMG,rr_rule_offsets,MarkKey,&rr_rules,&nrules)) REP_ERR_RETURN(1);
+    for (i=0; i<TAGS; i++)
+      cache->refRuleOffset[i] = rr_rule_offsets[i];
+    cache->rules.assign(rr_rules,rr_rules+nrules);
         #else
-  if (Write_RefRules(theMG,rr_rule_offsets,MarkKey)) REP_ERR_RETURN(1);
+    if (Write_RefRules(theMG,rr_rule_offsets,MarkKey)) REP_ERR_RETURN(1);
         #endif
+  }
 
   i = OrphanCons(theMG);
   if (i)
@@ -1475,13 +1565,51 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
   }
 
   /* renumber objects */
-  if (MGIO_PARFILE)
+  if (!cached)
   {
-    if (RenumberMultiGrid (theMG,&nbe,&nie,&nbv,&niv,&vid_n,&foid,&non,MarkKey)) {UserWriteF("ERROR: cannot renumber multigrid\n"); REP_ERR_RETURN(1);}
+    if (MGIO_PARFILE)
+    {
+      if (RenumberMultiGrid (theMG,&nbe,&nie,&nbv,&niv,&vid_n,&foid,&non,MarkKey)) {UserWriteF("ERROR: cannot renumber multigrid\n"); REP_ERR_RETURN(1);}
+    }
+    else
+    {
+      if (RenumberMultiGrid (theMG,&nbe,&nie,&nbv,&niv,NULL,&foid,&non,MarkKey)) {UserWriteF("ERROR: cannot renumber multigrid\n"); REP_ERR_RETURN(1);}
+    }
+    cache->nbe = nbe; cache->nie = nie;
+    cache->nbv = nbv; cache->niv = niv;
+    cache->foid = foid; cache->non = non;
+
+    /* keep what is otherwise taken from the used flags set by renumbering */
+    if (MGIO_PARFILE)
+    {
+      cache->vidNode.assign(vid_n,vid_n+nbv+niv);
+      cache->vidList.resize(2+non);
+      cache->vidList[0] = non;
+      cache->vidList[1] = foid;
+      for (i=0; i<=TOPLEVEL(theMG); i++)
+        for (theNode=PFIRSTNODE(GRID_ON_LEVEL(theMG,i)); theNode!=NULL; theNode=SUCCN(theNode))
+          if (USED(theNode))
+            cache->vidList[ID(theNode)+2-foid] = ID(MYVERTEX(theNode));
+    }
+    cache->bndPList.resize(nbv);
+    if (procs>1) i=TOPLEVEL(theMG);
+    else i=0;
+    for (level=0; level<=i; level++)
+      for (theNode=PFIRSTNODE(GRID_ON_LEVEL(theMG,level)); theNode!=NULL; theNode=SUCCN(theNode))
+        if (USED(MYVERTEX(theNode)) && OBJT(MYVERTEX(theNode))==BVOBJ) {
+          /* see ugm.c: RenumberVertices */
+          id = ID(MYVERTEX(theNode));
+          if (id<0 || id>=nbv) REP_ERR_RETURN(1);
+          cache->bndPList[id] = V_BNDP(MYVERTEX(theNode));
+        }
+    theMG->saveCache = newCache;
   }
   else
   {
-    if (RenumberMultiGrid (theMG,&nbe,&nie,&nbv,&niv,NULL,&foid,&non,MarkKey)) {UserWriteF("ERROR: cannot renumber multigrid\n"); REP_ERR_RETURN(1);}
+    nbe = cache->nbe; nie = cache->nie;
+    nbv = cache->nbv; niv = cache->niv;
+    foid = cache->foid; non = cache->non;
+    vid_n = cache->vidNode.data();
   }
   nov = nbv+niv;
 
@@ -1514,20 +1642,11 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
 #endif
 
   /* write coarse grid points */
-  if (WriteCG_Vertices(theMG,MarkKey)) REP_ERR_RETURN(1);
+  if (WriteCG_Vertices(theMG,!cached,MarkKey)) REP_ERR_RETURN(1);
 
   /* write mapping: node-id --> vertex-id for orphan-nodes, if(MGIO_PARFILE) */
   if (MGIO_PARFILE)
-  {
-    vidlist = (int*)GetTmpMem(theHeap,(2+non)*sizeof(int),MarkKey);
-    vidlist[0] = non;
-    vidlist[1] = foid;
-    for (i=0; i<=TOPLEVEL(theMG); i++)
-      for (theNode=PFIRSTNODE(GRID_ON_LEVEL(theMG,i)); theNode!=NULL; theNode=SUCCN(theNode))
-        if (USED(theNode))
-          vidlist[ID(theNode)+2-foid] = ID(MYVERTEX(theNode));
-    if (Bio_Write_mint((int)(2+non),vidlist)) REP_ERR_RETURN(1);
-  }
+    if (Bio_Write_mint((int)(2+non),cache->vidList.data())) REP_ERR_RETURN(1);
 
   /* write orphan elements */
   n = cg_general.nElement; hr_max=0;
@@ -1610,25 +1729,17 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
   if (Write_BD_General (&bd_general)) REP_ERR_RETURN(1);
 
   /* write bnd information */
-  if (nbv > 0) {
-    BndPList = (BNDP**)GetTmpMem(theHeap,nbv*sizeof(BNDP*),MarkKey);
-    if (BndPList==NULL) {
-      UserWriteF("ERROR: cannot allocate %d bytes for BndPList\n",
-                 (int)nbv*sizeof(BNDP*));
-      REP_ERR_RETURN(1);
-    }
+  if (nbv > 0)
+    if (Write_PBndDesc (nbv,cache->bndPList.data())) REP_ERR_RETURN(1);
+  if (!cached)
+  {
+    /* reset the used flags of the boundary vertices as before the cache */
     if (procs>1) i=TOPLEVEL(theMG);
     else i=0;
     for (level=0; level<=i; level++)
       for (theNode=PFIRSTNODE(GRID_ON_LEVEL(theMG,level)); theNode!=NULL; theNode=SUCCN(theNode))
-        if (USED(MYVERTEX(theNode)) && OBJT(MYVERTEX(theNode))==BVOBJ) {
-          /* see ugm.c: RenumberVertices */
-          id = ID(MYVERTEX(theNode));
-          if (id<0 || id>=nbv) REP_ERR_RETURN(1);
-          BndPList[id] = V_BNDP(MYVERTEX(theNode));
+        if (USED(MYVERTEX(theNode)) && OBJT(MYVERTEX(theNode))==BVOBJ)
           SETUSED(MYVERTEX(theNode),0);
-        }
-    if (Write_PBndDesc (nbv,BndPList)) REP_ERR_RETURN(1);
   }
   if (Bio_Jump_To ()) REP_ERR_RETURN(1);
 
@@ -1671,13 +1782,16 @@ static INT SaveMultiGrid_SPF (MULTIGRID *theMG, const char *name, const char *ty
 
   /* close file */
   if (CloseMGFile ()) REP_ERR_RETURN(1);
+  if (mode==BIO_CBIN)
+    WriteBioStatistics("written");
 
   /* saved */
   MG_SAVED(theMG) = 1;
   strcpy(MG_FILENAME(theMG),filename);
 
         #if EXTRACT_RULES
-  ResetRefineTagsBeyondRuleManager(theMG);
+  cache->extracted.clear();
+  ResetRefineTagsBeyondRuleManager(theMG,&cache->extracted);
         #endif
 
         #ifdef STAT_OUT
@@ -3472,6 +3586,8 @@ nparfiles = UG_GlobalMinINT(*ppifContext, nparfiles);
   /* close file */
   ReleaseTmpMem(theHeap,MarkKey);
   if (CloseMGFile ())                                                     {DisposeMultiGrid(theMG); return (NULL);}
+  if (mg_general.mode==BIO_CBIN)
+    WriteBioStatistics("read");
 
 
   /* saved */
@@ -65,6 +65,9 @@
 #include "dlmgr.h"
 #include "algebra.h"
 #include "ugm.h"
+#include "indexsets.h"
+#include "geomcache.h"
+#include "adjacency.h"
 #include "elements.h"
 #include "shapes.h"
 #include "refine.h"
@@ -135,6 +138,12 @@ static UINT UsedOBJT;           /* for the dynamic OBJECT management	*/
 
 REP_ERR_FILE
 
+/* nodes and edges without a vector are allocated without their last member */
+static_assert(offsetof(NODE,vector)+sizeof(VECTOR *) == sizeof(NODE),
+              "the vector pointer must be the last member of a node");
+static_assert(offsetof(EDGE,vector)+sizeof(VECTOR *) == sizeof(EDGE),
+              "the vector pointer must be the last member of an edge");
+
 /****************************************************************************/
 /*                                                                          */
 /* forward declarations of functions used before they are defined           */
@@ -243,7 +252,11 @@ void * NS_DIM_PREFIX GetMemoryForObject (MULTIGRID *theMG, INT size, INT type)
 {
   void * obj = GetMem(MGHEAP(theMG),size);
   if (obj != NULL)
+  {
     memset(obj,0,size);
+    if (theMG != NULL && type >= 0)
+      HeapStatAlloc(HEAPSTAT(MGHEAP(theMG),type),size);
+  }
 
   #ifdef ModelP
   if (type!=MAOBJ && type!=COOBJ)
@@ -294,6 +307,8 @@ INT NS_DIM_PREFIX PutFreeObject (MULTIGRID *theMG, void *object, INT size, INT t
     DestructDDDObject(theMG->dddContext(), object,type);
   #endif
 
+  if (type >= 0)
+    HeapStatFree(HEAPSTAT(MGHEAP(theMG),type),size);
   DisposeMem(MGHEAP(theMG), object);
   return 0;
 }
@@ -344,6 +359,8 @@ static VERTEX *CreateBoundaryVertex (GRID *theGrid)
   /* insert in vertex list */
   GRID_LINK_VERTEX(theGrid,pv,PrioMaster);
 
+  IndexSetsInsert(MYMG(theGrid),pv);
+
   return(pv);
 }
 
@@ -391,6 +408,8 @@ static VERTEX *CreateInnerVertex (GRID *theGrid)
   /* insert in vertex list */
   GRID_LINK_VERTEX(theGrid,pv,PrioMaster);
 
+  IndexSetsInsert(MYMG(theGrid),pv);
+
   return(pv);
 }
 
@@ -431,9 +450,11 @@ static NODE *CreateNode (GRID *theGrid, VERTEX *vertex,
         #ifdef ModelP
   DDD_AttrSet(PARHDR(pn),GRID_ATTR(theGrid));
   /* SETPRIO(pn,PrioMaster); */
+        #endif
+#ifdef UG_HAS_MESSAGE_BUFFER
   pn->message_buffer_ = nullptr;
   pn->message_buffer_size_ = 0;
-        #endif
+#endif
   ID(pn) = (theGrid->mg->nodeIdCounter)++;
   START(pn) = NULL;
   SONNODE(pn) = NULL;
@@ -483,6 +504,8 @@ static NODE *CreateNode (GRID *theGrid, VERTEX *vertex,
   /* insert in vertex list */
   GRID_LINK_NODE(theGrid,pn,PrioMaster);
 
+  IndexSetsInsert(MYMG(theGrid),pn);
+
   return(pn);
 }
 
@@ -2327,6 +2350,8 @@ CreateEdge (GRID *theGrid, ELEMENT *theElement, INT edge, bool with_vector)
   /* counters */
   NE(theGrid)++;
 
+  IndexSetsInsert(MYMG(theGrid),pe);
+
   /* return ok */
   return(pe);
 }
@@ -2496,6 +2521,8 @@ ELEMENT * NS_DIM_PREFIX CreateElement (GRID *theGrid, INT tag, INT objtype, NODE
     }
   }
 
+  IndexSetsInsert(MYMG(theGrid),pe);
+
   /* return ok */
   return(pe);
 }
@@ -2882,7 +2909,7 @@ MULTIGRID * NS_DIM_PREFIX GetNextMultigrid (const MULTIGRID *theMG)
  * @param   MultigridName - name of multigrid
  * @param   domain - name of domain description from environment
  * @param   problem - name of problem description from environment
- * @param   format - name of format description from environment
+ * @param   format - name of the format, see CreateFormat
  * @param   optimizedIE - allocate NodeElementList
 
    This function creates and initializes a new multigrid structure including
@@ -2910,7 +2937,7 @@ MULTIGRID * NS_DIM_PREFIX CreateMultiGrid (char *MultigridName, char *BndValProb
   if (not ppifContext)
     ppifContext = std::make_shared<PPIF::PPIFContext>();
 
-  std::unique_ptr<FORMAT> theFormat = CreateFormat();
+  std::unique_ptr<FORMAT> theFormat = CreateFormat(format);
   if (theFormat==NULL)
   {
     PrintErrorMessage('E',"CreateMultiGrid","format not found");
@@ -3042,6 +3069,8 @@ static INT DisposeEdge (GRID *theGrid, EDGE *theEdge)
 
   HEAPFAULT(theEdge);
 
+  IndexSetsRemove(MYMG(theGrid),theEdge);
+
   /* reconstruct data */
   link0 = LINK0(theEdge);
   link1 = LINK1(theEdge);
@@ -3132,6 +3161,8 @@ INT NS_DIM_PREFIX DisposeNode (GRID *theGrid, NODE *theNode)
 
   HEAPFAULT(theNode);
 
+  IndexSetsRemove(MYMG(theGrid),theNode);
+
   /* call DisposeElement first! */
   assert(START(theNode) == NULL);
         #ifdef ModelP
@@ -3205,7 +3236,7 @@ INT NS_DIM_PREFIX DisposeNode (GRID *theGrid, NODE *theNode)
   else
     DECNOOFNODE(theVertex);
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /* free message buffer */
   theNode->message_buffer_free();
 #endif
@@ -3251,6 +3282,7 @@ static INT DisposeVertex (GRID *theGrid, VERTEX *theVertex)
 
   /* remove vertex from vertex list */
   GRID_UNLINK_VERTEX(theGrid,theVertex);
+  IndexSetsRemove(MYMG(theGrid),theVertex);
 
   if( OBJT(theVertex) == BVOBJ )
   {
@@ -3297,6 +3329,9 @@ INT NS_DIM_PREFIX DisposeElement (GRID *theGrid, ELEMENT *theElement, INT dispos
 
   HEAPFAULT(theElement);
 
+  IndexSetsRemove(MYMG(theGrid),theElement);
+  GeometryCacheRemove(MYMG(theGrid),theElement);
+
   GRID_UNLINK_ELEMENT(theGrid,theElement);
 
         #ifdef __CENTERNODE__
@@ -3574,7 +3609,7 @@ INT NS_DIM_PREFIX DisposeElement (GRID *theGrid, ELEMENT *theElement, INT dispos
     if (DisposeVector (theGrid,EVECTOR(theElement)))
       RETURN(1);
 
-#ifdef ModelP
+#ifdef UG_HAS_MESSAGE_BUFFER
   /* free message buffer */
   theElement->message_buffer_free();
 #endif
@@ -3752,6 +3787,8 @@ INT NS_DIM_PREFIX Collapse (MULTIGRID *theMG)
     if (CreateAlgebra(theMG))
       REP_ERR_RETURN(1);
 
+  MG_TOPOLOGY_CHANGED(theMG);
+
   return(0);
 }
 
@@ -3800,6 +3837,7 @@ INT NS_DIM_PREFIX DisposeTopLevel (MULTIGRID *theMG)
     theMG->currentLevel = theMG->topLevel;
 
   PutFreeObject(theMG,theGrid,sizeof(GRID),GROBJ);
+  MG_TOPOLOGY_CHANGED(theMG);
 
   return(0);
 }
@@ -3858,6 +3896,7 @@ INT NS_DIM_PREFIX DisposeGrid (GRID *theGrid)
   theMG->elemIdCounter = 0;
 
   PutFreeObject(theMG,theGrid,sizeof(GRID),GROBJ);
+  MG_TOPOLOGY_CHANGED(theMG);
 
   return(0);
 }
@@ -3882,6 +3921,9 @@ INT NS_DIM_PREFIX DisposeMultiGrid (MULTIGRID *theMG)
 
   if (DisposeBottomHeapTmpMemory(theMG)) REP_ERR_RETURN(1);
 
+  /* the caches refer to the objects disposed below */
+  DisposeNodeAdjacency(theMG);
+
         #ifdef ModelP
   /* tell DDD that we will 'inconsistently' delete objects.
      this is a dangerous mode as it switches DDD warnings off. */
@@ -4006,6 +4048,7 @@ NODE * NS_DIM_PREFIX InsertInnerNode (GRID *theGrid, const DOUBLE *pos)
   /* fill data */
   for (i=0; i<DIM; i++) CVECT(theVertex)[i] = pos[i];
   SETMOVE(theVertex,DIM);
+  MG_TOPOLOGY_CHANGED(MYMG(theGrid));
 
   return(theNode);
 }
@@ -4071,6 +4114,7 @@ NODE * NS_DIM_PREFIX InsertBoundaryNode (GRID *theGrid, BNDP *bndp)
         #ifdef __THREEDIM__
   SetStringValue(":bndp2",ZC(theVertex));
         #endif
+  MG_TOPOLOGY_CHANGED(MYMG(theGrid));
 
   return(theNode);
 }
@@ -4120,6 +4164,7 @@ INT NS_DIM_PREFIX DeleteNode (GRID *theGrid, NODE *theNode)
 
   /* now allowed to delete */
   DisposeNode(theGrid,theNode);
+  MG_TOPOLOGY_CHANGED(MYMG(theGrid));
 
   return(GM_OK);
 }
@@ -4640,6 +4685,7 @@ ELEMENT * NS_DIM_PREFIX InsertElement (GRID *theGrid, INT n, NODE **Node, ELEMEN
 
   SET_EFATHER(theElement,NULL);
   SETECLASS(theElement,RED_CLASS);
+  MG_TOPOLOGY_CHANGED(MYMG(theGrid));
 
   return(theElement);
 }
@@ -4650,7 +4696,9 @@ ELEMENT * NS_DIM_PREFIX InsertElement (GRID *theGrid, INT n, NODE **Node, ELEMEN
  * @param   theMG - multigrid structure
  * @param   theElement - element to delete
 
-   This function deletes an element from level 0.
+   This function deletes an element from level 0. As long as the coarse
+   grid is not fixed, the sides of the neighbors are returned to the face
+   map of InsertElement, so that an element inserted there finds them.
 
    @return <ul>
    <li>   GM_OK if ok </li>
@@ -4685,6 +4733,18 @@ INT NS_DIM_PREFIX DeleteElement (MULTIGRID *theMG, ELEMENT *theElement) /* 3D VE
         {
           found++;
           SET_NBELEM(theNeighbor,j,NULL);
+
+          if (!MG_COARSE_FIXED(theMG))
+          {
+            MULTIGRID::FaceNodes faceNodes;
+            INT k;
+            for (k=0; k<CORNERS_OF_SIDE(theNeighbor,j); k++)
+              faceNodes[k] = CORNER(theNeighbor,CORNER_OF_SIDE(theNeighbor,j,k));
+            for (; k<MAX_CORNERS_OF_SIDE; k++)
+              faceNodes[k] = 0;
+            std::sort(faceNodes.begin(), faceNodes.begin()+CORNERS_OF_SIDE(theNeighbor,j));
+            theMG->facemap.emplace(faceNodes,std::make_pair(theNeighbor,j));
+          }
         }
       if (found!=1) RETURN(GM_ERROR);
     }
@@ -4692,6 +4752,7 @@ INT NS_DIM_PREFIX DeleteElement (MULTIGRID *theMG, ELEMENT *theElement) /* 3D VE
 
   /* delete element now */
   DisposeElement(theGrid,theElement,true);
+  MG_TOPOLOGY_CHANGED(theMG);
 
   return(GM_OK);
 }
@@ -4827,6 +4888,7 @@ INT NS_DIM_PREFIX InsertMesh (MULTIGRID *theMG, MESH *theMesh)
       }
       SETSUBDOMAIN(theElement,j);
     }
+  MG_TOPOLOGY_CHANGED(theMG);
 
   return(GM_OK);
 }
@@ -5055,7 +5117,7 @@ ELEMENT * NS_DIM_PREFIX FindElementOnSurface (MULTIGRID *theMG, DOUBLE *global)
   for (k=0; k<=TOPLEVEL(theMG); k++)
     for (t=FIRSTELEMENT(GRID_ON_LEVEL(theMG,k)); t!=NULL; t=SUCCE(t))
       if (EstimateHere(t))
-        if (PointInElement(global,t)) return(t);
+        if (PointInElementCached(theMG,global,t)) return(t);
 
   return(NULL);
 }
@@ -5883,14 +5945,17 @@ void NS_DIM_PREFIX ListGrids (const MULTIGRID *theMG)
         }
       }
   }
-  nn = UG_GlobalSumINT(theMG->ppifContext(), nn);
-  ne = UG_GlobalSumINT(theMG->ppifContext(), ne);
-  nt = UG_GlobalSumINT(theMG->ppifContext(), nt);
-  ns = UG_GlobalSumINT(theMG->ppifContext(), ns);
-  nvec = UG_GlobalSumINT(theMG->ppifContext(), nvec);
-  nc = UG_GlobalSumINT(theMG->ppifContext(), nc);
-  hmin = UG_GlobalMinDOUBLE(theMG->ppifContext(), hmin);
-  hmax = UG_GlobalMaxDOUBLE(theMG->ppifContext(), hmax);
+  {
+    /* the minimum is taken as maximum of the negated value */
+    INT counts[6] = {nn,ne,nt,ns,nvec,nc};
+    DOUBLE range[2] = {-hmin,hmax};
+
+    UG_GlobalSumNINT(theMG->ppifContext(), 6, counts);
+    UG_GlobalMaxNDOUBLE(theMG->ppifContext(), 2, range);
+    nn = counts[0]; ne = counts[1]; nt = counts[2];
+    ns = counts[3]; nvec = counts[4]; nc = counts[5];
+    hmin = -range[0]; hmax = range[1];
+  }
   UserWrite("\nsurface of all processors up to current level:\n");
   UserWriteF("%c %3d %8d %8s %8ld %8s %8ld %8ld %8ld %8s %9.3e %9.3e\n",
              ' ',minl,(int)cl,
@@ -5975,7 +6040,7 @@ void NS_DIM_PREFIX ListNode (const MULTIGRID *theMG, const NODE *theNode, INT da
 
     UserWriteF(" key=%d\n", KeyForObject((KEY_OBJECT *)theNode) );
 
-    if (NVECTOR(theNode) != NULL)
+    if (VEC_DEF_IN_OBJ_OF_MG(theMG,NODEVEC) && NVECTOR(theNode) != NULL)
       UserWriteF(" vec=" VINDEX_FMTX "\n",
                  VINDEX_PRTX(NVECTOR(theNode)));
 
@@ -7262,6 +7327,8 @@ INT NS_DIM_PREFIX FixCoarseGrid (MULTIGRID *theMG)
   if (CreateAlgebra(theMG) != GM_OK)
     REP_ERR_RETURN (GM_ERROR);
 
+  MG_TOPOLOGY_CHANGED(theMG);
+
   /* here all temp memory since CreateMultiGrid is released */
   ReleaseTmpMem(MGHEAP(theMG),MG_MARK_KEY(theMG));
   MG_MARK_KEY(theMG) = 0;
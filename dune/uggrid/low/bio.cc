@@ -37,14 +37,19 @@
 /****************************************************************************/
 
 #include <config.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #if HAVE_RPC_RPC_H
 #include <rpc/rpc.h>    /* to include xdr.h in a portable way */
 #endif // #if HAVE_RPC_RPC_H
 
 #include "bio.h"
+#include "threads.h"
 
 USING_UG_NAMESPACE
 
@@ -58,6 +63,14 @@ USING_UG_NAMESPACE
 /*                                                                          */
 /****************************************************************************/
 
+/* compressed binary mode */
+#define BIO_BLOCKSIZE           (1<<16)         /* raw bytes per block, offsets fit 16 bits */
+#define BIO_BLOCKMAGIC          "UGZB"          /* start of each block, never white space   */
+#define BIO_HASHBITS            12                      /* log2 of the match finder table size      */
+#define BIO_MINMATCH            4                       /* shortest match encoded                   */
+#define BIO_STORED                      1                       /* block flag: data is not compressed       */
+#define BIO_READAHEAD           4                       /* blocks read ahead per thread             */
+
 /****************************************************************************/
 /*                                                                          */
 /* data structures used in this source file (exported data structures are   */
@@ -65,6 +78,15 @@ USING_UG_NAMESPACE
 /*                                                                          */
 /****************************************************************************/
 
+/** \brief Header of a block of the compressed binary mode */
+typedef struct {
+  char magic[4];                        /* BIO_BLOCKMAGIC                   */
+  std::uint32_t rawSize;                /* bytes of uncompressed data       */
+  std::uint32_t size;                   /* bytes following the header       */
+  std::uint32_t checksum;               /* Adler-32 of the uncompressed data */
+  std::uint32_t flags;                  /* BIO_STORED                       */
+} BLOCK_HEADER;
+
 typedef int (*R_mint_proc)(int n, int *intList);
 typedef int (*W_mint_proc)(int n, const int *intList);
 typedef int (*R_mdouble_proc)(int n, double *doubleList);
@@ -100,6 +122,15 @@ static W_mdouble_proc Write_mdouble;
 static R_string_proc Read_string;
 static W_string_proc Write_string;
 
+/* compressed binary mode */
+static int cbin;                                                        /* stream is in compressed mode */
+static char direction;                                          /* 'r' or 'w' */
+static std::vector<unsigned char> block;        /* raw data of the current block */
+static std::size_t blockPos;                            /* read position in block */
+static std::vector<std::vector<unsigned char> > ahead;  /* blocks read ahead */
+static std::size_t aheadPos;                            /* next block in ahead */
+static BIO_STATISTICS statistics;
+
 
 /****************************************************************************/
 /*                                                                          */
@@ -358,6 +389,337 @@ static int BIN_Write_string (const char *string)
 
   return (0);
 }
+/****************************************************************************/
+/*                                                                          */
+/* compressed binary i/o                                                    */
+/*                                                                          */
+/* The data is collected in blocks of BIO_BLOCKSIZE bytes. Each block is    */
+/* compressed with a byte oriented LZ77 scheme (literal runs and matches    */
+/* of at least BIO_MINMATCH bytes at most 64k back) and written with a      */
+/* header holding sizes and an Adler-32 checksum of the uncompressed data.  */
+/* Jump markers are written between blocks, so sections can be skipped.     */
+/*                                                                          */
+/****************************************************************************/
+
+static double Seconds (void)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::uint32_t Adler32 (const unsigned char *data, std::size_t n)
+{
+  std::uint32_t a = 1, b = 0;
+
+  while (n>0)
+  {
+    /* largest number of bytes before b may overflow */
+    std::size_t m = (n<5552) ? n : 5552;
+
+    n -= m;
+    while (m-->0)
+    {
+      a += *data++;
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+
+  return ((b<<16) | a);
+}
+
+static std::size_t PutLength (unsigned char *out, std::size_t len)
+{
+  std::size_t o = 0;
+
+  while (len>=255)
+  {
+    out[o++] = 255;
+    len -= 255;
+  }
+  out[o++] = len;
+
+  return (o);
+}
+
+/* out needs room for n + n/255 + 16 bytes */
+static std::size_t Compress (const unsigned char *in, std::size_t n, unsigned char *out)
+{
+  std::int32_t table[1<<BIO_HASHBITS];
+  std::size_t i,anchor,o,lit,len,ref;
+  std::uint32_t seq;
+
+  for (i=0; i<(1<<BIO_HASHBITS); i++)
+    table[i] = -1;
+
+  i = anchor = o = 0;
+  while (i+BIO_MINMATCH<=n)
+  {
+    memcpy(&seq,in+i,sizeof(seq));
+    seq = (seq*2654435761u) >> (32-BIO_HASHBITS);
+    ref = table[seq];
+    table[seq] = i;
+
+    if (ref==(std::size_t)-1 || i-ref>0xFFFF || memcmp(in+ref,in+i,BIO_MINMATCH)!=0)
+    {
+      i++;
+      continue;
+    }
+
+    len = BIO_MINMATCH;
+    while (i+len<n && in[ref+len]==in[i+len])
+      len++;
+
+    /* token, literals, offset, match length */
+    lit = i-anchor;
+    out[o++] = ((lit<15 ? lit : 15)<<4) | (len-BIO_MINMATCH<15 ? len-BIO_MINMATCH : 15);
+    if (lit>=15) o += PutLength(out+o,lit-15);
+    memcpy(out+o,in+anchor,lit);
+    o += lit;
+    out[o++] = (i-ref) & 0xFF;
+    out[o++] = (i-ref) >> 8;
+    if (len-BIO_MINMATCH>=15) o += PutLength(out+o,len-BIO_MINMATCH-15);
+
+    i += len;
+    anchor = i;
+  }
+
+  /* the last sequence has literals only */
+  lit = n-anchor;
+  out[o++] = (lit<15 ? lit : 15)<<4;
+  if (lit>=15) o += PutLength(out+o,lit-15);
+  memcpy(out+o,in+anchor,lit);
+  o += lit;
+
+  return (o);
+}
+
+static int Decompress (const unsigned char *in, std::size_t n, unsigned char *out, std::size_t rawSize)
+{
+  std::size_t ip,op,lit,len,off;
+  unsigned char token,b;
+
+  ip = op = 0;
+  while (ip<n)
+  {
+    token = in[ip++];
+
+    lit = token>>4;
+    if (lit==15)
+      do {
+        if (ip>=n) return (1);
+        b = in[ip++];
+        lit += b;
+      } while (b==255);
+    if (ip+lit>n || op+lit>rawSize) return (1);
+    memcpy(out+op,in+ip,lit);
+    ip += lit;
+    op += lit;
+    if (ip==n) break;
+
+    if (ip+2>n) return (1);
+    off = in[ip] | (in[ip+1]<<8);
+    ip += 2;
+    len = (token & 15) + BIO_MINMATCH;
+    if ((token & 15)==15)
+      do {
+        if (ip>=n) return (1);
+        b = in[ip++];
+        len += b;
+      } while (b==255);
+    if (off==0 || off>op || op+len>rawSize) return (1);
+
+    /* matches may overlap the bytes they produce */
+    for (; len>0; len--, op++)
+      out[op] = out[op-off];
+  }
+
+  return ((op==rawSize) ? 0 : 1);
+}
+
+/* compress and write the current block */
+static int CBIN_Flush (void)
+{
+  BLOCK_HEADER header;
+  std::vector<unsigned char> out;
+  double start;
+
+  if (block.empty()) return (0);
+
+  start = Seconds();
+  out.resize(block.size() + block.size()/255 + 16);
+  out.resize(Compress(block.data(),block.size(),out.data()));
+
+  memcpy(header.magic,BIO_BLOCKMAGIC,sizeof(header.magic));
+  header.rawSize = block.size();
+  header.checksum = Adler32(block.data(),block.size());
+  header.flags = 0;
+  if (out.size()>=block.size())
+  {
+    out.swap(block);
+    header.flags |= BIO_STORED;
+  }
+  header.size = out.size();
+
+  if (fwrite(&header,sizeof(header),1,stream)!=1) return (1);
+  if (fwrite(out.data(),out.size(),1,stream)!=1) return (1);
+  n_byte += sizeof(header) + out.size();
+
+  statistics.rawBytes += header.rawSize;
+  statistics.fileBytes += sizeof(header) + out.size();
+  statistics.blocks++;
+  statistics.seconds += Seconds()-start;
+
+  block.clear();
+
+  return (0);
+}
+
+static int CBIN_Put (const void *data, std::size_t n)
+{
+  const unsigned char *p = (const unsigned char *)data;
+  std::size_t m;
+
+  while (n>0)
+  {
+    m = BIO_BLOCKSIZE - block.size();
+    if (m>n) m = n;
+    block.insert(block.end(),p,p+m);
+    p += m;
+    n -= m;
+    if (block.size()==BIO_BLOCKSIZE)
+      if (CBIN_Flush()) return (1);
+  }
+
+  return (0);
+}
+
+/* read the next blocks up to a jump marker or the end of the file and
+   decompress them on several threads */
+static int CBIN_Load (void)
+{
+  std::vector<BLOCK_HEADER> header;
+  std::vector<std::vector<unsigned char> > data;
+  std::atomic<int> error(0);
+  BLOCK_HEADER h;
+  fpos_t p;
+  double start;
+  std::size_t max;
+
+  start = Seconds();
+  max = GetNumberOfThreads()*BIO_READAHEAD;
+  while (header.size()<max)
+  {
+    if (fgetpos(stream,&p)) return (1);
+    if (fread(&h,sizeof(h),1,stream)!=1 || memcmp(h.magic,BIO_BLOCKMAGIC,sizeof(h.magic))!=0)
+    {
+      clearerr(stream);
+      if (fsetpos(stream,&p)) return (1);
+      break;
+    }
+    if (h.rawSize>BIO_BLOCKSIZE || h.size>BIO_BLOCKSIZE+BIO_BLOCKSIZE/255+16) return (1);
+    header.push_back(h);
+    data.emplace_back(h.size);
+    if (h.size>0 && fread(data.back().data(),h.size,1,stream)!=1) return (1);
+    statistics.fileBytes += sizeof(h) + h.size;
+  }
+  if (header.empty()) return (1);
+
+  ahead.resize(header.size());
+  aheadPos = 0;
+  ParallelForRange(header.size(), [&](std::size_t begin, std::size_t end, INT)
+                   {
+                     for (std::size_t i=begin; i<end; i++)
+                     {
+                       if (header[i].flags & BIO_STORED)
+                       {
+                         if (header[i].size!=header[i].rawSize) error = 1;
+                         ahead[i].swap(data[i]);
+                       }
+                       else
+                       {
+                         ahead[i].resize(header[i].rawSize);
+                         if (Decompress(data[i].data(),data[i].size(),ahead[i].data(),ahead[i].size())) error = 1;
+                       }
+                       if (Adler32(ahead[i].data(),ahead[i].size())!=header[i].checksum) error = 1;
+                     }
+                   }, 1);
+  if (error) return (1);
+
+  for (const auto& hh : header)
+    statistics.rawBytes += hh.rawSize;
+  statistics.blocks += header.size();
+  statistics.seconds += Seconds()-start;
+
+  return (0);
+}
+
+static int CBIN_Get (void *data, std::size_t n)
+{
+  unsigned char *p = (unsigned char *)data;
+  std::size_t m;
+
+  while (n>0)
+  {
+    if (blockPos==block.size())
+    {
+      if (aheadPos==ahead.size())
+        if (CBIN_Load()) return (1);
+      block.swap(ahead[aheadPos++]);
+      blockPos = 0;
+    }
+    m = block.size()-blockPos;
+    if (m>n) m = n;
+    memcpy(p,block.data()+blockPos,m);
+    blockPos += m;
+    p += m;
+    n -= m;
+  }
+
+  return (0);
+}
+
+static int CBIN_Read_mint (int n, int *intList)
+{
+  return (CBIN_Get(intList,sizeof(int)*n));
+}
+
+static int CBIN_Write_mint (int n, const int *intList)
+{
+  return (CBIN_Put(intList,sizeof(int)*n));
+}
+
+static int CBIN_Read_mdouble (int n, double *doubleList)
+{
+  return (CBIN_Get(doubleList,sizeof(double)*n));
+}
+
+static int CBIN_Write_mdouble (int n, const double *doubleList)
+{
+  return (CBIN_Put(doubleList,sizeof(double)*n));
+}
+
+static int CBIN_Read_string (char *string)
+{
+  int len;
+
+  if (CBIN_Get(&len,sizeof(int))) return (1);
+  if (len<0) return (1);
+  if (CBIN_Get(string,len)) return (1);
+  string[len] = '\0';
+
+  return (0);
+}
+
+static int CBIN_Write_string (const char *string)
+{
+  int len;
+
+  len = strlen(string);
+  if (CBIN_Put(&len,sizeof(int))) return (1);
+  return (CBIN_Put(string,len));
+}
+
 /****************************************************************************/
 /*                                                                          */
 /* exported i/o                                                             */
@@ -366,7 +728,17 @@ static int BIN_Write_string (const char *string)
 
 int NS_PREFIX Bio_Initialize (FILE *file, int mode, char rw)
 {
+  /* data of a compressed stream written before */
+  if (cbin && file==stream)
+    if (Bio_Flush()) return (1);
+
   stream = file;
+  direction = rw;
+  cbin = 0;
+  block.clear();
+  blockPos = 0;
+  ahead.clear();
+  aheadPos = 0;
 
   switch (mode)
   {
@@ -401,6 +773,17 @@ int NS_PREFIX Bio_Initialize (FILE *file, int mode, char rw)
     Write_mdouble = BIN_Write_mdouble;
     Write_string = BIN_Write_string;
     break;
+  case BIO_CBIN :
+    if (rw!='r' && rw!='w') return (1);
+    Read_mint       = CBIN_Read_mint;
+    Read_mdouble = CBIN_Read_mdouble;
+    Read_string = CBIN_Read_string;
+    Write_mint      = CBIN_Write_mint;
+    Write_mdouble = CBIN_Write_mdouble;
+    Write_string = CBIN_Write_string;
+    cbin = 1;
+    statistics = BIO_STATISTICS();
+    break;
   default :
     return (1);
   }
@@ -440,6 +823,8 @@ int NS_PREFIX Bio_Write_string (const char *string)
 
 int NS_PREFIX Bio_Jump_From (void)
 {
+  /* markers go between blocks, the jump counts the bytes of the blocks */
+  if (cbin && CBIN_Flush()) return (1);
   n_byte = 0;
   if (fgetpos(stream,&pos)) return (1);
   if (fprintf(stream," %20d ",n_byte)<0) return (1);
@@ -451,6 +836,7 @@ int NS_PREFIX Bio_Jump_To (void)
 {
   fpos_t act;
 
+  if (cbin && CBIN_Flush()) return (1);
   if (fgetpos(stream,&act)) return (1);
   if (fsetpos(stream,&pos)) return (1);
   if (fprintf(stream," %20d ",n_byte)<0) return (1);
@@ -463,6 +849,8 @@ int NS_PREFIX Bio_Jump (int dojump)
 {
   int jump;
 
+  /* the writer completed the block before the marker */
+  if (cbin && (blockPos!=block.size() || aheadPos!=ahead.size())) return (1);
   if (fscanf(stream," %20d ",&jump)!=1) return (1);
   if (dojump==0) return (0);
   while(jump>0)
@@ -474,4 +862,18 @@ int NS_PREFIX Bio_Jump (int dojump)
   return (0);
 }
 
+int NS_PREFIX Bio_Flush (void)
+{
+  if (cbin && direction=='w') return (CBIN_Flush());
+
+  return (0);
+}
+
+int NS_PREFIX Bio_Statistics (BIO_STATISTICS *stat)
+{
+  *stat = statistics;
+
+  return (0);
+}
+
 /** @} */
@@ -65,6 +65,7 @@ START_UG_NAMESPACE
 #define BIO_XDR                                 0
 #define BIO_ASCII                                       1
 #define BIO_BIN                                         2
+#define BIO_CBIN                                        3       /* binary, block compressed */
 
 /****************************************************************************/
 /*                                                                          */
@@ -72,6 +73,14 @@ START_UG_NAMESPACE
 /*                                                                          */
 /****************************************************************************/
 
+/** \brief Work of the compressed mode since the stream was initialized */
+typedef struct {
+  double rawBytes;                      /* uncompressed bytes written or read */
+  double fileBytes;                     /* bytes of the blocks in the file    */
+  double seconds;                       /* time spent on blocks, incl. i/o    */
+  int blocks;                           /* number of blocks                   */
+} BIO_STATISTICS;
+
 /****************************************************************************/
 /*                                                                          */
 /* definition of exported global variables                                  */
@@ -97,6 +106,8 @@ int Bio_Write_string            (const char *string);
 int Bio_Jump_From                       (void);
 int Bio_Jump_To                         (void);
 int Bio_Jump                            (int dojump);
+int Bio_Flush                           (void);
+int Bio_Statistics                      (BIO_STATISTICS *stat);
 
 
 END_UG_NAMESPACE
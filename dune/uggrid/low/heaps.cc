@@ -108,6 +108,7 @@ HEAP *NS_PREFIX NewHeap (enum HeapType type, MEM size, void *buffer)
   theHeap->type = type;
   theHeap->size = size;
   theHeap->markKey = 0;
+  memset(theHeap->stat,0,sizeof(theHeap->stat));
 
   /* No constructor is ever called for theHeap.  Consequently, no constructor
    * has been called for its member markedMemory, either.  Here we force this
@@ -97,6 +97,13 @@ enum {HEAP_FULL =           1,           /**< Return code if storage exhausted
 #define BLOCK_NOT_DEFINED    1
 
 /* @} */
+
+/** \brief Number of accounting classes of a heap (see HEAP_STAT) */
+#define MAXHEAPSTAT        40
+
+/** \brief Accounting record of class c of a heap */
+#define HEAPSTAT(h,c)      (&((h)->stat[c]))
+
 /****************************************************************************/
 /*                                                                          */
 /* data structures exported by the corresponding source file                */
@@ -109,10 +116,24 @@ typedef unsigned long MEM;
 /* structs and typedefs for the simple and general heap management          */
 /****************************************************************************/
 
+/** \brief Current and peak memory usage of one accounting class
+
+   The users of a heap decide what a class is: the grid manager uses its
+   object types, the domain module the last two classes for boundary
+   points and sides.
+ */
+typedef struct {
+  MEM bytes;                      /**< Bytes currently allocated         */
+  MEM peakBytes;                  /**< High-water mark of bytes          */
+  MEM objects;                    /**< Objects currently allocated       */
+  MEM peakObjects;                /**< High-water mark of objects        */
+} HEAP_STAT;
+
 typedef struct {
   enum HeapType type;
   MEM size;
   INT markKey;
+  HEAP_STAT stat[MAXHEAPSTAT];
   std::vector<void*> markedMemory[MARK_STACK_SIZE+1];
 } HEAP;
 
@@ -146,6 +167,29 @@ INT          ReleaseTmpMem          (HEAP *theHeap, INT key);
 }
 /* @} */
 
+/** @name Memory accounting */
+/* @{ */
+/** \brief Record the allocation of one object of n bytes */
+inline void HeapStatAlloc (HEAP_STAT *s, MEM n)
+{
+  s->bytes += n;
+  s->objects++;
+  if (s->bytes > s->peakBytes) s->peakBytes = s->bytes;
+  if (s->objects > s->peakObjects) s->peakObjects = s->objects;
+}
+
+/** \brief Record the release of one object of n bytes
+
+   Saturates at zero, so objects which were allocated before the
+   accounting started (or from another heap) do not wrap the counters.
+ */
+inline void HeapStatFree (HEAP_STAT *s, MEM n)
+{
+  s->bytes -= (n < s->bytes) ? n : s->bytes;
+  if (s->objects > 0) s->objects--;
+}
+/* @} */
+
 END_UG_NAMESPACE
 
 /** @} */
@@ -0,0 +1,104 @@
+#include "config.h"
+
+#include <cstdio>
+#include <vector>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "../bio.h"
+
+using namespace Dune;
+
+namespace {
+
+/* refinement-like records: small, repetitive integers */
+std::vector<int> records(int n)
+{
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i)
+    v[i] = (i % 7 == 0) ? i : (i % 13);
+  return v;
+}
+
+} /* namespace */
+
+TestSuite test_compressed_roundtrip()
+{
+  TestSuite test;
+
+  using namespace UG;
+
+  const int n = 100000;
+  auto ints = records(n);
+  std::vector<double> doubles(1000);
+  for (std::size_t i = 0; i < doubles.size(); ++i)
+    doubles[i] = 0.5 * i;
+  std::vector<int> skipped(5000, 42);
+
+  FILE* file = std::tmpfile();
+  test.require(file != nullptr, "require a temporary file");
+
+  test.require(!Bio_Initialize(file, BIO_CBIN, 'w'), "initialize compressed writing");
+  test.check(!Bio_Write_string("header"), "write string");
+  test.check(!Bio_Write_mint(n, ints.data()), "write ints");
+  test.check(!Bio_Jump_From(), "start jump section");
+  test.check(!Bio_Write_mint(skipped.size(), skipped.data()), "write skipped ints");
+  test.check(!Bio_Jump_To(), "end jump section");
+  test.check(!Bio_Write_mdouble(doubles.size(), doubles.data()), "write doubles");
+  test.check(!Bio_Flush(), "flush last block");
+
+  BIO_STATISTICS stat;
+  Bio_Statistics(&stat);
+  test.check(stat.blocks > 1, "data spans several blocks");
+  test.check(stat.fileBytes < stat.rawBytes / 2, "records compress well");
+
+  for (int jump = 0; jump <= 1; ++jump)
+  {
+    std::rewind(file);
+    test.require(!Bio_Initialize(file, BIO_CBIN, 'r'), "initialize compressed reading");
+
+    char string[64];
+    test.check(!Bio_Read_string(string) && std::string(string) == "header", "read string");
+
+    std::vector<int> readInts(n);
+    test.check(!Bio_Read_mint(n, readInts.data()) && readInts == ints, "read ints");
+
+    test.check(!Bio_Jump(jump), "read jump marker");
+    if (!jump)
+    {
+      std::vector<int> readSkipped(skipped.size());
+      test.check(!Bio_Read_mint(readSkipped.size(), readSkipped.data()) && readSkipped == skipped,
+                 "read section which is not skipped");
+    }
+
+    std::vector<double> readDoubles(doubles.size());
+    test.check(!Bio_Read_mdouble(readDoubles.size(), readDoubles.data()) && readDoubles == doubles,
+               "read doubles after the section");
+  }
+
+  /* corrupt a byte in the middle of the first block */
+  std::fseek(file, 100, SEEK_SET);
+  int c = std::fgetc(file);
+  std::fseek(file, 100, SEEK_SET);
+  std::fputc(c ^ 0x55, file);
+
+  std::rewind(file);
+  test.require(!Bio_Initialize(file, BIO_CBIN, 'r'), "initialize compressed reading");
+  char string[64];
+  std::vector<int> readInts(n);
+  test.check(Bio_Read_string(string) || Bio_Read_mint(n, readInts.data()),
+             "corrupted block is detected");
+
+  std::fclose(file);
+
+  return test;
+}
+
+int main()
+{
+  TestSuite test;
+
+  test.subTest(test_compressed_roundtrip());
+
+  return test.exit();
+}
@@ -0,0 +1,44 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief Thread count used by the threaded kernels of UG
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*              system include files                                        */
+/*              application include files                                   */
+/*                                                                          */
+/****************************************************************************/
+
+#include <config.h>
+
+#include <thread>
+
+#include "threads.h"
+
+USING_UG_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+static INT theNumberOfThreads = 0;
+
+
+INT NS_PREFIX GetNumberOfThreads ()
+{
+  if (theNumberOfThreads > 0)
+    return theNumberOfThreads;
+
+  const INT n = std::thread::hardware_concurrency();
+  return (n > 0) ? n : 1;
+}
+
+void NS_PREFIX SetNumberOfThreads (INT n)
+{
+  theNumberOfThreads = (n > 0) ? n : 0;
+}
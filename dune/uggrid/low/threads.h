@@ -0,0 +1,78 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief Minimal helpers for running loops on several threads
+ */
+
+/****************************************************************************/
+/*                                                                          */
+/* File:      threads.h                                                     */
+/*                                                                          */
+/* Purpose:   static partitioning of index ranges onto worker threads       */
+/*                                                                          */
+/* Remarks:   UG itself is not thread safe. These helpers are only used     */
+/*            for kernels which read the grid and write to disjoint,        */
+/*            preallocated output ranges.                                   */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef __UGTHREADS__
+#define __UGTHREADS__
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "ugtypes.h"
+
+#include "namespace.h"
+
+START_UG_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* function declarations                                                    */
+/*                                                                          */
+/****************************************************************************/
+
+/** \brief Number of threads used by threaded kernels (at least 1) */
+INT     GetNumberOfThreads (void);
+
+/** \brief Set the number of threads, 0 selects the hardware concurrency */
+void    SetNumberOfThreads (INT n);
+
+/** \brief Split [0,n) into contiguous chunks and call f(begin,end,thread) for each
+
+   Ranges smaller than minChunk per thread are processed on fewer threads,
+   a single chunk runs on the calling thread.
+ */
+template<class F>
+void ParallelForRange (std::size_t n, F&& f, std::size_t minChunk = 1024)
+{
+  std::size_t nThreads = GetNumberOfThreads();
+  nThreads = std::max<std::size_t>(1, std::min(nThreads, n/std::max<std::size_t>(minChunk,1)));
+
+  if (nThreads == 1)
+  {
+    f(std::size_t(0), n, INT(0));
+    return;
+  }
+
+  const std::size_t chunk = (n + nThreads - 1) / nThreads;
+  std::vector<std::thread> workers;
+  workers.reserve(nThreads-1);
+  for (std::size_t t=1; t<nThreads; t++)
+  {
+    const std::size_t begin = std::min(n, t*chunk);
+    const std::size_t end = std::min(n, begin+chunk);
+    workers.emplace_back([&f,begin,end,t]() { f(begin, end, INT(t)); });
+  }
+  f(std::size_t(0), std::min(n, chunk), INT(0));
+  for (auto& w : workers)
+    w.join();
+}
+
+END_UG_NAMESPACE
+
+#endif
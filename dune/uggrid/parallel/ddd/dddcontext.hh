@@ -80,6 +80,10 @@ struct IfCreateContext
 struct IfUseContext
 {
   int send_mesgs;
+
+  /** parts registered since DDD_IFMultiBegin */
+  std::vector<IF_MULTI_PART> multiParts;
+  bool multiActive = false;
 };
 
 } /* namespace If */
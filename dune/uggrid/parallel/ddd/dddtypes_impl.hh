@@ -116,6 +116,43 @@ struct ELEM_DESC
 };
 
 
+struct TYPE_DESC;
+
+/**
+ * \brief single object reference inside a DDD object structure
+ *
+ * Pointer arrays of EL_OBJPTR elements are flattened into one slot
+ * per pointer when the type is defined, so that pack and unpack need
+ * not walk the element list.
+ */
+struct PTR_SLOT
+{
+  /** offset of the pointer from object address */
+  int offset;
+
+  /** description of referenced type, nullptr for DDD_TYPE_BY_HANDLER */
+  const TYPE_DESC* refdesc;
+
+  /** handler determining the referenced type, if refdesc is nullptr */
+  HandlerGetRefType reftypeHandler;
+};
+
+/**
+ * \brief contiguous range of a copy-mask with the same kind of mask bytes
+ */
+struct COPY_RUN
+{
+  /** offset of the range in the object */
+  std::size_t offset;
+
+  /** length of the range in bytes */
+  std::size_t size;
+
+  /** false: all bytes are copied, true: bytes are blended with the copy-mask */
+  bool masked;
+};
+
+
 /**
  * \brief single DDD object structure description
  */
@@ -180,6 +217,12 @@ struct TYPE_DESC
 
   /** mask for fast type-dependent copy    */
   std::unique_ptr<unsigned char[]> cmask;
+
+  /** copy-mask compiled into ranges, ranges of dont-copy bytes are omitted */
+  std::vector<COPY_RUN> copyRuns;
+
+  /** object references, one per pointer of all EL_OBJPTR elements */
+  std::vector<PTR_SLOT> ptrSlots;
 };
 
 namespace Basic {
@@ -232,6 +275,28 @@ struct IF_ATTR
     { /* Nothing */ }
 };
 
+/**
+ * one gather/scatter pair of a fused interface communication,
+ * see DDD_IFMultiBegin
+ */
+struct IF_MULTI_PART
+{
+  DDD_IF ifId;
+  bool withAttr;
+  DDD_ATTR attr;
+
+  /** 0 for exchange, IF_FORWARD or IF_BACKWARD for oneway */
+  int dir;
+  std::size_t size;
+
+  /** only send the items whose gather handler returns nonzero */
+  bool delta = false;
+
+  /** either the plain or the extended handlers are set */
+  ComProcPtr2 gather = nullptr, scatter = nullptr;
+  ComProcXPtr gatherX = nullptr, scatterX = nullptr;
+};
+
 /**
  * descriptor of message and its contents/buffers for IF-communic.
  */
@@ -879,6 +879,7 @@ static size_t IFInfoMemory(const DDD::DDDContext& context, DDD_IF ifId)
   for(const IF_PROC* ifp=theIF[ifId].ifHead; ifp != nullptr; ifp=ifp->next)
   {
     sum += sizeof(IF_ATTR) * ifp->nAttrs;              /* component ifAttr */
+    sum += ifp->bufIn.capacity() + ifp->bufOut.capacity(); /* message buffers */
   }
 
   return(sum);
@@ -0,0 +1,558 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/****************************************************************************/
+/*                                                                          */
+/* File:      ifmulti.cc                                                    */
+/*                                                                          */
+/* Purpose:   routines concerning interfaces between processors             */
+/*            part 3: fused communication of several gather/scatter pairs   */
+/*                                                                          */
+/* Remarks:   All parts registered between DDD_IFMultiBegin and             */
+/*            DDD_IFMultiEnd are sent in one message per neighbour proc.    */
+/*            The message holds the data of the parts one after another,    */
+/*            each in the order the single interface functions use.         */
+/*            The parts may use different interfaces. Gather handlers of    */
+/*            later parts must not depend on scatters of earlier ones.      */
+/*            Delta parts only send the items whose gather reports a        */
+/*            change, so the receive buffers are sized for all items.       */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/* include files                                                            */
+/*            system include files                                          */
+/*            application include files                                     */
+/*                                                                          */
+/****************************************************************************/
+
+/* standard C library */
+#include <config.h>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#include <iomanip>
+#include <map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/stdstreams.hh>
+
+#include <dune/uggrid/parallel/ddd/dddcontext.hh>
+
+#include <dune/uggrid/parallel/ddd/dddi.h>
+#include "if.h"
+
+using namespace PPIF;
+
+START_UGDIM_NAMESPACE
+
+/****************************************************************************/
+/*                                                                          */
+/* data structures                                                          */
+/*                                                                          */
+/****************************************************************************/
+
+namespace {
+
+/* the message to or from one proc, shared by all parts */
+struct MULTI_MSG
+{
+  VChannelPtr vc;
+  std::size_t sizeIn = 0;
+  std::vector<char> bufIn, bufOut;
+  msgid msgIn = NO_MSGID, msgOut = NO_MSGID;
+};
+
+/* one list of couplings of an IF_PROC or IF_ATTR */
+struct MULTI_LIST
+{
+  COUPLING **cpl;
+  IFObjPtr *obj;
+  int n;
+};
+
+} /* namespace */
+
+/****************************************************************************/
+/*                                                                          */
+/* routines                                                                 */
+/*                                                                          */
+/****************************************************************************/
+
+
+/*
+        the coupling lists of one part in the order of ifcmd.ct,
+        returns the number of lists
+ */
+template<class PART>
+static int MultiLists (const IF_MULTI_PART& p, const PART *part, bool recv, MULTI_LIST lists[3])
+{
+  const MULTI_LIST ab  = { part->cplAB,  part->objAB,  part->nAB };
+  const MULTI_LIST ba  = { part->cplBA,  part->objBA,  part->nBA };
+  const MULTI_LIST aba = { part->cplABA, part->objABA, part->nABA };
+  int n = 0;
+
+  if (p.dir==0)
+  {
+    /* exchange BA and AB during send */
+    lists[n++] = recv ? ab : ba;
+    lists[n++] = recv ? ba : ab;
+  }
+  else
+  {
+    const bool forward = (p.dir==IF_FORWARD);
+    lists[n++] = (forward != recv) ? ab : ba;
+  }
+  lists[n++] = aba;
+
+  return n;
+}
+
+
+/*
+        the coupling lists of one part for one proc, restricted to the
+        attr of the part, returns the number of lists
+ */
+static int MultiProcLists (const IF_MULTI_PART& p, const IF_PROC *ifHead, bool recv, MULTI_LIST lists[3])
+{
+  if (!p.withAttr)
+    return MultiLists(p, ifHead, recv, lists);
+
+  for (const IF_ATTR *ifAttr=ifHead->ifAttr; ifAttr!=NULL; ifAttr=ifAttr->next)
+    if (ifAttr->attr==p.attr)
+      return MultiLists(p, ifAttr, recv, lists);
+
+  return 0;
+}
+
+
+static std::size_t MultiItems (const MULTI_LIST lists[3], int nLists)
+{
+  std::size_t items = 0;
+
+  for (int i=0; i<nLists; i++)
+    items += lists[i].n;
+
+  return items;
+}
+
+
+/*
+        calls the gather or scatter handler of a part for item i of a list,
+        returns the result of the handler
+ */
+static int MultiItem (DDD::DDDContext& context, const IF_MULTI_PART& p,
+                      const MULTI_LIST& list, int i, bool recv, char *buffer)
+{
+  if (p.gatherX!=nullptr)
+  {
+    COUPLING *cpl = list.cpl[i];
+    return (recv ? p.scatterX : p.gatherX)(context, OBJ_OBJ(context, cpl->obj),
+                                           buffer, CPL_PROC(cpl), cpl->prio);
+  }
+
+  return (recv ? p.scatter : p.gather)(context, list.obj[i], buffer);
+}
+
+
+/*
+        size of the data of one part for one proc, calls the
+        gather or scatter handlers for all items if buffer is not NULL
+ */
+static std::size_t MultiComm (DDD::DDDContext& context, const IF_MULTI_PART& p,
+                              const MULTI_LIST lists[3], int nLists, bool recv, char *buffer)
+{
+  for (int i=0; i<nLists && buffer!=NULL; i++)
+  {
+    if (p.gatherX!=nullptr)
+      buffer = IFCommLoopCplX(context, recv ? p.scatterX : p.gatherX,
+                              lists[i].cpl, buffer, p.size, lists[i].n);
+    else
+      buffer = IFCommLoopObj(context, recv ? p.scatter : p.gather,
+                             lists[i].obj, buffer, p.size, lists[i].n);
+  }
+
+  return MultiItems(lists, nLists)*p.size;
+}
+
+
+/*
+        maximum size of the data of one part for one proc on the
+        receiving side. A delta part sends the number n of changed
+        items, their positions in the lists and their data; nothing
+        if the lists are empty.
+ */
+static std::size_t MultiRecvSize (const IF_MULTI_PART& p, const MULTI_LIST lists[3], int nLists)
+{
+  const std::size_t items = MultiItems(lists, nLists);
+
+  if (!p.delta || items==0)
+    return items*p.size;
+
+  return sizeof(int)*(1+items) + items*p.size;
+}
+
+
+/*
+        appends the data of one part for one proc to a message
+ */
+static void MultiGather (DDD::DDDContext& context, const IF_MULTI_PART& p,
+                         const MULTI_LIST lists[3], int nLists, std::vector<char>& buf)
+{
+  const std::size_t items = MultiItems(lists, nLists);
+
+  if (!p.delta)
+  {
+    const std::size_t pos = buf.size();
+    buf.resize(pos + items*p.size);
+    MultiComm(context, p, lists, nLists, false, buf.data()+pos);
+    return;
+  }
+  if (items==0)
+    return;
+
+  /* gather each item, keep it if the handler reports a change */
+  std::vector<int> index;
+  std::vector<char> data(items*p.size);
+  int k = 0;
+  for (int i=0; i<nLists; i++)
+    for (int j=0; j<lists[i].n; j++, k++)
+      if (MultiItem(context, p, lists[i], j, false, data.data() + index.size()*p.size))
+        index.push_back(k);
+
+  const int n = index.size();
+  const char *nBytes = reinterpret_cast<const char*>(&n);
+  const char *indexBytes = reinterpret_cast<const char*>(index.data());
+  buf.insert(buf.end(), nBytes, nBytes+sizeof(int));
+  buf.insert(buf.end(), indexBytes, indexBytes+n*sizeof(int));
+  buf.insert(buf.end(), data.data(), data.data()+n*p.size);
+}
+
+
+/*
+        scatters the data of one part for one proc from a message,
+        returns the number of bytes read
+ */
+static std::size_t MultiScatter (DDD::DDDContext& context, const IF_MULTI_PART& p,
+                                 const MULTI_LIST lists[3], int nLists, char *buffer)
+{
+  if (!p.delta)
+    return MultiComm(context, p, lists, nLists, true, buffer);
+  if (MultiItems(lists, nLists)==0)
+    return 0;
+
+  int n;
+  std::memcpy(&n, buffer, sizeof(int));
+  std::vector<int> index(n);
+  std::memcpy(index.data(), buffer+sizeof(int), n*sizeof(int));
+  char *data = buffer + sizeof(int)*(1+n);
+
+  for (int k=0; k<n; k++, data+=p.size)
+  {
+    int i = 0, j = index[k];
+    while (j>=lists[i].n)
+      j -= lists[i++].n;
+    MultiItem(context, p, lists[i], j, true, data);
+  }
+
+  return sizeof(int)*(1+n) + n*p.size;
+}
+
+
+static void MultiAdd (DDD::DDDContext& context, const IF_MULTI_PART& p)
+{
+  auto& ctx = context.ifUseContext();
+
+  if (!ctx.multiActive)
+    DUNE_THROW(Dune::Exception, "missing DDD_IFMultiBegin");
+
+  /* prohibit using standard interface (IF0) */
+  if (p.ifId==STD_INTERFACE)
+    DUNE_THROW(Dune::Exception, "cannot use standard interface");
+
+  ctx.multiParts.push_back(p);
+}
+
+
+/****************************************************************************/
+
+/**
+        Start the registration of a fused interface communication.
+        The gather/scatter pairs registered by the DDD_IFMulti functions
+        are not executed immediately, but all together in
+        \funk{IFMultiEnd}, which needs only one message per neighbour
+        proc instead of one per pair. All processors have to register
+        the same sequence of parts.
+ */
+
+void DDD_IFMultiBegin (DDD::DDDContext& context)
+{
+  auto& ctx = context.ifUseContext();
+
+  if (ctx.multiActive)
+    DUNE_THROW(Dune::Exception, "DDD_IFMultiBegin called twice");
+
+  ctx.multiActive = true;
+  ctx.multiParts.clear();
+}
+
+
+static IF_MULTI_PART MultiPart (DDD_IF aIF, bool withAttr, DDD_ATTR aAttr, int aDir, size_t aSize)
+{
+  IF_MULTI_PART p;
+  p.ifId = aIF;
+  p.withAttr = withAttr;
+  p.attr = aAttr;
+  p.dir = aDir;
+  p.size = aSize;
+  return p;
+}
+
+
+/** Register a part like \funk{IFExchange} */
+void DDD_IFMultiExchange (DDD::DDDContext& context, DDD_IF aIF, size_t aSize,
+                          ComProcPtr2 Gather, ComProcPtr2 Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,false,0,0,aSize);
+  p.gather = Gather; p.scatter = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFOneway} */
+void DDD_IFMultiOneway (DDD::DDDContext& context, DDD_IF aIF, DDD_IF_DIR aDir, size_t aSize,
+                        ComProcPtr2 Gather, ComProcPtr2 Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,false,0,aDir,aSize);
+  p.gather = Gather; p.scatter = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFAExchange} */
+void DDD_IFMultiAExchange (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, size_t aSize,
+                           ComProcPtr2 Gather, ComProcPtr2 Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,0,aSize);
+  p.gather = Gather; p.scatter = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFAOneway} */
+void DDD_IFMultiAOneway (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, DDD_IF_DIR aDir, size_t aSize,
+                         ComProcPtr2 Gather, ComProcPtr2 Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,aDir,aSize);
+  p.gather = Gather; p.scatter = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFExchangeX} */
+void DDD_IFMultiExchangeX (DDD::DDDContext& context, DDD_IF aIF, size_t aSize,
+                           ComProcXPtr Gather, ComProcXPtr Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,false,0,0,aSize);
+  p.gatherX = Gather; p.scatterX = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFOnewayX} */
+void DDD_IFMultiOnewayX (DDD::DDDContext& context, DDD_IF aIF, DDD_IF_DIR aDir, size_t aSize,
+                         ComProcXPtr Gather, ComProcXPtr Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,false,0,aDir,aSize);
+  p.gatherX = Gather; p.scatterX = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFAExchangeX} */
+void DDD_IFMultiAExchangeX (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, size_t aSize,
+                            ComProcXPtr Gather, ComProcXPtr Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,0,aSize);
+  p.gatherX = Gather; p.scatterX = Scatter;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFAOnewayX} */
+void DDD_IFMultiAOnewayX (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, DDD_IF_DIR aDir, size_t aSize,
+                          ComProcXPtr Gather, ComProcXPtr Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,aDir,aSize);
+  p.gatherX = Gather; p.scatterX = Scatter;
+  MultiAdd(context, p);
+}
+
+/**
+        Register a part like \funk{IFAOneway}, but send only the items
+        whose gather handler returns nonzero, together with their
+        positions in the interface. For the other items the scatter
+        handler is not called, so they must not carry any information
+        the receiver does not have already.
+ */
+void DDD_IFMultiAOnewayDelta (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, DDD_IF_DIR aDir, size_t aSize,
+                              ComProcPtr2 Gather, ComProcPtr2 Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,aDir,aSize);
+  p.gather = Gather; p.scatter = Scatter;
+  p.delta = true;
+  MultiAdd(context, p);
+}
+
+/** Register a part like \funk{IFMultiAOnewayDelta} with extended handlers */
+void DDD_IFMultiAOnewayDeltaX (DDD::DDDContext& context, DDD_IF aIF, DDD_ATTR aAttr, DDD_IF_DIR aDir, size_t aSize,
+                               ComProcXPtr Gather, ComProcXPtr Scatter)
+{
+  IF_MULTI_PART p = MultiPart(aIF,true,aAttr,aDir,aSize);
+  p.gatherX = Gather; p.scatterX = Scatter;
+  p.delta = true;
+  MultiAdd(context, p);
+}
+
+/****************************************************************************/
+
+/**
+        Execute the fused interface communication.
+        For each neighbour proc of any registered part one message is
+        built by calling the gather handlers of all parts in the order
+        of registration. The received messages are scattered in the
+        same order.
+ */
+
+void DDD_IFMultiEnd (DDD::DDDContext& context)
+{
+  using std::setw;
+
+  auto& ctx = context.ifUseContext();
+  std::map<DDD_PROC, MULTI_MSG> msgs;
+  IF_PROC *ifHead;
+
+  if (!ctx.multiActive)
+    DUNE_THROW(Dune::Exception, "missing DDD_IFMultiBegin");
+  ctx.multiActive = false;
+
+  const std::vector<IF_MULTI_PART> parts = std::move(ctx.multiParts);
+  ctx.multiParts.clear();
+
+  /* compute the sizes of the receive buffers, an upper bound for delta parts */
+  for (const auto& p : parts)
+  {
+    /* shortcuts can only be used without extended handler arguments */
+    if (p.gatherX==nullptr)
+      IFCheckShortcuts(context, p.ifId);
+
+    ForIF(context, p.ifId, ifHead)
+    {
+      MULTI_LIST lists[3];
+      const int nLists = MultiProcLists(p, ifHead, true, lists);
+      MULTI_MSG& m = msgs[ifHead->proc];
+      m.vc = ifHead->vc;
+      m.sizeIn += MultiRecvSize(p, lists, nLists);
+    }
+  }
+
+  /* initiate receives */
+  int recv_mesgs = 0;
+  for (auto& [proc, m] : msgs)
+  {
+    int error;
+
+    if (m.sizeIn==0)
+      continue;
+
+    m.bufIn.assign(m.sizeIn, 0);
+    m.msgIn = RecvASync(context.ppifContext(), m.vc, m.bufIn.data(), m.sizeIn, &error);
+    if (m.msgIn==NO_MSGID)
+      DUNE_THROW(Dune::Exception, "RecvASync() failed");
+    recv_mesgs++;
+  }
+
+  /* build messages using the gather handlers and send them away */
+  for (const auto& p : parts)
+  {
+    ForIF(context, p.ifId, ifHead)
+    {
+      MULTI_LIST lists[3];
+      const int nLists = MultiProcLists(p, ifHead, false, lists);
+      MultiGather(context, p, lists, nLists, msgs[ifHead->proc].bufOut);
+    }
+  }
+
+  int send_mesgs = 0;
+  for (auto& [proc, m] : msgs)
+  {
+    int error;
+
+    if (m.bufOut.empty())
+      continue;
+
+    m.msgOut = SendASync(context.ppifContext(), m.vc, m.bufOut.data(), m.bufOut.size(), &error);
+    if (m.msgOut==NO_MSGID)
+      DUNE_THROW(Dune::Exception, "SendASync() failed");
+    send_mesgs++;
+  }
+
+  /* poll receives and scatter data */
+  unsigned long tries;
+  for(tries=0; tries<MAX_TRIES && recv_mesgs>0; tries++)
+  {
+    for (auto& [proc, m] : msgs)
+    {
+      if (m.msgIn==NO_MSGID)
+        continue;
+
+      int error = InfoARecv(context.ppifContext(), m.vc, m.msgIn);
+      if (error==-1)
+        DUNE_THROW(Dune::Exception, "InfoARecv failed for recv to proc=" << proc);
+      if (error!=1)
+        continue;
+
+      recv_mesgs--;
+      m.msgIn = NO_MSGID;
+
+      char *buffer = m.bufIn.data();
+      for (const auto& p : parts)
+      {
+        ForIF(context, p.ifId, ifHead)
+        {
+          if (ifHead->proc==proc)
+          {
+            MULTI_LIST lists[3];
+            const int nLists = MultiProcLists(p, ifHead, true, lists);
+            buffer += MultiScatter(context, p, lists, nLists, buffer);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (recv_mesgs>0)
+    Dune::dwarn << "DDD_IFMultiEnd: receive-timeout, " << recv_mesgs << " messages missing\n";
+
+  /* finally poll send completion */
+  for(tries=0; tries<MAX_TRIES && send_mesgs>0; tries++)
+  {
+    for (auto& [proc, m] : msgs)
+    {
+      if (m.msgOut==NO_MSGID)
+        continue;
+
+      int error = InfoASend(context.ppifContext(), m.vc, m.msgOut);
+      if (error==-1)
+        DUNE_THROW(Dune::Exception, "InfoASend() failed for send to proc=" << proc);
+      if (error==1)
+      {
+        send_mesgs--;
+        m.msgOut = NO_MSGID;
+      }
+    }
+  }
+
+  if (send_mesgs>0)
+    Dune::dwarn << "DDD_IFMultiEnd: send-timeout, " << send_mesgs << " messages pending\n";
+}
+
+/****************************************************************************/
+
+END_UGDIM_NAMESPACE
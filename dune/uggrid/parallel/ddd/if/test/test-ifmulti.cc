@@ -0,0 +1,333 @@
+#include "config.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/uggrid/parallel/ddd/dddcontext.hh>
+#include <dune/uggrid/parallel/ddd/include/ddd.h>
+#include <dune/uggrid/parallel/ppif/ppifcontext.hh>
+
+USING_UGDIM_NAMESPACE
+
+using Dune::TestSuite;
+
+namespace {
+
+const DDD_PRIO PRIO_A = 1;
+const DDD_PRIO PRIO_B = 2;
+const int N_ITEMS = 24;
+
+/* every item is identified with the item of the same number on all other
+   procs, its priority and attr depend on the proc and the number */
+struct Item
+{
+  DDD_HEADER ddd;
+  int number;
+  int value;
+  int received;
+  int calls;
+  int exchanged;
+  int exchangeCalls;
+  int wrongNumbers;
+};
+
+DDD_PRIO ItemPrio (int proc, int number)
+{
+  return ((number+proc)%3==0) ? PRIO_A : PRIO_B;
+}
+
+DDD_ATTR ItemAttr (int number)
+{
+  return 1 + number%2;
+}
+
+int ItemValue (int proc, int number)
+{
+  return 1000*(proc+1) + number;
+}
+
+struct Setup
+{
+  std::shared_ptr<DDD::DDDContext> context;
+  std::vector<Item> items;
+  DDD_IF oneway, exchange;
+
+  Setup ()
+    : items(N_ITEMS)
+  {
+    context = std::make_shared<DDD::DDDContext>(std::make_shared<PPIF::PPIFContext>(), nullptr);
+    DDD::DDDContext& ctx = *context;
+    DDD_Init(ctx);
+
+    DDD_TYPE type = DDD_TypeDeclare(ctx, "Item");
+    Item item;
+    DDD_TypeDefine(ctx, type, &item,
+                   EL_DDDHDR, &item.ddd,
+                   EL_GDATA,  &item.number, sizeof(item.number),
+                   EL_LDATA,  &item.value, sizeof(int)*6,
+                   EL_END,    &item+1);
+
+    const int me = ctx.me();
+    for (int i=0; i<N_ITEMS; i++)
+    {
+      items[i].number = i;
+      items[i].value = ItemValue(me,i);
+      DDD_HdrConstructor(ctx, &items[i].ddd, type, ItemPrio(me,i), ItemAttr(i));
+    }
+
+    DDD_IdentifyBegin(ctx);
+    for (int i=0; i<N_ITEMS; i++)
+      for (int p=0; p<ctx.procs(); p++)
+        if (p!=me)
+          DDD_IdentifyNumber(ctx, &items[i].ddd, p, i);
+    DDD_IdentifyEnd(ctx);
+
+    DDD_PRIO a[] = {PRIO_A}, b[] = {PRIO_B}, ab[] = {PRIO_A, PRIO_B};
+    oneway = DDD_IFDefine(ctx, 1, &type, 1, a, 1, b);
+    exchange = DDD_IFDefine(ctx, 1, &type, 2, ab, 2, ab);
+  }
+
+  ~Setup ()
+  {
+    /* the copies on all procs are destructed together */
+    DDD_SetOption(*context, OPT_WARNING_DESTRUCT_HDR, OPT_OFF);
+    for (Item& item : items)
+      DDD_HdrDestructor(*context, &item.ddd);
+    DDD_Exit(*context);
+  }
+
+  void Reset ()
+  {
+    for (Item& item : items)
+    {
+      item.received = item.calls = 0;
+      item.exchanged = item.exchangeCalls = item.wrongNumbers = 0;
+    }
+  }
+};
+
+int GatherValue (DDD::DDDContext&, DDD_OBJ obj, void *data)
+{
+  *(int *)data = ((Item *)obj)->value;
+  return 0;
+}
+
+int ScatterSum (DDD::DDDContext&, DDD_OBJ obj, void *data)
+{
+  Item *item = (Item *)obj;
+  item->received += *(int *)data;
+  item->calls++;
+  return 0;
+}
+
+/* sends the number along, to check that the parts of a message line up */
+int GatherPair (DDD::DDDContext&, DDD_OBJ obj, void *data)
+{
+  const Item *item = (const Item *)obj;
+  ((int *)data)[0] = item->value;
+  ((int *)data)[1] = item->number;
+  return 0;
+}
+
+int ScatterPair (DDD::DDDContext&, DDD_OBJ obj, void *data)
+{
+  Item *item = (Item *)obj;
+  item->exchanged += ((int *)data)[0];
+  item->exchangeCalls++;
+  if (((int *)data)[1]!=item->number)
+    item->wrongNumbers++;
+  return 0;
+}
+
+/* every third item has changed */
+int GatherChanged (DDD::DDDContext& context, DDD_OBJ obj, void *data)
+{
+  GatherValue(context, obj, data);
+  return ((Item *)obj)->number%3==0;
+}
+
+int GatherUnchanged (DDD::DDDContext& context, DDD_OBJ obj, void *data)
+{
+  GatherValue(context, obj, data);
+  return 0;
+}
+
+/* an item has changed for some of the receiving procs */
+int GatherChangedX (DDD::DDDContext& context, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO)
+{
+  GatherValue(context, obj, data);
+  return (((Item *)obj)->number+proc)%2==0;
+}
+
+int ScatterSumX (DDD::DDDContext& context, DDD_OBJ obj, void *data, DDD_PROC, DDD_PRIO)
+{
+  return ScatterSum(context, obj, data);
+}
+
+/* sum of the values and number of copies an item receives from the other
+   procs, taking from the copies with a priority in from and passing sent */
+template<class SENT>
+void Expected (int me, int procs, int number, bool receives,
+               const std::vector<DDD_PRIO>& from, SENT sent, int& sum, int& calls)
+{
+  sum = calls = 0;
+  if (!receives)
+    return;
+
+  for (int p=0; p<procs; p++)
+  {
+    if (p==me)
+      continue;
+    bool matches = false;
+    for (DDD_PRIO prio : from)
+      matches = matches || ItemPrio(p,number)==prio;
+    if (matches && sent(p))
+    {
+      sum += ItemValue(p,number);
+      calls++;
+    }
+  }
+}
+
+void CheckItems (TestSuite& test, const std::string& name, const Setup& setup,
+                 const std::vector<int>& sum, const std::vector<int>& calls)
+{
+  for (int i=0; i<N_ITEMS; i++)
+  {
+    test.check(setup.items[i].received==sum[i])
+      << name << ": item " << i << " received " << setup.items[i].received
+      << " instead of " << sum[i];
+    test.check(setup.items[i].calls==calls[i])
+      << name << ": item " << i << " was scattered " << setup.items[i].calls
+      << " times instead of " << calls[i];
+  }
+}
+
+/* delta parts only scatter the items whose gather reported a change, also
+   when other parts follow them in the same message */
+TestSuite TestDelta (Setup& setup)
+{
+  TestSuite test;
+  DDD::DDDContext& ctx = *setup.context;
+  const int me = ctx.me(), procs = ctx.procs();
+  const DDD_ATTR attr = ItemAttr(0);
+  std::vector<int> sum(N_ITEMS), calls(N_ITEMS);
+
+  /* one way from A to B, every third item changed */
+  setup.Reset();
+  DDD_IFMultiBegin(ctx);
+  DDD_IFMultiAOnewayDelta(ctx, setup.oneway, attr, IF_FORWARD, sizeof(int), GatherChanged, ScatterSum);
+  DDD_IFMultiEnd(ctx);
+  for (int i=0; i<N_ITEMS; i++)
+    Expected(me, procs, i, ItemAttr(i)==attr && ItemPrio(me,i)==PRIO_B, {PRIO_A},
+             [i](int) { return i%3==0; }, sum[i], calls[i]);
+  CheckItems(test, "delta", setup, sum, calls);
+
+  /* nothing changed, followed by a plain part */
+  setup.Reset();
+  DDD_IFMultiBegin(ctx);
+  DDD_IFMultiAOnewayDelta(ctx, setup.oneway, attr, IF_FORWARD, sizeof(int), GatherUnchanged, ScatterSum);
+  DDD_IFMultiAOneway(ctx, setup.oneway, attr, IF_FORWARD, sizeof(int), GatherValue, ScatterSum);
+  DDD_IFMultiEnd(ctx);
+  for (int i=0; i<N_ITEMS; i++)
+    Expected(me, procs, i, ItemAttr(i)==attr && ItemPrio(me,i)==PRIO_B, {PRIO_A},
+             [](int) { return true; }, sum[i], calls[i]);
+  CheckItems(test, "unchanged delta and plain part", setup, sum, calls);
+
+  /* changes depending on the receiving proc, between two delta parts */
+  setup.Reset();
+  DDD_IFMultiBegin(ctx);
+  DDD_IFMultiAOnewayDelta(ctx, setup.oneway, attr, IF_BACKWARD, sizeof(int), GatherChanged, ScatterSum);
+  DDD_IFMultiAOnewayDeltaX(ctx, setup.exchange, attr, IF_FORWARD, sizeof(int), GatherChangedX, ScatterSumX);
+  DDD_IFMultiEnd(ctx);
+  for (int i=0; i<N_ITEMS; i++)
+  {
+    int backSum, backCalls;
+    Expected(me, procs, i, ItemAttr(i)==attr && ItemPrio(me,i)==PRIO_A, {PRIO_B},
+             [i](int) { return i%3==0; }, backSum, backCalls);
+    Expected(me, procs, i, ItemAttr(i)==attr, {PRIO_A, PRIO_B},
+             [i,me](int) { return (i+me)%2==0; }, sum[i], calls[i]);
+    sum[i] += backSum;
+    calls[i] += backCalls;
+  }
+  CheckItems(test, "delta parts with extended handlers", setup, sum, calls);
+
+  return test;
+}
+
+/* a fused one way and exchange part on different interfaces and attrs
+   deliver the same as the separate communications */
+TestSuite TestFused (Setup& setup)
+{
+  TestSuite test;
+  DDD::DDDContext& ctx = *setup.context;
+  const int me = ctx.me(), procs = ctx.procs();
+  const DDD_ATTR onewayAttr = ItemAttr(0), exchangeAttr = ItemAttr(1);
+
+  setup.Reset();
+  DDD_IFAOneway(ctx, setup.oneway, onewayAttr, IF_FORWARD, sizeof(int), GatherValue, ScatterSum);
+  DDD_IFAExchange(ctx, setup.exchange, exchangeAttr, 2*sizeof(int), GatherPair, ScatterPair);
+  const std::vector<Item> separate = setup.items;
+
+  setup.Reset();
+  DDD_IFMultiBegin(ctx);
+  DDD_IFMultiAOneway(ctx, setup.oneway, onewayAttr, IF_FORWARD, sizeof(int), GatherValue, ScatterSum);
+  DDD_IFMultiAExchange(ctx, setup.exchange, exchangeAttr, 2*sizeof(int), GatherPair, ScatterPair);
+  DDD_IFMultiEnd(ctx);
+
+  for (int i=0; i<N_ITEMS; i++)
+  {
+    const Item& fused = setup.items[i];
+    test.check(fused.received==separate[i].received && fused.calls==separate[i].calls)
+      << "fused one way part: item " << i << " received " << fused.received
+      << " in " << fused.calls << " scatters instead of " << separate[i].received
+      << " in " << separate[i].calls;
+    test.check(fused.exchanged==separate[i].exchanged && fused.exchangeCalls==separate[i].exchangeCalls)
+      << "fused exchange part: item " << i << " received " << fused.exchanged
+      << " in " << fused.exchangeCalls << " scatters instead of " << separate[i].exchanged
+      << " in " << separate[i].exchangeCalls;
+    test.check(fused.wrongNumbers==0 && separate[i].wrongNumbers==0)
+      << "item " << i << " received data of other items";
+  }
+
+  /* both must also be right */
+  std::vector<int> sum(N_ITEMS), calls(N_ITEMS);
+  for (int i=0; i<N_ITEMS; i++)
+    Expected(me, procs, i, ItemAttr(i)==onewayAttr && ItemPrio(me,i)==PRIO_B, {PRIO_A},
+             [](int) { return true; }, sum[i], calls[i]);
+  CheckItems(test, "fused one way part", setup, sum, calls);
+
+  for (int i=0; i<N_ITEMS; i++)
+  {
+    int exchangeSum, exchangeCalls;
+    Expected(me, procs, i, ItemAttr(i)==exchangeAttr, {PRIO_A, PRIO_B},
+             [](int) { return true; }, exchangeSum, exchangeCalls);
+    test.check(setup.items[i].exchanged==exchangeSum && setup.items[i].exchangeCalls==exchangeCalls)
+      << "fused exchange part: item " << i << " received " << setup.items[i].exchanged
+      << " in " << setup.items[i].exchangeCalls << " scatters instead of "
+      << exchangeSum << " in " << exchangeCalls;
+  }
+
+  return test;
+}
+
+} /* namespace */
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+
+  TestSuite test;
+
+  {
+    Setup setup;
+    test.subTest(TestFused(setup));
+    test.subTest(TestDelta(setup));
+  }
+
+  return test.exit();
+}
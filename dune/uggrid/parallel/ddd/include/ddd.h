@@ -362,6 +362,19 @@ void     DDD_IFAExchangeX (DDD::DDDContext& context, DDD_IF,DDD_ATTR,
 void     DDD_IFAOnewayX   (DDD::DDDContext& context, DDD_IF,DDD_ATTR,DDD_IF_DIR,size_t, ComProcXPtr,ComProcXPtr);
 void     DDD_IFAExecLocalX(DDD::DDDContext& context, DDD_IF,DDD_ATTR,                   ExecProcXPtr);
 
+void     DDD_IFMultiBegin     (DDD::DDDContext& context);
+void     DDD_IFMultiExchange  (DDD::DDDContext& context, DDD_IF,                    size_t, ComProcPtr2,ComProcPtr2);
+void     DDD_IFMultiOneway    (DDD::DDDContext& context, DDD_IF,         DDD_IF_DIR,size_t, ComProcPtr2,ComProcPtr2);
+void     DDD_IFMultiAExchange (DDD::DDDContext& context, DDD_IF,DDD_ATTR,           size_t, ComProcPtr2,ComProcPtr2);
+void     DDD_IFMultiAOneway   (DDD::DDDContext& context, DDD_IF,DDD_ATTR,DDD_IF_DIR,size_t, ComProcPtr2,ComProcPtr2);
+void     DDD_IFMultiExchangeX (DDD::DDDContext& context, DDD_IF,                    size_t, ComProcXPtr,ComProcXPtr);
+void     DDD_IFMultiOnewayX   (DDD::DDDContext& context, DDD_IF,         DDD_IF_DIR,size_t, ComProcXPtr,ComProcXPtr);
+void     DDD_IFMultiAExchangeX(DDD::DDDContext& context, DDD_IF,DDD_ATTR,           size_t, ComProcXPtr,ComProcXPtr);
+void     DDD_IFMultiAOnewayX  (DDD::DDDContext& context, DDD_IF,DDD_ATTR,DDD_IF_DIR,size_t, ComProcXPtr,ComProcXPtr);
+void     DDD_IFMultiAOnewayDelta (DDD::DDDContext& context, DDD_IF,DDD_ATTR,DDD_IF_DIR,size_t, ComProcPtr2,ComProcPtr2);
+void     DDD_IFMultiAOnewayDeltaX(DDD::DDDContext& context, DDD_IF,DDD_ATTR,DDD_IF_DIR,size_t, ComProcXPtr,ComProcXPtr);
+void     DDD_IFMultiEnd       (DDD::DDDContext& context);
+
 /*
         Transfer Environment Module
  */
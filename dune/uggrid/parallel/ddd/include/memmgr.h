@@ -30,10 +30,31 @@
 #ifndef __MEMMGR__
 #define __MEMMGR__
 
+#include <dune/uggrid/low/heaps.h>
 #include <dune/uggrid/low/namespace.h>
 
 START_UGDIM_NAMESPACE
 
+/****************************************************************************/
+/*                                                                          */
+/* defines in the following order                                           */
+/*                                                                          */
+/*          compile time constants defining static data size (i.e. arrays)  */
+/*          other constants                                                 */
+/*          macros                                                          */
+/*                                                                          */
+/****************************************************************************/
+
+/* accounting classes of the memory manager (process-wide) */
+enum MemMgrStat {
+  MEMMGR_STAT_CPL,              /* couplings and coupling segments (TMEM_CPL)    */
+  MEMMGR_STAT_MSG,              /* message buffers (TMEM_MSG, TMEM_LOWCOMM)      */
+  MEMMGR_STAT_TMP,              /* other temporary memory (TMEM)                 */
+  MEMMGR_STAT_AMEM,             /* long-lived tables (AMEM)                      */
+
+  MEMMGR_NSTAT
+};
+
 /****************************************************************************/
 /*                                                                          */
 /* function declarations                                                    */
@@ -52,6 +73,8 @@ void  memmgr_FreeAMEM (void *mem);
 void *memmgr_AllocTMEM (long unsigned int size, int kind);
 void  memmgr_FreeTMEM (void *mem, int kind);
 
+const NS_PREFIX HEAP_STAT *memmgr_Statistics (int cls);
+
 END_UGDIM_NAMESPACE
 
 #endif
@@ -436,6 +436,30 @@ static void AttachMask(const DDD::DDDContext& context, TYPE_DESC *desc)
     }
   }
 
+  /* compile mask into runs of copy and of partially copied bytes */
+  desc->copyRuns.clear();
+  for(i=0; i<desc->size; )
+  {
+    const unsigned char m = desc->cmask[i];
+    const bool masked = (m!=0xff);
+
+    if (m==0x00)
+    {
+      i++;
+      continue;
+    }
+
+    for(k=i+1; k<desc->size; k++)
+    {
+      const unsigned char mk = desc->cmask[k];
+      if (mk==0x00 || (mk!=0xff)!=masked)
+        break;
+    }
+
+    desc->copyRuns.push_back({(std::size_t)i, (std::size_t)(k-i), masked});
+    i = k;
+  }
+
 #       ifdef DebugCopyMask
   if (context.isMaster())
   {
@@ -455,6 +479,32 @@ static void AttachMask(const DDD::DDDContext& context, TYPE_DESC *desc)
 }
 
 
+/*
+        flatten the EL_OBJPTR elements into one PTR_SLOT per pointer
+ */
+
+static void AttachPtrSlots(const DDD::DDDContext& context, TYPE_DESC *desc)
+{
+  desc->ptrSlots.clear();
+  desc->ptrSlots.reserve(desc->nPointers);
+
+  for(int i=0; i<desc->nElements; i++)
+  {
+    const ELEM_DESC *e = &desc->element[i];
+
+    if (e->type!=EL_OBJPTR)
+      continue;
+
+    const TYPE_DESC *refdesc = nullptr;
+    if (EDESC_REFTYPE(e)!=DDD_TYPE_BY_HANDLER)
+      refdesc = &context.typeDefs()[EDESC_REFTYPE(e)];
+
+    for(std::size_t l=0; l<e->size; l+=sizeof(void *))
+      desc->ptrSlots.push_back({(int)(e->offset+l), refdesc, e->reftypeHandler});
+  }
+}
+
+
 
 
 
@@ -742,6 +792,9 @@ void DDD_TypeDefine(DDD::DDDContext& context, DDD_TYPE typ, ...)
     /* attach copy-mask for efficient copying */
     AttachMask(context, desc);
 
+    /* flatten references for pack and unpack */
+    AttachPtrSlots(context, desc);
+
     /* change TYPE_DESC state to DEFINED */
     desc->mode = DDD_TYPE_DEFINED;
   }
@@ -1043,6 +1096,8 @@ void ddd_TypeMgrExit(DDD::DDDContext& context)
   /* free memory */
   for (auto& typeDef : context.typeDefs()) {
     typeDef.cmask = nullptr;
+    typeDef.copyRuns.clear();
+    typeDef.ptrSlots.clear();
   }
 }
 
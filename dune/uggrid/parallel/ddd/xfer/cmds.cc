@@ -76,131 +76,74 @@ using namespace PPIF;
 /****************************************************************************/
 
 
-static int sort_XIDelCmd (const void *e1, const void *e2)
-{
-  XIDelCmd *item1 = *((XIDelCmd **)e1);
-  XIDelCmd *item2 = *((XIDelCmd **)e2);
+/*
+        sort keys (hi,lo) for SortedArrayByKey(T), items are sorted
+        by ascending hi first and by ascending lo second.
+ */
 
+static void key_XIDelCmd (const XIDelCmd *item, std::uint64_t *hi, std::uint64_t *lo)
+{
   /* ascending GID is needed for ExecLocalXIDelCmds */
-  if (OBJ_GID(item1->hdr) < OBJ_GID(item2->hdr)) return(-1);
-  if (OBJ_GID(item1->hdr) > OBJ_GID(item2->hdr)) return(1);
-
-  return(0);
+  *hi = 0;
+  *lo = OBJ_GID(item->hdr);
 }
 
 
-static int sort_XIDelObj (const void *e1, const void *e2)
+static void key_XIDelObj (const XIDelObj *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XIDelObj *item1 = *((XIDelObj **)e1);
-  XIDelObj *item2 = *((XIDelObj **)e2);
-
   /* ascending GID is needed for ExecLocalXIDelObjs */
-  if (item1->gid < item2->gid) return(-1);
-  if (item1->gid > item2->gid) return(1);
-
-  return(0);
+  *hi = 0;
+  *lo = item->gid;
 }
 
 
-static int sort_XINewCpl (const void *e1, const void *e2)
+static void key_XINewCpl (const XINewCpl *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XINewCpl *item1 = *((XINewCpl **)e1);
-  XINewCpl *item2 = *((XINewCpl **)e2);
-
   /* receiving processor */
-  if (item1->to < item2->to) return(-1);
-  if (item1->to > item2->to) return(1);
-
-  return(0);
+  *hi = item->to;
+  *lo = 0;
 }
 
 
 
-static int sort_XIOldCpl (const void *e1, const void *e2)
+static void key_XIOldCpl (const XIOldCpl *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XIOldCpl *item1 = *((XIOldCpl **)e1);
-  XIOldCpl *item2 = *((XIOldCpl **)e2);
-  DDD_GID gid1, gid2;
-
-  /* receiving processor */
-  if (item1->to < item2->to) return(-1);
-  if (item1->to > item2->to) return(1);
-
-  /* ascending GID is needed for UnpackOldCplTab on receiver side */
-  gid1 = item1->te.gid;
-  gid2 = item2->te.gid;
-  if (gid1 < gid2) return(-1);
-  if (gid1 > gid2) return(1);
-
-  return(0);
+  /* receiving processor, then
+     ascending GID is needed for UnpackOldCplTab on receiver side */
+  *hi = item->to;
+  *lo = item->te.gid;
 }
 
 
 
-static int sort_XIDelCpl (const void *e1, const void *e2)
+static void key_XIDelCpl (const XIDelCpl *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XIDelCpl *item1 = *((XIDelCpl **)e1);
-  XIDelCpl *item2 = *((XIDelCpl **)e2);
-  DDD_GID gid1, gid2;
-
-  /* receiving processor */
-  if (item1->to < item2->to) return(-1);
-  if (item1->to > item2->to) return(1);
-
-  /* ascending GID is needed by CplMsgUnpack on receiver side */
-  gid1 = item1->te.gid;
-  gid2 = item2->te.gid;
-  if (gid1 < gid2) return(-1);
-  if (gid1 > gid2) return(1);
-
-  return(0);
+  /* receiving processor, then
+     ascending GID is needed by CplMsgUnpack on receiver side */
+  *hi = item->to;
+  *lo = item->te.gid;
 }
 
 
-static int sort_XIModCpl (const void *e1, const void *e2)
+static void key_XIModCpl (const XIModCpl *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XIModCpl *item1 = *((XIModCpl **)e1);
-  XIModCpl *item2 = *((XIModCpl **)e2);
-  DDD_GID gid1, gid2;
-
-  /* receiving processor */
-  if (item1->to < item2->to) return(-1);
-  if (item1->to > item2->to) return(1);
-
-  /* ascending GID is needed by CplMsgUnpack on receiver side */
-  gid1 = item1->te.gid;
-  gid2 = item2->te.gid;
-  if (gid1 < gid2) return(-1);
-  if (gid1 > gid2) return(1);
+  /* receiving processor, then
+     ascending GID is needed by CplMsgUnpack on receiver side */
+  *hi = item->to;
+  *lo = item->te.gid;
 
   /* sorting according to priority is not necessary anymore,
      equal items with different priorities will be sorted
-     out according to PriorityMerge(). KB 970129
-     if (item1->te.prio < item2->te.prio) return(-1);
-     if (item1->te.prio > item2->te.prio) return(1);
-   */
-
-  return(0);
+     out according to PriorityMerge(). KB 970129 */
 }
 
 
-static int sort_XIAddCpl (const void *e1, const void *e2)
+static void key_XIAddCpl (const XIAddCpl *item, std::uint64_t *hi, std::uint64_t *lo)
 {
-  XIAddCpl *item1 = *((XIAddCpl **)e1);
-  XIAddCpl *item2 = *((XIAddCpl **)e2);
-  DDD_GID gid1, gid2;
-
-  /* receiving processor */
-  if (item1->to < item2->to) return(-1);
-  if (item1->to > item2->to) return(1);
-
-  /* ascending GID is needed by CplMsgUnpack on receiver side */
-  gid1 = item1->te.gid;
-  gid2 = item2->te.gid;
-  if (gid1 < gid2) return(-1);
-  if (gid1 > gid2) return(1);
-
-  return(0);
+  /* receiving processor, then
+     ascending GID is needed by CplMsgUnpack on receiver side */
+  *hi = item->to;
+  *lo = item->te.gid;
 }
 
 
@@ -433,7 +376,7 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
     /* create sorted array of XIDelCmd-items, and unify it */
     /* in case of pruning set to OPT_OFF, this sorting/unifying
        step is done lateron. */
-    arrayXIDelCmd = SortedArrayXIDelCmd(context, sort_XIDelCmd);
+    arrayXIDelCmd = SortedArrayByKeyXIDelCmd(context, key_XIDelCmd);
     if (arrayXIDelCmd==NULL && ctx.nXIDelCmd>0)
     {
       Dune::dwarn << "out of memory in DDD_XferEnd(), giving up.\n";
@@ -480,7 +423,7 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
   /* create sorted array of XINewCpl- and XIOldCpl-items.
      TODO. if efficiency is a problem here, use b-tree or similar
            data structure to improve performance. */
-  arrayXINewCpl = SortedArrayXINewCpl(context, sort_XINewCpl);
+  arrayXINewCpl = SortedArrayByKeyXINewCpl(context, key_XINewCpl);
   if (arrayXINewCpl==NULL && ctx.nXINewCpl>0)
   {
     Dune::dwarn << "out of memory in DDD_XferEnd(), giving up.\n";
@@ -489,7 +432,7 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
     goto exit;
   }
 
-  arrayXIOldCpl = SortedArrayXIOldCpl(context, sort_XIOldCpl);
+  arrayXIOldCpl = SortedArrayByKeyXIOldCpl(context, key_XIOldCpl);
   if (arrayXIOldCpl==NULL && ctx.nXIOldCpl>0)
   {
     Dune::dwarn << "out of memory in DDD_XferEnd(), giving up.\n";
@@ -571,7 +514,7 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
   if (!DelCmds_were_pruned)
   {
     /* create sorted array of XIDelCmd-items, and unify it */
-    arrayXIDelCmd = SortedArrayXIDelCmd(context, sort_XIDelCmd);
+    arrayXIDelCmd = SortedArrayByKeyXIDelCmd(context, key_XIDelCmd);
     if (arrayXIDelCmd==NULL && ctx.nXIDelCmd>0)
     {
       Dune::dwarn << "out of memory in DDD_XferEnd(), giving up.\n";
@@ -600,7 +543,7 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
    */
 
   /* create sorted array of XIDelObj-items */
-  arrayXIDelObj = SortedArrayXIDelObj(context, sort_XIDelObj);
+  arrayXIDelObj = SortedArrayByKeyXIDelObj(context, key_XIDelObj);
 
   ExecLocalXISetPrio(context, arrayXISetPrio,
                      arrayXIDelObj,  ctx.nXIDelObj,
@@ -699,9 +642,9 @@ DDD_RET DDD_XferEnd(DDD::DDDContext& context)
   /* create sorted array of XIDelCpl-, XIModCpl- and XIAddCpl-items.
      TODO. if efficiency is a problem here, use b-tree or similar
            data structure to improve performance. */
-  arrayXIDelCpl = SortedArrayXIDelCpl(context, sort_XIDelCpl);
-  arrayXIModCpl = SortedArrayXIModCpl(context, sort_XIModCpl);
-  arrayXIAddCpl = SortedArrayXIAddCpl(context, sort_XIAddCpl);
+  arrayXIDelCpl = SortedArrayByKeyXIDelCpl(context, key_XIDelCpl);
+  arrayXIModCpl = SortedArrayByKeyXIModCpl(context, key_XIModCpl);
+  arrayXIAddCpl = SortedArrayByKeyXIAddCpl(context, key_XIAddCpl);
 
 
   /* some XIDelCpls have been invalidated by UpdateCoupling(),
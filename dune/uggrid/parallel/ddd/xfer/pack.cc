@@ -96,11 +96,6 @@ START_UGDIM_NAMESPACE
 /****************************************************************************/
 
 
-static bool sort_SymTabEntries (const SYMTAB_ENTRY& a, const SYMTAB_ENTRY& b)
-{
-  return a.gid < b.gid;
-}
-
 /****************************************************************************/
 /*                                                                          */
 /* Function:  BuildSymTab                                                   */
@@ -122,71 +117,43 @@ static int BuildSymTab (DDD::DDDContext& context,
                         const char *copy,
                         SYMTAB_ENTRY *theSymTab)
 {
-  ELEM_DESC   *theElem;
-  int e, actSym;
+  int actSym;
 
   /* reset local portion of SymTab */
   actSym = 0;
 
-  /* prepare map of structure elements */
-  theElem = desc->element;
-
   /* loop over all pointers inside of object obj */
-  for(e=0; e<desc->nElements; e++, theElem++)
+  for (const PTR_SLOT& slot : desc->ptrSlots)
   {
-    if (theElem->type==EL_OBJPTR)
+    /* get address of outside reference */
+    DDD_OBJ *ref = (DDD_OBJ *)(copy+slot.offset);
+
+    /* create symbol table entry */
+    if (*ref!=NULL)
     {
-      TYPE_DESC *refdesc;
-      int l;
-      int rt_on_the_fly = (EDESC_REFTYPE(theElem)==DDD_TYPE_BY_HANDLER);
+      const TYPE_DESC *refdesc = slot.refdesc;
 
-      /* determine reftype of this elem */
-      if (! rt_on_the_fly)
+      if (refdesc==nullptr)
       {
-        /* we know the reftype of this element in advance */
-        refdesc = &context.typeDefs()[EDESC_REFTYPE(theElem)];
-      }
-      /* else: determine reftype on the fly by calling handler */
-
+        DDD_TYPE rt;
 
-      /* loop over single pointer array */
-      for(l=0; l<theElem->size; l+=sizeof(void *))
-      {
-        /* get address of outside reference */
-        DDD_OBJ *ref = (DDD_OBJ *)(copy+theElem->offset+l);
+        /* determine reftype on the fly by calling handler */
+        assert(obj!=NULL);                                   /* we need a real object here */
 
+        rt = slot.reftypeHandler(context, obj, *ref);
+        if (rt>=MAX_TYPEDESC)
+          DUNE_THROW(Dune::Exception,
+                     "invalid referenced DDD_TYPE returned by handler");
 
-        /* create symbol table entry */
-        if (*ref!=NULL)
-        {
-          DDD_HDR refhdr;
-
-          if (rt_on_the_fly)
-          {
-            DDD_TYPE rt;
-
-            /* determine reftype on the fly by calling handler */
-            assert(obj!=NULL);                                       /* we need a real object here */
-
-            rt = theElem->reftypeHandler(context, obj, *ref);
-            if (rt>=MAX_TYPEDESC)
-              DUNE_THROW(Dune::Exception,
-                         "invalid referenced DDD_TYPE returned by handler");
-
-            refdesc = &context.typeDefs()[rt];
-          }
-
-          /* get header of referenced object */
-          refhdr = OBJ2HDR(*ref,refdesc);
+        refdesc = &context.typeDefs()[rt];
+      }
 
-          /* remember the GID of the referenced object */
-          theSymTab[actSym].gid = OBJ_GID(refhdr);
+      /* remember the GID of the referenced object */
+      theSymTab[actSym].gid = OBJ_GID(OBJ2HDR(*ref,refdesc));
 
-          /* remember the address of the reference (in obj-copy) */
-          theSymTab[actSym].adr.ref = ref;
-          actSym++;
-        }
-      }
+      /* remember the address of the reference (in obj-copy) */
+      theSymTab[actSym].adr.ref = ref;
+      actSym++;
     }
   }
 
@@ -484,9 +451,8 @@ static void XferPackSingleMsg (DDD::DDDContext& context, XFERMSG *msg)
   }
 
 
-  /* sort SymTab, ObjTab and CplTab */
-  /* sort SymTab according to the global ids stored there */
-  std::sort(theSymTab, theSymTab + actSym, sort_SymTabEntries);
+  /* sort ObjTab and CplTab */
+  /* the SymTab needs no order, the receiver resolves its gids by hashing */
 
   /* sort ObjTab according to their global ids */
   /* sorting of objtab is necessary!! (see AcceptObjFromMsg) KB 960812 */
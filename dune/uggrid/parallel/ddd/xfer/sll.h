@@ -29,6 +29,10 @@
 #ifndef __SLL_H__
 #define __SLL_H__
 
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
 
 /****************************************************************************/
 
@@ -84,6 +88,9 @@
 #define _SortedArray(T) SortedArray ## T
 #define SortedArray(T) _SortedArray(T)
 
+#define _SortedArrayByKey(T) SortedArrayByKey ## T
+#define SortedArrayByKey(T) _SortedArrayByKey(T)
+
 #define _sort_OrigOrder(T) sort_OrigOrder ## T
 #define sort_OrigOrder(T) _sort_OrigOrder(T)
 
@@ -104,6 +111,69 @@
 
 
 
+/****************************************************************************/
+
+namespace DDD {
+namespace Xfer {
+
+/* item pointer with its sort key (hi,lo), see SortedArrayByKey(T) */
+template<class T>
+struct SLL_KEYED
+{
+  std::uint64_t hi, lo;
+  T *item;
+};
+
+/*
+        stable LSD radix sort by ascending (hi,lo), one byte per pass.
+        passes in which all items have the same digit are skipped, so
+        small processor numbers and dense gids take only a few passes.
+        tmp must have room for n items.
+ */
+template<class T>
+void SLL_RadixSort (SLL_KEYED<T> *a, SLL_KEYED<T> *tmp, int n)
+{
+  SLL_KEYED<T> *src = a, *dst = tmp;
+
+  if (n<2)
+    return;
+
+  for (int pass=0; pass<16; pass++)
+  {
+    const int shift = 8*(pass%8);
+    const bool useHi = (pass>=8);
+    int count[256];
+    int i;
+
+    std::memset(count, 0, sizeof(count));
+    for (i=0; i<n; i++)
+      count[((useHi ? src[i].hi : src[i].lo) >> shift) & 0xff]++;
+
+    /* skip pass if all items fall into the same bucket */
+    if (count[((useHi ? src[0].hi : src[0].lo) >> shift) & 0xff]==n)
+      continue;
+
+    int sum = 0;
+    for (i=0; i<256; i++)
+    {
+      const int c = count[i];
+      count[i] = sum;
+      sum += c;
+    }
+
+    for (i=0; i<n; i++)
+      dst[count[((useHi ? src[i].hi : src[i].lo) >> shift) & 0xff]++] = src[i];
+
+    SLL_KEYED<T> *h = src; src = dst; dst = h;
+  }
+
+  if (src!=a)
+    std::memcpy(a, src, sizeof(SLL_KEYED<T>)*n);
+}
+
+} /* namespace Xfer */
+} /* namespace DDD */
+
 /****************************************************************************/
 
 #endif
@@ -0,0 +1,77 @@
+#include "config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "../sll.h"
+
+using namespace Dune;
+
+namespace {
+
+struct Item
+{
+  int id;
+};
+
+using Keyed = DDD::Xfer::SLL_KEYED<Item>;
+
+/* compare SLL_RadixSort with std::stable_sort on the same keys */
+TestSuite test_radixsort(int n, std::uint64_t hiRange, std::uint64_t loRange, bool wideLo)
+{
+  TestSuite test;
+
+  std::mt19937_64 random(n);
+  std::vector<Item> items(n);
+  /* SLL_RadixSort needs room for n more items after the array */
+  std::vector<Keyed> keyed(2*n+1);
+
+  for (int i=0; i<n; i++)
+  {
+    items[i].id = i;
+    keyed[i].hi = random() % hiRange;
+    keyed[i].lo = (wideLo && i%3==0) ? random() : random() % loRange;
+    keyed[i].item = &items[i];
+  }
+
+  std::vector<Keyed> expected(keyed.begin(), keyed.begin()+n);
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Keyed& a, const Keyed& b) {
+                     return a.hi<b.hi || (a.hi==b.hi && a.lo<b.lo);
+                   });
+
+  DDD::Xfer::SLL_RadixSort(keyed.data(), keyed.data()+n, n);
+
+  for (int i=0; i<n; i++)
+  {
+    test.check(keyed[i].item == expected[i].item)
+      << "item " << i << " of " << n << " differs from std::stable_sort";
+    test.check(keyed[i].hi == expected[i].hi && keyed[i].lo == expected[i].lo)
+      << "key " << i << " of " << n << " differs from std::stable_sort";
+  }
+
+  return test;
+}
+
+} /* namespace */
+
+int main()
+{
+  TestSuite test;
+
+  for (int n : {0, 1, 2, 17, 1000, 100000})
+  {
+    /* few processors, small and full width gids */
+    test.subTest(test_radixsort(n, 5, 50, true));
+    /* many equal keys, so most passes are skipped */
+    test.subTest(test_radixsort(n, 1, 3, false));
+    /* full width keys in both halves */
+    test.subTest(test_radixsort(n, UINT64_MAX, UINT64_MAX, true));
+  }
+
+  return test.exit();
+}
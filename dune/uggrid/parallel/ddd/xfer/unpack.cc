@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <tuple>
+#include <unordered_map>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/stdstreams.hh>
@@ -63,6 +64,10 @@ START_UGDIM_NAMESPACE
 /*#define DebugCouplingCons*/
 
 
+/* local objects which references in received messages resolve to */
+using GidTable = std::unordered_map<DDD_GID, DDD_HDR>;
+
+
 /*
    #define AddCoupling(context, a,b,c)  printf("%4d: AC %05d, %d/%d     %08x\n",context.me(),__LINE__,b,c,(int) AddCoupling(context, a,b,c))
  */
@@ -120,193 +125,89 @@ static void LocalizeObject (DDD::DDDContext& context, bool merge_mode, TYPE_DESC
                             DDD_OBJ objmem,
                             const SYMTAB_ENTRY *theSymTab)
 {
-  ELEM_DESC     *theElem;
-  int e;
   DDD_OBJ obj = objmem;
 
-  /* prepare map of structure elements */
-  theElem = desc->element;
-
   /* loop over all pointers inside of object obj */
-  for(e=0; e<desc->nElements; e++, theElem++)
+  for (const PTR_SLOT& slot : desc->ptrSlots)
   {
-    if (theElem->type==EL_OBJPTR)
-    {
-      TYPE_DESC *refdesc;
-      int rt_on_the_fly = (EDESC_REFTYPE(theElem)==DDD_TYPE_BY_HANDLER);
-      int l;
-
-      const char      *msgrefarray = msgmem+theElem->offset;
-      char      *objrefarray = objmem+theElem->offset;
+    /* ref points to a reference inside objmem */
+    DDD_OBJ *ref = (DDD_OBJ *) (objmem+slot.offset);
 
+    /* reference had been replaced by SymTab-index */
+    const INT stIdx = (*(const std::uintptr_t *)(msgmem+slot.offset)) - 1;
 
-      /* determine reftype of this elem */
-      if (! rt_on_the_fly)
-      {
-        refdesc = &context.typeDefs()[EDESC_REFTYPE(theElem)];
-      }
-      /* else determine reftype on the fly */
-
-
-
-      /* loop over single pointer array */
-      for(l=0; l<theElem->size; l+=sizeof(void*))
+    /* test for Localize execution in merge_mode */
+    if (merge_mode && (*ref!=NULL))
+    {
+      /* if we are in merge_mode, we do not update
+         existing references. it may happen here that different
+         references are in incoming and existing object. this is
+         implicitly resolved by using the existing reference and
+         ignoring the incoming one. if the REF_COLLISION option
+         is set, we will issue a warning.
+       */
+      if (stIdx>=0 &&
+          DDD_GetOption(context, OPT_WARNING_REF_COLLISION)==OPT_ON)
       {
-        INT stIdx;
-
-        /* ref points to a reference inside objmem */
-        DDD_OBJ *ref = (DDD_OBJ *) (objrefarray+l);
-
+        const TYPE_DESC *refdesc = slot.refdesc;
 
-        /* reference had been replaced by SymTab-index */
-        stIdx = (*(std::uintptr_t *)(msgrefarray+l)) - 1;
-        /* test for Localize execution in merge_mode */
-        if (merge_mode && (*ref!=NULL))
+        if (refdesc==nullptr)
         {
-          if (rt_on_the_fly)
-          {
-            /* determine reftype on the fly by calling handler */
-            DDD_TYPE rt;
-
-            assert(obj!=NULL);
+          /* determine reftype on the fly by calling handler */
+          DDD_TYPE rt;
 
-            rt = theElem->reftypeHandler(context, obj, *ref);
+          assert(obj!=NULL);
 
-            if (rt>=MAX_TYPEDESC)
-              DUNE_THROW(Dune::Exception,
-                         "invalid referenced DDD_TYPE returned by handler");
+          rt = slot.reftypeHandler(context, obj, *ref);
 
-            refdesc = &context.typeDefs()[rt];
-          }
+          if (rt>=MAX_TYPEDESC)
+            DUNE_THROW(Dune::Exception,
+                       "invalid referenced DDD_TYPE returned by handler");
 
-          /* if we are in merge_mode, we do not update
-             existing references. */
-                                        #ifdef DEBUG_MERGE_MODE
-          printf("loc-merge curr=%08x keep     e=%d l=%d\n",
-                 OBJ_GID(OBJ2HDR(*ref,refdesc)), e,l);
-                                        #endif
-
-          /* it may happen here that different references
-             are in incoming and existing object. this is implicitly
-             resolved by using the existing reference and ignoring
-             the incoming one. if the REF_COLLISION option is set,
-                  we will issue a warning.
-           */
-
-          if (stIdx>=0 &&
-              DDD_GetOption(context, OPT_WARNING_REF_COLLISION)==OPT_ON)
-          {
-            /* get corresponding symtab entry */
-            if (theSymTab[stIdx].adr.hdr!=OBJ2HDR(*ref,refdesc))
-            {
-              Dune::dwarn
-                << "LocalizeObject: "
-                << "reference collision in " << OBJ_GID(OBJ2HDR(obj,desc))
-                << " (old=" << OBJ_GID(OBJ2HDR(*ref,refdesc))
-                << ", inc=" << OBJ_GID(theSymTab[stIdx].adr.hdr) << ")\n";
-              /* assert(0);  ??? */
-            }
-          }
+          refdesc = &context.typeDefs()[rt];
+        }
 
-          continue;
+        /* get corresponding symtab entry */
+        if (theSymTab[stIdx].adr.hdr!=OBJ2HDR(*ref,refdesc))
+        {
+          Dune::dwarn
+            << "LocalizeObject: "
+            << "reference collision in " << OBJ_GID(OBJ2HDR(obj,desc))
+            << " (old=" << OBJ_GID(OBJ2HDR(*ref,refdesc))
+            << ", inc=" << OBJ_GID(theSymTab[stIdx].adr.hdr) << ")\n";
         }
+      }
 
+      continue;
+    }
 
-        /*
-           at this point, we are either not in merge_mode
-           or we are in merge_mode, but existing reference is zero.
+    /*
+       at this point, we are either not in merge_mode
+       or we are in merge_mode, but existing reference is zero.
 
-           NOTE: only in merge_mode the objmem array points
-                 to the reference array inside the local
-                 local object!
-         */
+       NOTE: only in merge_mode the objmem array points
+             to the reference array inside the local
+             local object!
 
-        if (stIdx>=0)
-        {
-          /* get corresponding symtab entry */
-          const SYMTAB_ENTRY *st = &(theSymTab[stIdx]);
-
-          /*
-                  convert reference from header to object itself
-                  and replace index by pointer; if header==NULL,
-                  referenced object is not known and *ref should
-                  therefore be NULL, too!
-           */
-
-#ifdef MERGE_MODE_IN_TESTZUSTAND
-          if (merge_mode)
-          {
-            if (st->adr.hdr!=NULL)
-            {
-                                                        #ifdef DEBUG_MERGE_MODE
-              printf("loc-merge curr=%08x "
-                     "have_sym e=%d l=%d to %08x\n",
-                     *ref, e,l,OBJ_GID(st->adr.hdr));
-                                                        #endif
-
-              /* distinction for efficiency: if we know refdesc
-                 in advance, we can compute DDD_OBJ more
-                 efficient. */
-              if (!rt_on_the_fly)
-              {
-                *ref = HDR2OBJ(st->adr.hdr,refdesc);
-              }
-              else
-              {
-                *ref = OBJ_OBJ(context, st->adr.hdr);
-              }
-            }
-
-                                                #ifdef DEBUG_MERGE_MODE
-            else
-            {
-              printf(
-                "loc-merge curr=%08x "
-                "have_sym e=%d l=%d to NULL\n",
-                *ref, e, l);
-            }
-                                                #endif
-          }
-          else
-#endif
-          {
-            if (st->adr.hdr!=NULL)
-            {
-              /* distinction for efficiency: if we know refdesc
-                 in advance, we can compute DDD_OBJ more
-                 efficient. */
-              if (!rt_on_the_fly)
-              {
-                *ref = HDR2OBJ(st->adr.hdr,refdesc);
-              }
-              else
-              {
-                *ref = OBJ_OBJ(context, st->adr.hdr);
-              }
-            }
-            else
-              *ref = NULL;
-          }
-        }
-        else
-        {
-#ifdef MERGE_MODE_IN_TESTZUSTAND
-          if (merge_mode)
-          {
-                                                #ifdef DEBUG_MERGE_MODE
-            printf("loc-merge curr=%08x "
-                   "no_sym   e=%d l=%d\n",
-                   *ref, e,l);
-                                                #endif
-          }
-          else
-#endif
-          {
-            *ref = NULL;
-          }
-        }
-      }
+       convert reference from header to object itself
+       and replace index by pointer; if header==NULL,
+       referenced object is not known and *ref should
+       therefore be NULL, too!
+     */
+    if (stIdx>=0 && theSymTab[stIdx].adr.hdr!=NULL)
+    {
+      const DDD_HDR hdr = theSymTab[stIdx].adr.hdr;
+
+      /* distinction for efficiency: if we know refdesc
+         in advance, we can compute DDD_OBJ more
+         efficient. */
+      if (slot.refdesc!=nullptr)
+        *ref = HDR2OBJ(hdr,slot.refdesc);
+      else
+        *ref = OBJ_OBJ(context, hdr);
     }
+    else
+      *ref = NULL;
   }
 }
 
@@ -1017,14 +918,36 @@ static void PropagateIncomings (
 
 
 
+/*
+        build the table of all objects which references in received
+        messages may point to, i.e. the local objects with couplings
+        and the received objects, indexed by gid. a received object
+        takes precedence over the local object with the same gid;
+        among equal gids in unionObjTab the first one wins, as the
+        merge scans did before.
+ */
+static void BuildLocalGidTable (GidTable& table,
+                                OBJTAB_ENTRY **allRecObjs, int nRecObjs,
+                                const DDD_HDR *localCplObjs, int nLocalCplObjs)
+{
+  table.clear();
+  table.reserve(nRecObjs + nLocalCplObjs);
+
+  for(int i=0; i<nRecObjs; i++)
+    table.emplace(OBJ_GID(allRecObjs[i]->hdr), allRecObjs[i]->hdr);
+
+  for(int i=0; i<nLocalCplObjs; i++)
+    table.emplace(OBJ_GID(localCplObjs[i]), localCplObjs[i]);
+}
+
+
 static void LocalizeSymTab (DDD::DDDContext& context, LC_MSGHANDLE xm,
-                            OBJTAB_ENTRY **allRecObjs, int nRecObjs,
-                            const DDD_HDR *localCplObjs, int nLocalCplObjs)
+                            const GidTable& table)
 {
   auto& ctx = context.xferContext();
 
   SYMTAB_ENTRY *theSymTab;
-  int i, j;
+  int i;
   int lenSymTab = (int) LC_GetTableLen(xm, ctx.symtab_id);
 
 
@@ -1032,42 +955,11 @@ static void LocalizeSymTab (DDD::DDDContext& context, LC_MSGHANDLE xm,
   theSymTab = (SYMTAB_ENTRY *) LC_GetPtr(xm, ctx.symtab_id);
 
 
-  /* insert pointers to known objects into SymTab */
-  for(i=0, j=0; i<lenSymTab; i++)
-  {
-    while ((j<nLocalCplObjs) &&
-           (OBJ_GID(localCplObjs[j]) < theSymTab[i].gid))
-      j++;
-
-    if (j==nLocalCplObjs)
-    {
-      /* no more valid local objects */
-      theSymTab[i].adr.hdr = NULL;
-    }
-    else
-    {
-      if (OBJ_GID(localCplObjs[j]) == theSymTab[i].gid)
-      {
-        theSymTab[i].adr.hdr = localCplObjs[j];
-      }
-      else
-      {
-        theSymTab[i].adr.hdr = NULL;
-      }
-    }
-  }
-
-
-  /* insert new pointers in SymTab */
-  for(i=0, j=0; i<lenSymTab; i++)
+  /* insert pointers to known and new objects into SymTab */
+  for(i=0; i<lenSymTab; i++)
   {
-    while ((j<nRecObjs) && (OBJ_GID(allRecObjs[j]->hdr)<theSymTab[i].gid))
-      j++;
-
-    if ((j<nRecObjs) && (OBJ_GID(allRecObjs[j]->hdr)==theSymTab[i].gid))
-    {
-      theSymTab[i].adr.hdr = allRecObjs[j]->hdr;
-    }
+    const auto it = table.find(theSymTab[i].gid);
+    theSymTab[i].adr.hdr = (it!=table.end()) ? it->second : NULL;
   }
 }
 
@@ -1387,7 +1279,7 @@ static void UnpackOldCplTab (
     {
       /* look for TEOldCpl-items with same gid.
          note: this relies on previous sorting via
-         sort_XIOldCpl on sender side. */
+         key_XIOldCpl on sender side. */
       while (iOC<nOC && tabOC[iOC].gid<OBJ_GID(tabO[iO].hdr))
         iOC++;
 
@@ -1601,9 +1493,15 @@ void XferUnpack (DDD::DDDContext& context, LC_MSGHANDLE *theMsgs, int nRecvMsgs,
    */
 
   /* insert local references into symtabs */
-  for(i=0; i<nRecvMsgs; i++)
-    LocalizeSymTab(context, theMsgs[i], unionObjTab, lenObjTab,
-                   localCplObjs, nLocalCplObjs);
+  if (nRecvMsgs>0)
+  {
+    GidTable localGids;
+    BuildLocalGidTable(localGids, unionObjTab, lenObjTab,
+                       localCplObjs, nLocalCplObjs);
+
+    for(i=0; i<nRecvMsgs; i++)
+      LocalizeSymTab(context, theMsgs[i], localGids);
+  }
 
 
   /*
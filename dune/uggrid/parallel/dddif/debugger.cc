@@ -52,6 +52,11 @@ static void dddif_DisplayMemoryUsage (const DDD::DDDContext& context)
   UserWriteF("mem for couplings:   %8ld bytes\n",
              (unsigned long) DDD_InfoCplMemory(context)
              );
+
+  UserWriteF("mem for messages:    %8lu bytes (peak %lu)\n",
+             memmgr_Statistics(MEMMGR_STAT_MSG)->bytes,
+             memmgr_Statistics(MEMMGR_STAT_MSG)->peakBytes
+             );
 }
 
 
@@ -45,6 +45,9 @@
 #include "parallel.h"
 #include <dune/uggrid/gm/algebra.h>
 #include <dune/uggrid/gm/evm.h>
+#include <dune/uggrid/gm/geomcache.h>
+#include <dune/uggrid/gm/indexsets.h>
+#include <dune/uggrid/gm/memstat.h>
 #include <dune/uggrid/gm/pargm.h>
 #include <dune/uggrid/gm/rm.h>
 #include <dune/uggrid/gm/refine.h>
@@ -208,6 +211,27 @@ static GRID *GetGridOnDemand (MULTIGRID *mg, int level)
 /*																			*/
 /****************************************************************************/
 
+/****************************************************************************/
+/*																			*/
+/*		memory accounting and index sets of object copies created and		*/
+/*		deleted by DDD (other objects are handled by the grid manager)		*/
+/*																			*/
+/****************************************************************************/
+
+static void ObjectLDataConstructor (DDD::DDDContext& context, DDD_OBJ obj)
+{
+  AccountObject(ddd_ctrl(context).currMG, obj);
+  IndexSetsInsert(ddd_ctrl(context).currMG, obj);
+}
+
+static void ObjectDestructor (DDD::DDDContext& context, DDD_OBJ obj)
+{
+  IndexSetsRemove(ddd_ctrl(context).currMG, obj);
+  if (OBJT(obj) == IEOBJ || OBJT(obj) == BEOBJ)
+    GeometryCacheRemove(ddd_ctrl(context).currMG, (ELEMENT *)obj);
+  UnaccountObject(ddd_ctrl(context).currMG, obj);
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /*																			*/
@@ -228,6 +252,7 @@ static void VectorUpdate (DDD::DDDContext& context, DDD_OBJ obj)
 
   /* insert in vector list */
   GRID_LINK_VECTOR(theGrid,pv,prio);
+  SparsityRowChanged(theGrid,pv);
 }
 
 
@@ -541,6 +566,7 @@ static void VectorScatterConnX (DDD::DDDContext& context, DDD_OBJ obj, int cnt,
       MNEXT(last) = NULL;
       VSTART(vec) = first;
     }
+    SparsityRowChanged(theGrid,vec);
 
                 #ifdef Debug
     /*
@@ -630,6 +656,7 @@ static void VectorObjMkCons (DDD::DDDContext& context, DDD_OBJ obj, int newness)
 
 
       MNEXT(Prev) = Next;
+      SparsityRowChanged(theGrid,vec);
 
       NC(theGrid)--;
       continue;
@@ -727,10 +754,12 @@ static void VectorPriorityUpdate (DDD::DDDContext& context, DDD_OBJ obj, DDD_PRI
 /****************************************************************************/
 
 
-static void BVertexLDataConstructor (DDD::DDDContext&, DDD_OBJ obj)
+static void BVertexLDataConstructor (DDD::DDDContext& context, DDD_OBJ obj)
 {
   VERTEX  *theVertex                      = (VERTEX *) obj;
 
+  ObjectLDataConstructor(context, obj);
+
   PRINTDEBUG(dddif,1,(PFMT " BVertexLDataConstructor(): v=" VID_FMTX
                       " I/BVOBJ=%d\n",me,VID_PRTX(theVertex),OBJT(theVertex)))
 
@@ -789,11 +818,15 @@ static void BVertexGather (DDD::DDDContext&, DDD_OBJ obj, int cnt, DDD_TYPE type
   BVertexGatherBndP (V_BNDP((VERTEX *)obj),cnt,(char*)Data);
 }
 
+#ifdef UG_HAS_MESSAGE_BUFFER
 /* Handlers used by Dune to implement dynamic load balancing:
  * Dune writes the data into the objects' 'message_buffer'
  * variable, then we take it from there.
  * The first sizeof(int) bytes of the message_buffer is the length of
  * the message (without the size of the int).
+ * On the receiving side the data is copied into the migration arena
+ * of the multigrid and the entity gets a view of it, see
+ * AllocMigrationUserData().
  */
 template<typename Entity>
 static void DuneEntityGather (DDD::DDDContext&, DDD_OBJ obj, int cnt, DDD_TYPE type_id, void *Data)
@@ -809,7 +842,7 @@ static void DuneEntityGather (DDD::DDDContext&, DDD_OBJ obj, int cnt, DDD_TYPE t
 }
 
 template<typename Entity>
-static void DuneEntityScatter (DDD::DDDContext&, DDD_OBJ obj, int cnt, DDD_TYPE type_id, void *Data, int newness)
+static void DuneEntityScatter (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYPE type_id, void *Data, int newness)
 {
   const char* data = static_cast<const char*>(Data);
   Entity* entity = reinterpret_cast<Entity*>(obj);
@@ -818,10 +851,11 @@ static void DuneEntityScatter (DDD::DDDContext&, DDD_OBJ obj, int cnt, DDD_TYPE
   std::memcpy(&size, data, sizeof size);
   data += sizeof size;
 
-  char* buffer = static_cast<char*>(std::malloc(size));
+  char* buffer = AllocMigrationUserData(ddd_ctrl(context).currMG, size);
   std::memcpy(buffer, data, size);
-  entity->message_buffer(buffer, size);
+  entity->message_buffer_view(buffer, size);
 }
+#endif
 
 static void BVertexScatter (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYPE type_id, void *Data, int newness)
 {
@@ -872,21 +906,27 @@ static void VertexPriorityUpdate (DDD::DDDContext& context, DDD_OBJ obj, DDD_PRI
 /****************************************************************************/
 
 
-static void NodeDestructor(DDD::DDDContext&, DDD_OBJ obj)
+static void NodeDestructor(DDD::DDDContext& context, DDD_OBJ obj)
 {
   NODE *node      = (NODE *) obj;
 
+#ifdef UG_HAS_MESSAGE_BUFFER
   node->message_buffer_free();
+#endif
+  ObjectDestructor(context, obj);
 
   PRINTDEBUG(dddif,2,(PFMT " NodeDestructor(): n=" ID_FMTX " NDOBJ=%d\n",
                       me,ID_PRTX(node),OBJT(node)))
 }
 
-static void NodeObjInit(DDD::DDDContext&, DDD_OBJ obj)
+static void NodeObjInit(DDD::DDDContext& context, DDD_OBJ obj)
 {
   NODE *node      = (NODE *) obj;
 
+#ifdef UG_HAS_MESSAGE_BUFFER
   node->message_buffer(nullptr, 0);
+#endif
+  ObjectLDataConstructor(context, obj);
 
   PRINTDEBUG(dddif,2,(PFMT " NodeObjInit(): n=" ID_FMTX " NDOBJ=%d\n",
                       me,ID_PRTX(node),OBJT(node)))
@@ -1059,10 +1099,12 @@ static void NodeXferCopy (DDD::DDDContext& context, DDD_OBJ obj, DDD_PROC proc,
   }
         #endif
 
+#ifdef UG_HAS_MESSAGE_BUFFER
   if (DDD_XferWithAddData(context)) {
     /* Extra data for Dune */
     DDD_XferAddData(context, sizeof(theNode->message_buffer_size()) + theNode->message_buffer_size(), DDD_USER_DATA);
   }
+#endif
 
   DDD_XferCopyObj(context, PARHDRV(MYVERTEX(theNode)), proc, prio);
 
@@ -1180,7 +1222,11 @@ static void ElementLDataConstructor (DDD::DDDContext& context, DDD_OBJ obj)
   GRID    *theGrid        = GetGridOnDemand(ddd_ctrl(context).currMG,level);
   INT prio            = EPRIO(pe); */
 
+#ifdef UG_HAS_MESSAGE_BUFFER
   pe->message_buffer(nullptr, 0);
+#endif
+  SETNEWEL(pe,1);
+  ObjectLDataConstructor(context, obj);
 
   PRINTDEBUG(dddif,2,(PFMT " ElementLDataConsX(): pe=" EID_FMTX
                       " EOBJ=%d l=%d\n",me,EID_PRTX(pe),OBJT(pe),level))
@@ -1305,7 +1351,9 @@ static void ElementXferCopy (DDD::DDDContext& context, DDD_OBJ obj, DDD_PROC pro
   }
 
   if (DDD_XferWithAddData(context)) {
+#ifdef UG_HAS_MESSAGE_BUFFER
     DDD_XferAddData(context, sizeof(pe->message_buffer_size()) + pe->message_buffer_size(), DDD_USER_DATA);
+#endif
 
     /* add edges of element */
     /* must be done before any XferCopyObj-call! herein    */
@@ -1573,11 +1621,13 @@ static void ElemScatterEdge (DDD::DDDContext& context, ELEMENT *pe, int cnt, cha
 
 static void ElemGatherI (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYPE type_id, void *data)
 {
+#ifdef UG_HAS_MESSAGE_BUFFER
   if (type_id == DDD_USER_DATA)
   {
     DuneEntityGather<union element>(context, obj, cnt, type_id, data);
     return;
   }
+#endif
 
     #ifdef __TWODIM__
   /* now: type_id is always TypeEdge */
@@ -1589,11 +1639,13 @@ static void ElemGatherI (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYP
 static void ElemScatterI (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYPE type_id,
                           void *data, int newness)
 {
+#ifdef UG_HAS_MESSAGE_BUFFER
   if (type_id == DDD_USER_DATA)
   {
     DuneEntityScatter<union element>(context, obj, cnt, type_id, data, newness);
     return;
   }
+#endif
 
     #ifdef __TWODIM__
   /* type_id is always TypeEdge */
@@ -1615,11 +1667,13 @@ static void ElemGatherB (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TYP
     BElementGatherBndS(bnds, nsides, cnt, (char *)data);
     return;
   }
+#ifdef UG_HAS_MESSAGE_BUFFER
   if (type_id == DDD_USER_DATA)
   {
     DuneEntityGather<union element>(context, obj, cnt, type_id, data);
     return;
   }
+#endif
 
   /* now: type_id is TypeEdge or other */
         #ifdef __TWODIM__
@@ -1648,11 +1702,13 @@ static void ElemScatterB (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TY
       SET_BNDS(pe,i,bnds[i]);
     return;
   }
+#ifdef UG_HAS_MESSAGE_BUFFER
   if (type_id == DDD_USER_DATA)
   {
     DuneEntityScatter<union element>(context, obj, cnt, type_id, data, newness);
     return;
   }
+#endif
 
   /* now: type_id is TypeEdge or other */
         #ifdef __TWODIM__
@@ -1667,6 +1723,30 @@ static void ElemScatterB (DDD::DDDContext& context, DDD_OBJ obj, int cnt, DDD_TY
 /****************************************************************************/
 
 
+/* side of the ghost nb which matches side i of pe, if it has no neighbor yet */
+static INT NeighborSideOfGhost (ELEMENT *pe, INT i, ELEMENT *nb)
+{
+  INT j,k,l;
+
+  for (j=0; j<SIDES_OF_ELEM(nb); j++)
+  {
+    if (NBELEM(nb,j) != NULL) continue;
+    if (CORNERS_OF_SIDE(nb,j) != CORNERS_OF_SIDE(pe,i)) continue;
+
+    for (k=0; k<CORNERS_OF_SIDE(pe,i); k++)
+    {
+      NODE *theNode = CORNER(pe,CORNER_OF_SIDE(pe,i,k));
+
+      for (l=0; l<CORNERS_OF_SIDE(nb,j); l++)
+        if (CORNER(nb,CORNER_OF_SIDE(nb,j,l)) == theNode) break;
+      if (l >= CORNERS_OF_SIDE(nb,j)) break;
+    }
+    if (k >= CORNERS_OF_SIDE(pe,i)) return (j);
+  }
+
+  return (-1);
+}
+
 static void ElementObjMkCons (DDD::DDDContext& context, DDD_OBJ obj, int newness)
 {
   INT i,j;
@@ -1687,6 +1767,10 @@ static void ElementObjMkCons (DDD::DDDContext& context, DDD_OBJ obj, int newness
 
   DEBUGNSONS(pe,theFather,"ElementObjMkCons begin:");
 
+  /* the refinement is global data, an upgraded copy got the one */
+  /* of the incoming copy                                        */
+  IndexSetsRefineChanged(ddd_ctrl(context).currMG,pe);
+
   /* correct nb relationships between ghostelements */
   if (EGHOST(pe))
   {
@@ -1697,8 +1781,22 @@ static void ElementObjMkCons (DDD::DDDContext& context, DDD_OBJ obj, int newness
       {
         for (j=0; j<SIDES_OF_ELEM(NbElement); j++)
           if (NBELEM(NbElement,j) == pe) break;
+        if (j < SIDES_OF_ELEM(NbElement)) continue;
+
+        /* the outer layers of a wider overlap are sent one by one, */
+        /* connect them to the layer they are added to              */
+        if (newness == XFER_NEW && ddd_ctrl(context).currMG->overlapDepth > 1)
+        {
+          j = NeighborSideOfGhost(pe,i,NbElement);
+          if (j >= 0)
+          {
+            SET_NBELEM(NbElement,j,pe);
+            continue;
+          }
+        }
+
         /* no backptr reset nb pointer */
-        if (j >= SIDES_OF_ELEM(NbElement)) SET_NBELEM(pe,i,NULL);
+        SET_NBELEM(pe,i,NULL);
       }
     }
   }
@@ -2175,6 +2273,8 @@ void NS_DIM_PREFIX ddd_HandlerInit (DDD::DDDContext& context, INT handlerSet)
 {
   auto& dddctrl = ddd_ctrl(context);
 
+  DDD_SetHandlerLDATACONSTRUCTOR (context, dddctrl.TypeVector, ObjectLDataConstructor);
+  DDD_SetHandlerDESTRUCTOR       (context, dddctrl.TypeVector, ObjectDestructor);
   DDD_SetHandlerUPDATE           (context, dddctrl.TypeVector, VectorUpdate);
   DDD_SetHandlerXFERCOPY         (context, dddctrl.TypeVector, VectorXferCopy);
   DDD_SetHandlerXFERGATHERX      (context, dddctrl.TypeVector, VectorGatherMatX);
@@ -2185,18 +2285,23 @@ void NS_DIM_PREFIX ddd_HandlerInit (DDD::DDDContext& context, INT handlerSet)
           DDD_SetHandlerDELETE           (context, dddctrl.TypeVector, VectorDelete);
    */
 
+  DDD_SetHandlerLDATACONSTRUCTOR (context, dddctrl.TypeIVertex, ObjectLDataConstructor);
+  DDD_SetHandlerDESTRUCTOR       (context, dddctrl.TypeIVertex, ObjectDestructor);
   DDD_SetHandlerUPDATE           (context, dddctrl.TypeIVertex, VertexUpdate);
   DDD_SetHandlerSETPRIORITY      (context, dddctrl.TypeIVertex, VertexPriorityUpdate);
 
   DDD_SetHandlerLDATACONSTRUCTOR (context, dddctrl.TypeBVertex, BVertexLDataConstructor);
+  DDD_SetHandlerDESTRUCTOR       (context, dddctrl.TypeBVertex, ObjectDestructor);
   DDD_SetHandlerUPDATE           (context, dddctrl.TypeBVertex, VertexUpdate);
   DDD_SetHandlerXFERCOPY         (context, dddctrl.TypeBVertex, BVertexXferCopy);
   DDD_SetHandlerXFERGATHER       (context, dddctrl.TypeBVertex, BVertexGather);
   DDD_SetHandlerXFERSCATTER      (context, dddctrl.TypeBVertex, BVertexScatter);
   DDD_SetHandlerSETPRIORITY      (context, dddctrl.TypeBVertex, VertexPriorityUpdate);
 
+#ifdef UG_HAS_MESSAGE_BUFFER
   DDD_SetHandlerXFERGATHER       (context, dddctrl.TypeNode, DuneEntityGather<NODE>);
   DDD_SetHandlerXFERSCATTER      (context, dddctrl.TypeNode, DuneEntityScatter<NODE>);
+#endif
 
   DDD_SetHandlerLDATACONSTRUCTOR (context, dddctrl.TypeNode, NodeObjInit);
   DDD_SetHandlerDESTRUCTOR       (context, dddctrl.TypeNode, NodeDestructor);
@@ -2229,6 +2334,8 @@ void NS_DIM_PREFIX ddd_HandlerInit (DDD::DDDContext& context, INT handlerSet)
   BElemHandlerInit(context, dddctrl.TypeHeBElem, handlerSet);
         #endif
 
+  DDD_SetHandlerLDATACONSTRUCTOR (context, dddctrl.TypeEdge, ObjectLDataConstructor);
+  DDD_SetHandlerDESTRUCTOR  (context, dddctrl.TypeEdge, ObjectDestructor);
   DDD_SetHandlerUPDATE      (context, dddctrl.TypeEdge, EdgeUpdate);
   DDD_SetHandlerOBJMKCONS   (context, dddctrl.TypeEdge, EdgeObjMkCons);
   DDD_SetHandlerXFERCOPY    (context, dddctrl.TypeEdge, EdgeXferCopy);
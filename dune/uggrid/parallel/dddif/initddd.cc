@@ -536,8 +536,8 @@ static void ddd_DefineTypes(DDD::DDDContext& context)
 
   /* The size of a NODE object may be less than sizeof(NODE).
    * Indeed, if the format does not contain node data, then the corresponding VECTOR*
-   * data member that stores this data is removed from the NODE object.  Hence the
-   * size of the NODE decreases by the size of one VECTOR*.
+   * data member that stores this data (the last one) is removed from the NODE object.
+   * Hence the size of the NODE decreases by the size of one VECTOR*.
    * Compare the corresponding computation in the method CreateNode (in ugm.c)
    */
   size = sizeof(NODE) - (dddctrl.nodeData ? 0 : sizeof(VECTOR*));
@@ -32,7 +32,9 @@
 /* standard C library */
 #include <config.h>
 #include <cstdlib>
+#include <cstddef>
 #include <cstdio>
+#include <cstring>
 
 #include <dune/uggrid/low/heaps.h>
 #include <dune/uggrid/low/misc.h>
@@ -56,6 +58,25 @@ using namespace PPIF;
 #define HARD_EXIT abort()
 /*#define HARD_EXIT exit(1)*/
 
+/* TMEM and AMEM buffers are freed without their size, therefore size and
+   accounting class are kept in a header in front of the buffer */
+#define MEMMGR_HEADER   alignof(std::max_align_t)
+
+/****************************************************************************/
+/*                                                                          */
+/* definition of variables global to this source file only (static!)        */
+/*                                                                          */
+/****************************************************************************/
+
+static HEAP_STAT memmgrStat[MEMMGR_NSTAT];
+
+struct MemMgrHeader {
+  size_t size;
+  int cls;
+};
+
+static_assert(sizeof(MemMgrHeader) <= MEMMGR_HEADER,
+              "memory manager header does not fit into the alignment");
 
 /****************************************************************************/
 /*                                                                          */
@@ -63,6 +84,42 @@ using namespace PPIF;
 /*                                                                          */
 /****************************************************************************/
 
+static void *AllocCounted (size_t size, int cls)
+{
+  char *p = (char *) std::malloc(MEMMGR_HEADER+size);
+  if (p==NULL)
+    return NULL;
+
+  MemMgrHeader *hdr = (MemMgrHeader *) p;
+  hdr->size = size;
+  hdr->cls = cls;
+  HeapStatAlloc(&memmgrStat[cls],size);
+
+  return p+MEMMGR_HEADER;
+}
+
+static void FreeCounted (void *buffer)
+{
+  if (buffer==NULL)
+    return;
+
+  MemMgrHeader *hdr = (MemMgrHeader *) (((char *)buffer)-MEMMGR_HEADER);
+  HeapStatFree(&memmgrStat[hdr->cls],hdr->size);
+  std::free(hdr);
+}
+
+static int TMEMClass (int kind)
+{
+  switch (kind)
+  {
+  case TMEM_CPL :     return MEMMGR_STAT_CPL;
+  case TMEM_MSG :
+  case TMEM_LOWCOMM : return MEMMGR_STAT_MSG;
+  default :           return MEMMGR_STAT_TMP;
+  }
+}
+
+
 
 /****************************************************************************/
 /*
@@ -183,7 +240,7 @@ void memmgr_FreePMEM (void *buffer)
 
 void * memmgr_AllocAMEM (unsigned long size)
 {
-  return std::malloc(size);
+  return AllocCounted(size, MEMMGR_STAT_AMEM);
 }
 
 
@@ -206,7 +263,7 @@ void * memmgr_AllocAMEM (unsigned long size)
 
 void memmgr_FreeAMEM (void *buffer)
 {
-  std::free(buffer);
+  FreeCounted(buffer);
 }
 
 
@@ -229,8 +286,9 @@ void memmgr_FreeAMEM (void *buffer)
 
 void * memmgr_AllocTMEM (unsigned long size, int kind)
 {
-  void* p = std::malloc(size);
-  std::memset(p, 0, size);
+  void* p = AllocCounted(size, TMEMClass(kind));
+  if (p!=NULL)
+    std::memset(p, 0, size);
   return p;
 }
 
@@ -254,7 +312,32 @@ void * memmgr_AllocTMEM (unsigned long size, int kind)
 
 void memmgr_FreeTMEM (void *buffer, int kind)
 {
-  std::free(buffer);
+  FreeCounted(buffer);
+}
+
+
+/****************************************************************************/
+/*
+   memmgr_Statistics -
+
+   SYNOPSIS:
+   const HEAP_STAT *memmgr_Statistics (int cls);
+
+   PARAMETERS:
+   .  cls - accounting class (MEMMGR_STAT_*)
+
+   DESCRIPTION:
+   current and peak usage of AMEM and TMEM memory of this process,
+   summed over all DDD contexts.
+
+   RETURN VALUE:
+   const HEAP_STAT *
+ */
+/****************************************************************************/
+
+const HEAP_STAT * memmgr_Statistics (int cls)
+{
+  return &memmgrStat[cls];
 }
 
 
@@ -34,6 +34,9 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
+#include <vector>
+
 /* low module */
 #include <dune/uggrid/low/debug.h>
 #include <dune/uggrid/low/heaps.h>
@@ -336,130 +339,152 @@ static INT DropUsedFlags (GRID *theGrid)
  */
 /****************************************************************************/
 
-INT ConnectGridOverlap (GRID *theGrid)
+static INT ConnectElementOverlap (GRID *theGrid, ELEMENT *theElement)
 {
   INT i,j,Sons_of_Side,prio;
   INT SonSides[MAX_SIDE_NODES];
-  ELEMENT *theElement;
   ELEMENT *theNeighbor;
   ELEMENT *theSon;
   ELEMENT *Sons_of_Side_List[MAX_SONS];
 
-  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+  prio = EPRIO(theElement);
+
+  /* connect only FROM hgost copies */
+  if (!IS_REFINED(theElement) || !EHGHOSTPRIO(prio)) return(GM_OK);
+
+  PRINTDEBUG(gm,1,("Connecting e=%08x/%x ID=%d eLevel=%d\n",
+                   DDD_InfoGlobalId(PARHDRE(theElement)),
+                   theElement,ID(theElement),
+                   LEVEL(theElement)));
+
+  for (i=0; i<SIDES_OF_ELEM(theElement); i++)
   {
-    prio = EPRIO(theElement);
+    if (OBJT(theElement)==BEOBJ
+        && SIDE_ON_BND(theElement,i)
+        && !INNER_BOUNDARY(theElement,i)) continue;
 
-    /* connect only FROM hgost copies */
-    if (!IS_REFINED(theElement) || !EHGHOSTPRIO(prio)) continue;
+    theNeighbor = NBELEM(theElement,i);
+    if (theNeighbor == NULL) continue;
 
-    PRINTDEBUG(gm,1,("Connecting e=%08x/%x ID=%d eLevel=%d\n",
-                     DDD_InfoGlobalId(PARHDRE(theElement)),
-                     theElement,ID(theElement),
-                     LEVEL(theElement)));
+    prio = EPRIO(theNeighbor);
+    /* overlap situation hasn't changed */
+    if (!THEFLAG(theElement) && !THEFLAG(theNeighbor)) continue;
+
+    /* connect only TO master copies */
+                      #ifdef __TWODIM__
+    if (!IS_REFINED(theNeighbor) || !MASTERPRIO(prio)) continue;
+                      #endif
+                      #ifdef __THREEDIM__
+    if (!IS_REFINED(theNeighbor)) continue;
+                      #endif
+
+    if (Get_Sons_of_ElementSide(theElement,i,&Sons_of_Side,
+                                Sons_of_Side_List,SonSides,1,0)!=GM_OK) RETURN(GM_FATAL);
+
+    IFDEBUG(gm,1)
+    UserWriteF("                 side=%d NSONS=%d Sons_of_Side=%d:\n",
+               i,NSONS(theElement),Sons_of_Side);
+    for (j=0; j<Sons_of_Side; j++)
+      UserWriteF("            son=%08x/%x sonside=%d\n",
+                 EGID(Sons_of_Side_List[j]),
+                 Sons_of_Side_List[j],SonSides[j]);
+    printf("        connecting ghostelements:\n");
+    ENDDEBUG
+
+    /* the ioflag=1 is needed, since not all sended ghosts are needed! */
+    if (Connect_Sons_of_ElementSide(theGrid,theElement,i,
+                                    Sons_of_Side,Sons_of_Side_List,SonSides,1)!=GM_OK)
+      RETURN(GM_FATAL);
+  }
 
-    for (i=0; i<SIDES_OF_ELEM(theElement); i++)
-    {
-      if (OBJT(theElement)==BEOBJ
-          && SIDE_ON_BND(theElement,i)
-          && !INNER_BOUNDARY(theElement,i)) continue;
-
-      theNeighbor = NBELEM(theElement,i);
-      if (theNeighbor == NULL) continue;
-
-      prio = EPRIO(theNeighbor);
-      /* overlap situation hasn't changed */
-      if (!THEFLAG(theElement) && !THEFLAG(theNeighbor)) continue;
-
-      /* connect only TO master copies */
-                        #ifdef __TWODIM__
-      if (!IS_REFINED(theNeighbor) || !MASTERPRIO(prio)) continue;
-                        #endif
-                        #ifdef __THREEDIM__
-      if (!IS_REFINED(theNeighbor)) continue;
-                        #endif
-
-      if (Get_Sons_of_ElementSide(theElement,i,&Sons_of_Side,
-                                  Sons_of_Side_List,SonSides,1,0)!=GM_OK) RETURN(GM_FATAL);
-
-      IFDEBUG(gm,1)
-      UserWriteF("                 side=%d NSONS=%d Sons_of_Side=%d:\n",
-                 i,NSONS(theElement),Sons_of_Side);
-      for (j=0; j<Sons_of_Side; j++)
-        UserWriteF("            son=%08x/%x sonside=%d\n",
-                   EGID(Sons_of_Side_List[j]),
-                   Sons_of_Side_List[j],SonSides[j]);
-      printf("        connecting ghostelements:\n");
-      ENDDEBUG
-
-      /* the ioflag=1 is needed, since not all sended ghosts are needed! */
-      if (Connect_Sons_of_ElementSide(theGrid,theElement,i,
-                                      Sons_of_Side,Sons_of_Side_List,SonSides,1)!=GM_OK)
-        RETURN(GM_FATAL);
-    }
+  /* 1. yellow_class specific code:                          */
+  /* check whether is a valid ghost, which as in minimum one */
+  /* master element as neighbor                              */
+  /* TODO: move this functionality to ComputeCopies          */
+  /* then disposing of theSon can be done in AdaptGrid       */
+  /* and the extra Xfer env around ConnectGridOverlap()      */
+  /* can be deleted (s.l. 971029)                            */
+
+  /* 2. ghost-ghost neighborship specific code:              */
+  /* reset in 3D all unsymmetric neighbor relationships      */
+  /* to avoid referencing of zombie pointers.                */
+  /* this happened e.g. in CorrectElementSidePattern()       */
+  /* (s.l. 980223)                                           */
+  {
+    ELEMENT *SonList[MAX_SONS+1];
 
-    /* 1. yellow_class specific code:                          */
-    /* check whether is a valid ghost, which as in minimum one */
-    /* master element as neighbor                              */
-    /* TODO: move this functionality to ComputeCopies          */
-    /* then disposing of theSon can be done in AdaptGrid       */
-    /* and the extra Xfer env around ConnectGridOverlap()      */
-    /* can be deleted (s.l. 971029)                            */
-
-    /* 2. ghost-ghost neighborship specific code:              */
-    /* reset in 3D all unsymmetric neighbor relationships      */
-    /* to avoid referencing of zombie pointers.                */
-    /* this happened e.g. in CorrectElementSidePattern()       */
-    /* (s.l. 980223)                                           */
+    if (MYMG(theGrid)->overlapDepth == 1)
+      GetAllSons(theElement,SonList);
+    else
     {
-      ELEMENT *SonList[MAX_SONS];
+      INT k,n = 0;
 
-      GetAllSons(theElement,SonList);
-      for (i=0; SonList[i]!=NULL; i++)
+      /* with a wider overlap, ghosts of the outer layers have no  */
+      /* master neighbor. only check the sons of the sides facing */
+      /* a master, these are in the first layer                   */
+      for (i=0; i<SIDES_OF_ELEM(theElement); i++)
       {
-        INT ok = 0;
-        theSon = SonList[i];
-        if (!EHGHOST(theSon)) continue;
-        for (j=0; j<SIDES_OF_ELEM(theSon); j++)
+        theNeighbor = NBELEM(theElement,i);
+        if (theNeighbor == NULL) continue;
+        if (!EMASTER(theNeighbor) || !IS_REFINED(theNeighbor)) continue;
+
+        if (Get_Sons_of_ElementSide(theElement,i,&Sons_of_Side,
+                                    Sons_of_Side_List,SonSides,1,0)!=GM_OK) RETURN(GM_FATAL);
+        for (j=0; j<Sons_of_Side; j++)
         {
-          ELEMENT *NbSon = NBELEM(theSon,j);
+          for (k=0; k<n; k++)
+            if (SonList[k] == Sons_of_Side_List[j]) break;
+          if (k == n) SonList[n++] = Sons_of_Side_List[j];
+        }
+      }
+      SonList[n] = NULL;
+    }
 
-          if (NbSon == NULL) continue;
+    for (i=0; SonList[i]!=NULL; i++)
+    {
+      INT ok = 0;
+      theSon = SonList[i];
+      if (!EHGHOST(theSon)) continue;
+      for (j=0; j<SIDES_OF_ELEM(theSon); j++)
+      {
+        ELEMENT *NbSon = NBELEM(theSon,j);
 
-          if (EMASTER(NbSon))
-          {
-            ok = 1;
-          }
-          /* reset unsymmetric pointer relation ship */
-          /* TODO: delete this is done in ElementObjMkCons()
-                                                  else
-                                                  {
-                                                          INT k;
-                                                          for (k=0; k<SIDES_OF_ELEM(NbSon); k++)
-                                                          {
-                                                                  if (NBELEM(NbSon,k)==theSon) break;
-                                                          }
-                                                          if (k>=SIDES_OF_ELEM(NbSon)) SET_NBELEM(theSon,j,NULL);
-                                                  }
-           */
+        if (NbSon == NULL) continue;
+
+        if (EMASTER(NbSon))
+        {
+          ok = 1;
         }
-        if (!ok)
+        /* reset unsymmetric pointer relation ship */
+        /* TODO: delete this is done in ElementObjMkCons()
+                                                else
+                                                {
+                                                        INT k;
+                                                        for (k=0; k<SIDES_OF_ELEM(NbSon); k++)
+                                                        {
+                                                                if (NBELEM(NbSon,k)==theSon) break;
+                                                        }
+                                                        if (k>=SIDES_OF_ELEM(NbSon)) SET_NBELEM(theSon,j,NULL);
+                                                }
+         */
+      }
+      if (!ok)
+      {
+        if (ECLASS(theSon) == YELLOW_CLASS)
         {
-          if (ECLASS(theSon) == YELLOW_CLASS)
-          {
-            UserWriteF("ConnectGridOverlap(): disposing useless yellow ghost  e=" EID_FMTX
-                       "f=" EID_FMTX "this ghost is useless!\n",
-                       EID_PRTX(theSon),EID_PRTX(theElement));
-            DisposeElement(UPGRID(theGrid),theSon,true);
-          }
-          else
-          {
-            UserWriteF("ConnectGridOverlap(): ERROR e=" EID_FMTX
-                       "f=" EID_FMTX "this ghost is useless!\n",
-                       EID_PRTX(theSon),EID_PRTX(theElement));
+          UserWriteF("ConnectGridOverlap(): disposing useless yellow ghost  e=" EID_FMTX
+                     "f=" EID_FMTX "this ghost is useless!\n",
+                     EID_PRTX(theSon),EID_PRTX(theElement));
+          DisposeElement(UPGRID(theGrid),theSon,true);
+        }
+        else
+        {
+          UserWriteF("ConnectGridOverlap(): ERROR e=" EID_FMTX
+                     "f=" EID_FMTX "this ghost is useless!\n",
+                     EID_PRTX(theSon),EID_PRTX(theElement));
 
-            /* TODO: better do this
-               assert(0); */
-          }
+          /* TODO: better do this
+             assert(0); */
         }
       }
     }
@@ -468,6 +493,133 @@ INT ConnectGridOverlap (GRID *theGrid)
   return(GM_OK);
 }
 
+INT ConnectGridOverlap (GRID *theGrid)
+{
+  ELEMENT *theElement;
+
+  for (theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+    if (ConnectElementOverlap(theGrid,theElement)) RETURN(GM_FATAL);
+
+  return(GM_OK);
+}
+
+
+/****************************************************************************/
+/*
+   ChangedOverlapCandidates - elements whose overlap may have changed
+
+   SYNOPSIS:
+   static void ChangedOverlapCandidates (const std::vector<ELEMENT *> &changed,
+                                         std::vector<ELEMENT *> &candidates);
+
+   PARAMETERS:
+   .  changed - elements of one level with THEFLAG set by AdaptLocalGrid
+   .  candidates - returns the changed elements and their neighbors
+
+   DESCRIPTION:
+   UpdateElementOverlap and ConnectElementOverlap only act on sides where
+   the element or its neighbor has THEFLAG set. Hence the elements
+   which have to be visited are the changed ones and their neighbors,
+   each of them exactly once.
+
+   RETURN VALUE:
+   void
+ */
+/****************************************************************************/
+
+static void ChangedOverlapCandidates (const std::vector<ELEMENT *> &changed,
+                                      std::vector<ELEMENT *> &candidates)
+{
+  INT i;
+
+  candidates.clear();
+  for (ELEMENT *theElement : changed)
+  {
+    candidates.push_back(theElement);
+    for (i=0; i<SIDES_OF_ELEM(theElement); i++)
+      if (NBELEM(theElement,i) != NULL)
+        candidates.push_back(NBELEM(theElement,i));
+  }
+
+  std::sort(candidates.begin(),candidates.end());
+  candidates.erase(std::unique(candidates.begin(),candidates.end()),
+                   candidates.end());
+}
+
+
+/****************************************************************************/
+/*
+   UpdateChangedGridOverlap - UpdateGridOverlap restricted to changed elements
+
+   SYNOPSIS:
+   INT UpdateChangedGridOverlap (GRID *theGrid,
+                                 const std::vector<ELEMENT *> &changed);
+
+   PARAMETERS:
+   .  theGrid - grid level which was adapted
+   .  changed - elements of theGrid whose refinement changed
+
+   DESCRIPTION:
+   Sends the same ghost copies as UpdateGridOverlap, but only visits
+   the changed elements and their neighbors instead of all elements
+   of the level.
+
+   RETURN VALUE:
+   INT
+ */
+/****************************************************************************/
+
+INT UpdateChangedGridOverlap (GRID *theGrid, const std::vector<ELEMENT *> &changed)
+{
+  DDD::DDDContext& context = theGrid->dddContext();
+  std::vector<ELEMENT *> candidates;
+
+  ChangedOverlapCandidates(changed,candidates);
+  for (ELEMENT *theElement : candidates)
+  {
+    /* UpdateGridOverlap only scans the master part of the list */
+    if (EMASTER(theElement) && IS_REFINED(theElement))
+      UpdateElementOverlap(context, theElement);
+  }
+
+  return(GM_OK);
+}
+
+
+/****************************************************************************/
+/*
+   ConnectChangedGridOverlap - ConnectGridOverlap restricted to changed elements
+
+   SYNOPSIS:
+   INT ConnectChangedGridOverlap (GRID *theGrid,
+                                  const std::vector<ELEMENT *> &changed);
+
+   PARAMETERS:
+   .  theGrid - grid level which was adapted
+   .  changed - elements of theGrid whose refinement changed
+
+   DESCRIPTION:
+   Connects the received ghost sons like ConnectGridOverlap, but only
+   for the changed elements and their neighbors. The check for useless
+   yellow ghosts is done for these elements only, since the sons of
+   all other ghosts and of their neighbors did not change.
+
+   RETURN VALUE:
+   INT
+ */
+/****************************************************************************/
+
+INT ConnectChangedGridOverlap (GRID *theGrid, const std::vector<ELEMENT *> &changed)
+{
+  std::vector<ELEMENT *> candidates;
+
+  ChangedOverlapCandidates(changed,candidates);
+  for (ELEMENT *theElement : candidates)
+    if (ConnectElementOverlap(theGrid,theElement)) RETURN(GM_FATAL);
+
+  return(GM_OK);
+}
+
 
 
 /****************************************************************************/
@@ -32,6 +32,7 @@
 #define __PARALLEL_H__
 
 #include <memory>
+#include <vector>
 
 #ifdef ModelP
 #  include <dune/uggrid/parallel/ddd/dddcontext.hh>
@@ -325,7 +326,13 @@ void    SetGhostObjectPriorities    (GRID *theGrid);
 
 /* from trans.c */
 int             TransferGrid                            (MULTIGRID *theMG);
-int             TransferGridFromLevel           (MULTIGRID *theMG, INT level);
+int             TransferGridFromLevel           (MULTIGRID *theMG, INT level, INT overlap = 0);
+int             WidenGridOverlap                        (MULTIGRID *theMG, INT layers, INT fromLevel);
+int             GridOverlapLayers                       (GRID *theGrid, std::vector<std::vector<ELEMENT *> > &layers);
+#ifdef UG_HAS_MESSAGE_BUFFER
+char           *AllocMigrationUserData          (MULTIGRID *theMG, std::size_t size);
+void            ReleaseMigrationUserData        (MULTIGRID *theMG);
+#endif
 
 /* from identify.c */
 void    IdentifyInit                                    (MULTIGRID *theMG);
@@ -337,6 +344,8 @@ INT             Identify_SonNodesAndSonEdges    (GRID *theGrid);
 
 INT             UpdateGridOverlap                       (GRID *theGrid);
 INT             ConnectGridOverlap                      (GRID *theGrid);
+INT             UpdateChangedGridOverlap        (GRID *theGrid, const std::vector<ELEMENT *> &changed);
+INT             ConnectChangedGridOverlap       (GRID *theGrid, const std::vector<ELEMENT *> &changed);
 INT             ConnectVerticalOverlap (MULTIGRID *theMG);
 
 /* from priority.c */
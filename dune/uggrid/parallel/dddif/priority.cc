@@ -32,6 +32,9 @@
 #include <config.h>
 #include <cstdlib>
 
+#include <unordered_set>
+#include <vector>
+
 #include "parallel.h"
 #include <dune/uggrid/ugdevices.h>
 #include <dune/uggrid/gm/evm.h>
@@ -286,6 +289,8 @@ void NS_DIM_PREFIX SetGhostObjectPriorities (GRID *theGrid)
 
   auto& context = theGrid->dddContext();
   const auto& me = context.me();
+  const INT depth = MYMG(theGrid)->overlapDepth;
+  std::unordered_set<ELEMENT *> overlap;
 
   /* reset USED flag for objects of ghostelements */
   for (theElement=PFIRSTELEMENT(theGrid);
@@ -318,6 +323,33 @@ void NS_DIM_PREFIX SetGhostObjectPriorities (GRID *theGrid)
     SETMODIFIED(theNode,0);
   }
 
+  /* with a wider overlap the ghosts of the outer layers have no */
+  /* master neighbor, collect the ghosts of all layers            */
+  if (depth > 1)
+  {
+    std::vector<ELEMENT *> layer,next;
+
+    for (theElement=PFIRSTELEMENT(theGrid);
+         theElement!=NULL;
+         theElement=SUCCE(theElement))
+      if (PARTITION(theElement) == me)
+        layer.push_back(theElement);
+
+    for (INT d=0; d<depth && !layer.empty(); d++)
+    {
+      next.clear();
+      for (ELEMENT *e : layer)
+        for (i=0; i<SIDES_OF_ELEM(e); i++)
+        {
+          theNeighbor = NBELEM(e,i);
+          if (theNeighbor == NULL || PARTITION(theNeighbor) == me) continue;
+          if (overlap.insert(theNeighbor).second)
+            next.push_back(theNeighbor);
+        }
+      std::swap(layer,next);
+    }
+  }
+
   /* set FLAG for objects of horizontal and vertical overlap */
   for (theElement=PFIRSTELEMENT(theGrid);
        theElement!=NULL;
@@ -327,17 +359,20 @@ void NS_DIM_PREFIX SetGhostObjectPriorities (GRID *theGrid)
 
     /* check for horizontal ghost */
     hghost = 0;
-    for (i=0; i<SIDES_OF_ELEM(theElement); i++)
-    {
-      theNeighbor = NBELEM(theElement,i);
-      if (theNeighbor == NULL) continue;
-
-      if (PARTITION(theNeighbor) == me)
+    if (depth > 1)
+      hghost = (overlap.count(theElement) > 0);
+    else
+      for (i=0; i<SIDES_OF_ELEM(theElement); i++)
       {
-        hghost = 1;
-        break;
+        theNeighbor = NBELEM(theElement,i);
+        if (theNeighbor == NULL) continue;
+
+        if (PARTITION(theNeighbor) == me)
+        {
+          hghost = 1;
+          break;
+        }
       }
-    }
 
     /* check for vertical ghost */
     vghost = 0;
@@ -381,6 +381,109 @@ void UG_GlobalSumNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x)
   MPI_Allreduce(MPI_IN_PLACE, x, n, MPI_DOUBLE, MPI_SUM, context.comm());
 }
 
+/****************************************************************************/
+/*D
+   UG_IGlobalSumNINT - start the global sum of n integer values
+
+   SYNOPSIS:
+   void UG_IGlobalSumNINT (INT n, INT *x, UG_REDUCTION *r)
+
+   PARAMETERS:
+   .  n - number of elements in array x to be used
+   .  x - array of size n
+   .  r - handle of the reduction
+
+   DESCRIPTION:
+   This function starts the same reduction as UG_GlobalSumNINT without
+   waiting for it. x must not be accessed until UG_WaitReduction(r) has
+   returned or UG_TestReduction(r) has returned true, then it holds the
+   result. The variants UG_IGlobalMaxNINT, UG_IGlobalMinNINT and
+   UG_IGlobalSumNDOUBLE etc. work alike. All processors have to start
+   their reductions and blocking collective operations in the same order.
+
+   RETURN VALUE:
+   none
+
+   D*/
+/****************************************************************************/
+
+void UG_IGlobalSumNINT (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_INT, MPI_SUM, context.comm(), &r->request);
+}
+
+void UG_IGlobalMaxNINT (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_INT, MPI_MAX, context.comm(), &r->request);
+}
+
+void UG_IGlobalMinNINT (const PPIF::PPIFContext& context, INT n, INT *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_INT, MPI_MIN, context.comm(), &r->request);
+}
+
+void UG_IGlobalSumNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_DOUBLE, MPI_SUM, context.comm(), &r->request);
+}
+
+void UG_IGlobalMaxNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_DOUBLE, MPI_MAX, context.comm(), &r->request);
+}
+
+void UG_IGlobalMinNDOUBLE (const PPIF::PPIFContext& context, INT n, DOUBLE *x, UG_REDUCTION *r)
+{
+  MPI_Iallreduce(MPI_IN_PLACE, x, n, MPI_DOUBLE, MPI_MIN, context.comm(), &r->request);
+}
+
+/****************************************************************************/
+/*D
+   UG_TestReduction - check whether a reduction has finished
+
+   SYNOPSIS:
+   bool UG_TestReduction (UG_REDUCTION *r)
+
+   PARAMETERS:
+   .  r - handle of the reduction
+
+   RETURN VALUE:
+   bool
+   .n   true if the result is available
+   .n   false if the reduction is still in progress
+
+   D*/
+/****************************************************************************/
+
+bool UG_TestReduction (UG_REDUCTION *r)
+{
+  int complete;
+
+  MPI_Test(&r->request, &complete, MPI_STATUS_IGNORE);
+  return complete;
+}
+
+/****************************************************************************/
+/*D
+   UG_WaitReduction - wait for the end of a reduction
+
+   SYNOPSIS:
+   void UG_WaitReduction (UG_REDUCTION *r)
+
+   PARAMETERS:
+   .  r - handle of the reduction
+
+   RETURN VALUE:
+   none
+
+   D*/
+/****************************************************************************/
+
+void UG_WaitReduction (UG_REDUCTION *r)
+{
+  MPI_Wait(&r->request, MPI_STATUS_IGNORE);
+}
+
 #endif  /* ModelP */
 
 END_UGDIM_NAMESPACE
@@ -33,6 +33,12 @@
 
 #include <config.h>
 #include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <dune/uggrid/parallel/ppif/ppifcontext.hh>
 
@@ -68,6 +74,10 @@ using namespace PPIF;
 
 enum GhostCmds { GC_Keep, GC_ToMaster, GC_Delete };
 
+/* size of the chunks of the migration user data arena, larger */
+/* requests get a chunk of their own                           */
+#define MIGRATION_CHUNK_SIZE    (1<<20)
+
 
 #define XferElement(context, elem,dest,prio)                             \
   { PRINTDEBUG(dddif,1,("%4d: XferElement(): XferCopy elem=" EID_FMTX " dest=%d prio=%d\n", \
@@ -113,6 +123,62 @@ enum GhostCmds { GC_Keep, GC_ToMaster, GC_Delete };
 
 
 
+/****************************************************************************/
+/*
+   NearPartitions - partitions of the elements in the overlap of an element
+
+   SYNOPSIS:
+   static void NearPartitions (ELEMENT *theElement, INT depth,
+                               std::vector<INT> &parts);
+
+   PARAMETERS:
+   .  theElement - element to start from
+   .  depth - number of horizontal overlap layers
+   .  parts - returns the distinct PARTITION values
+
+   DESCRIPTION:
+   Collects the partitions of all elements which can be reached from
+   theElement by crossing at most depth sides. theElement itself is not
+   considered. For depth 1 these are the partitions of the neighbors.
+   The result is exact as long as all these elements are present
+   locally, i.e. if theElement is a master and the overlap is at least
+   depth layers wide.
+
+   RETURN VALUE:
+   void
+ */
+/****************************************************************************/
+
+static void NearPartitions (ELEMENT *theElement, INT depth, std::vector<INT> &parts)
+{
+  std::vector<ELEMENT *> visited(1,theElement);
+  std::unordered_set<ELEMENT *> seen(visited.begin(),visited.end());
+  std::unordered_set<INT> seenParts;
+  std::size_t first = 0;
+  INT d,j;
+
+  parts.clear();
+  for (d=0; d<depth; d++)
+  {
+    std::size_t last = visited.size();
+
+    for (std::size_t k=first; k<last; k++)
+      for (j=0; j<SIDES_OF_ELEM(visited[k]); j++)
+      {
+        ELEMENT *theNeighbor = NBELEM(visited[k],j);
+
+        if (theNeighbor == NULL) continue;
+        if (!seen.insert(theNeighbor).second) continue;
+
+        visited.push_back(theNeighbor);
+        if (seenParts.insert(PARTITION(theNeighbor)).second)
+          parts.push_back(PARTITION(theNeighbor));
+      }
+    first = last;
+  }
+}
+
+
 /****************************************************************************/
 /*
    Gather_ElemDest -
@@ -345,30 +411,46 @@ static int Scatter_GhostCmd (DDD::DDDContext& context, DDD_OBJ obj, void *data,
  */
 /****************************************************************************/
 
-static int Gather_VHGhostCmd (DDD::DDDContext&, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
+static int Gather_VHGhostCmd (DDD::DDDContext& context, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
 {
   ELEMENT *theElement = (ELEMENT *)obj;
   // ELEMENT *theFather      = EFATHER(theElement);
   ELEMENT *theNeighbor;
+  const INT depth = ddd_ctrl(context).currMG->overlapDepth;
   INT j;
 
   if (PARTITION(theElement) != proc)
   {
     *((int *)data) = GC_Delete;
 
-    for(j=0; j<SIDES_OF_ELEM(theElement); j++)
+    if (depth == 1)
     {
-      theNeighbor = NBELEM(theElement,j);
-
-      if (theNeighbor != NULL)
+      for(j=0; j<SIDES_OF_ELEM(theElement); j++)
       {
-        if (PARTITION(theNeighbor) == proc)
+        theNeighbor = NBELEM(theElement,j);
+
+        if (theNeighbor != NULL)
         {
-          *((int *)data) = GC_Keep;
-          return (0);
+          if (PARTITION(theNeighbor) == proc)
+          {
+            *((int *)data) = GC_Keep;
+            return (0);
+          }
         }
       }
     }
+    else
+    {
+      std::vector<INT> parts;
+
+      /* keep copies which are in the overlap of a master on proc */
+      NearPartitions(theElement,depth,parts);
+      if (std::find(parts.begin(),parts.end(),(INT)proc) != parts.end())
+      {
+        *((int *)data) = GC_Keep;
+        return (0);
+      }
+    }
 
     /* wrong:		if (LEVEL(theElement) > 0)
                     {
@@ -558,6 +640,8 @@ static int XferNodesForOverlap2 (GRID *theGrid)
 
    DESCRIPTION:
    This function sends elements to other procs, keeps overlapping region of one element and maintains correct priorities at interfaces. The destination procs have been computed by the RecursiveCoordinateBisection function and put into the elements' PARTITION-entries.
+   The overlap is overlapDepth of the multigrid elements wide, which must
+   not exceed the width of the overlap before the transfer.
 
    RETURN VALUE:
    void
@@ -570,9 +654,11 @@ static int XferGridWithOverlap (GRID *theGrid)
   ELEMENT *SonList[MAX_SONS];
   INT i,j,overlap_elem,part;
   INT migrated = 0;
+  std::vector<INT> parts;
 
   DDD::DDDContext& context = theGrid->dddContext();
   const auto& me = context.me();
+  const INT depth = MYMG(theGrid)->overlapDepth;
 
   for(theElement=FIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
   {
@@ -593,21 +679,41 @@ static int XferGridWithOverlap (GRID *theGrid)
   {
     overlap_elem = 0;
 
-    /* create 1-overlapping of horizontal elements */
-    for(j=0; j<SIDES_OF_ELEM(theElement); j++)
+    if (depth == 1)
     {
-      theNeighbor = NBELEM(theElement,j);
+      /* create 1-overlapping of horizontal elements */
+      for(j=0; j<SIDES_OF_ELEM(theElement); j++)
+      {
+        theNeighbor = NBELEM(theElement,j);
+
+        if (theNeighbor != NULL)
+        {
+          if (PARTITION(theElement)!=PARTITION(theNeighbor))
+          {
+            /* create Ghost copy */
+            XferElement(context, theElement, PARTITION(theNeighbor), PrioHGhost);
+          }
 
-      if (theNeighbor != NULL)
+          /* remember any local neighbour element */
+          if (PARTITION(theNeighbor)==me)
+            overlap_elem = 1;
+        }
+      }
+    }
+    else
+    {
+      /* create depth-overlapping of horizontal elements */
+      NearPartitions(theElement,depth,parts);
+      for (INT p : parts)
       {
-        if (PARTITION(theElement)!=PARTITION(theNeighbor))
+        if (PARTITION(theElement)!=p)
         {
           /* create Ghost copy */
-          XferElement(context, theElement, PARTITION(theNeighbor), PrioHGhost);
+          XferElement(context, theElement, p, PrioHGhost);
         }
 
-        /* remember any local neighbour element */
-        if (PARTITION(theNeighbor)==me)
+        /* remember any local element in the overlap */
+        if (p==me)
           overlap_elem = 1;
       }
     }
@@ -688,6 +794,199 @@ static int XferGridWithOverlap (GRID *theGrid)
 
 
 
+/** \brief local overlap layer of the elements of the level being widened */
+static std::unordered_map<ELEMENT *, INT> overlapLayer;
+
+/** \brief procs on which an element lies in one of the inner overlap layers */
+static std::unordered_map<ELEMENT *, std::vector<DDD_PROC> > innerLayerProcs;
+
+static int Gather_OverlapLayer (DDD::DDDContext&, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
+{
+  auto it = overlapLayer.find((ELEMENT *)obj);
+
+  /* ghosts which are not connected to a master have no layer */
+  *((INT *)data) = (it == overlapLayer.end()) ? -1 : it->second;
+
+  return (0);
+}
+
+static int Scatter_OverlapLayer (DDD::DDDContext& context, DDD_OBJ obj, void *data, DDD_PROC proc, DDD_PRIO prio)
+{
+  const INT layer = *((INT *)data);
+
+  if (layer >= 0 && layer < ddd_ctrl(context).currMG->overlapDepth)
+    innerLayerProcs[(ELEMENT *)obj].push_back(proc);
+
+  return (0);
+}
+
+
+/****************************************************************************/
+/*
+   XferOverlapLayer - add one layer of horizontal ghost elements
+
+   SYNOPSIS:
+   static void XferOverlapLayer (GRID *theGrid);
+
+   PARAMETERS:
+   .  theGrid
+
+   DESCRIPTION:
+   The overlap layers of the elements are computed by GridOverlapLayers
+   on each proc and exchanged over the ElementSymmIF. A master element is
+   then sent as HGhost to the procs on which one of its neighbors lies in
+   a layer below overlapDepth, unless it has a copy there already. Thus
+   only the overlap which is not yet overlapDepth layers wide is widened,
+   by one layer per call.
+
+   RETURN VALUE:
+   void
+ */
+/****************************************************************************/
+
+static void XferOverlapLayer (GRID *theGrid)
+{
+  DDD::DDDContext& context = theGrid->dddContext();
+  const auto& me = context.me();
+  std::vector<std::vector<ELEMENT *> > layers;
+  ELEMENT *theElement;
+  INT j,k;
+
+  GridOverlapLayers(theGrid,layers);
+  for (k=0; k<(INT)layers.size(); k++)
+    for (ELEMENT *e : layers[k])
+      overlapLayer[e] = k;
+
+  DDD_IFAExchangeX(context,
+                   ddd_ctrl(context).ElementSymmIF, GRID_ATTR(theGrid), sizeof(INT),
+                   Gather_OverlapLayer, Scatter_OverlapLayer);
+
+  for(theElement=FIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+  {
+    for(j=0; j<SIDES_OF_ELEM(theElement); j++)
+    {
+      ELEMENT *theNeighbor = NBELEM(theElement,j);
+
+      if (theNeighbor == NULL) continue;
+
+      auto it = innerLayerProcs.find(theNeighbor);
+      if (it == innerLayerProcs.end()) continue;
+
+      for (DDD_PROC p : it->second)
+      {
+        int *proclist;
+
+        if (p == me) continue;
+
+        /* skip procs which already hold a horizontal copy */
+        proclist = EPROCLIST(context, theElement);
+        proclist += 2;
+        while (*proclist != -1)
+        {
+          if (*proclist == p && (EMASTERPRIO(*(proclist+1)) || EHGHOSTPRIO(*(proclist+1))))
+            break;
+          proclist += 2;
+        }
+        if (*proclist != -1) continue;
+
+        XferElement(context, theElement, p, PrioHGhost);
+      }
+    }
+  }
+
+  overlapLayer.clear();
+  innerLayerProcs.clear();
+}
+
+
+/****************************************************************************/
+/** \brief Widen the overlap to overlapDepth layers of horizontal ghosts
+
+   \param theMG - multigrid to handle
+   \param layers - maximal number of layers to add
+   \param fromLevel - first level whose overlap may be too narrow
+
+   Each layer needs its own transfer, since the elements of the next
+   layer are only known to the procs holding the current one. Overlaps
+   which are already overlapDepth layers wide are left alone, so that
+   it can be called after each adaptation. Has to be called on all procs
+   with the same arguments. ConstructConsistentMultiGrid has to be called
+   afterwards.
+
+   \return <ul>
+   <li> 0 if ok </li>
+   </ul>
+ */
+/****************************************************************************/
+
+int NS_DIM_PREFIX WidenGridOverlap (MULTIGRID *theMG, INT layers, INT fromLevel)
+{
+  INT g,l;
+
+  for (l=0; l<layers; l++)
+  {
+    DDD_XferBegin(theMG->dddContext());
+    for (g=fromLevel; g<=TOPLEVEL(theMG); g++)
+      XferOverlapLayer(GRID_ON_LEVEL(theMG,g));
+    DDD_XferEnd(theMG->dddContext());
+  }
+
+  return 0;
+}
+
+
+/****************************************************************************/
+/** \brief Sort the elements of a grid by their overlap layer
+
+   \param theGrid - grid level to handle
+   \param layers - returns the masters in layers[0] and the HGhost elements
+                   with distance k to the nearest master in layers[k]
+
+   The layers are computed locally by a breadth-first search from the
+   masters. Exchanges which only need the inner layers can skip the
+   elements of the outer ones in their gather and scatter functions.
+
+   \return <ul>
+   <li> 0 if ok </li>
+   </ul>
+ */
+/****************************************************************************/
+
+int NS_DIM_PREFIX GridOverlapLayers (GRID *theGrid, std::vector<std::vector<ELEMENT *> > &layers)
+{
+  std::unordered_set<ELEMENT *> reached;
+  ELEMENT *theElement;
+  INT j;
+
+  layers.assign(1,std::vector<ELEMENT *>());
+  for (theElement=FIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+  {
+    layers[0].push_back(theElement);
+    reached.insert(theElement);
+  }
+
+  while (!layers.back().empty())
+  {
+    std::vector<ELEMENT *> next;
+
+    for (ELEMENT *e : layers.back())
+      for (j=0; j<SIDES_OF_ELEM(e); j++)
+      {
+        ELEMENT *theNeighbor = NBELEM(e,j);
+
+        if (theNeighbor == NULL || !EHGHOST(theNeighbor)) continue;
+        if (!reached.insert(theNeighbor).second) continue;
+
+        next.push_back(theNeighbor);
+      }
+    layers.push_back(std::move(next));
+  }
+  layers.pop_back();
+
+  return 0;
+}
+
+
 /****************************************************************************/
 
 
@@ -729,28 +1028,113 @@ static void InheritPartitionBottomTop (ELEMENT *e)
 /****************************************************************************/
 
 
+#ifdef UG_HAS_MESSAGE_BUFFER
+/****************************************************************************/
+/** \brief Allocate memory for user data received during migration
+
+   \param theMG - multigrid to handle
+   \param size - number of bytes needed
+
+   The memory is taken from a chunked arena of the multigrid instead of
+   one heap allocation per received entity. It stays valid until
+   ReleaseMigrationUserData() is called.
+
+   \return pointer to the memory, NULL if size is 0
+ */
+/****************************************************************************/
+
+char * NS_DIM_PREFIX AllocMigrationUserData (MULTIGRID *theMG, std::size_t size)
+{
+  constexpr std::size_t align = alignof(std::max_align_t);
+  auto& chunks = theMG->migrationUserData;
+
+  if (size == 0)
+    return NULL;
+  size = (size + align - 1) & ~(align - 1);
+
+  if (size > MIGRATION_CHUNK_SIZE/4)
+  {
+    /* a chunk of its own, inserted before the last one */
+    /* to keep the free space of that one usable        */
+    auto pos = (theMG->migrationUserDataFree > 0) ? chunks.end()-1 : chunks.end();
+    return chunks.emplace(pos, new char[size])->get();
+  }
+
+  if (size > theMG->migrationUserDataFree)
+  {
+    chunks.emplace_back(new char[MIGRATION_CHUNK_SIZE]);
+    theMG->migrationUserDataFree = MIGRATION_CHUNK_SIZE;
+  }
+
+  char *p = chunks.back().get() + MIGRATION_CHUNK_SIZE - theMG->migrationUserDataFree;
+  theMG->migrationUserDataFree -= size;
+
+  return p;
+}
+
+/****************************************************************************/
+/** \brief Release the user data received during migration
+
+   \param theMG - multigrid to handle
+
+   Frees the migration arena in one go and resets all message buffers
+   still referring to it. Call this once the received data has been
+   consumed; it is also done at the start of the next migration.
+ */
+/****************************************************************************/
+
+void NS_DIM_PREFIX ReleaseMigrationUserData (MULTIGRID *theMG)
+{
+  if (theMG->migrationUserData.empty())
+    return;
+
+  for (INT g=0; g<=TOPLEVEL(theMG); g++)
+  {
+    GRID *theGrid = GRID_ON_LEVEL(theMG,g);
+
+    for (NODE *theNode=PFIRSTNODE(theGrid); theNode!=NULL; theNode=SUCCN(theNode))
+      if (theNode->message_buffer_is_view())
+        theNode->message_buffer(nullptr, 0);
+
+    for (ELEMENT *theElement=PFIRSTELEMENT(theGrid); theElement!=NULL; theElement=SUCCE(theElement))
+      if (theElement->message_buffer_is_view())
+        theElement->message_buffer(nullptr, 0);
+  }
+
+  theMG->migrationUserData.clear();
+  theMG->migrationUserData.shrink_to_fit();
+  theMG->migrationUserDataFree = 0;
+}
+#endif
+
 /****************************************************************************/
 /*
    TransferGridFromLevel -
 
    SYNOPSIS:
-   int TransferGridFromLevel (MULTIGRID *theMG, INT level);
+   int TransferGridFromLevel (MULTIGRID *theMG, INT level, INT overlap);
 
    PARAMETERS:
    .  theMG
    .  level
+   .  overlap - number of layers of HGhost elements, 0 keeps the current
 
    DESCRIPTION:
+   The master elements are moved to their PARTITION. If the overlap was
+   at least overlap layers wide before, all ghost elements are created in
+   the same transfer. Otherwise the missing layers are added by
+   WidenGridOverlap. AdaptMultiGrid keeps the overlap width.
 
    RETURN VALUE:
    int
  */
 /****************************************************************************/
 
-int NS_DIM_PREFIX TransferGridFromLevel (MULTIGRID *theMG, INT level)
+int NS_DIM_PREFIX TransferGridFromLevel (MULTIGRID *theMG, INT level, INT overlap)
 {
   INT g;
   INT migrated = 0;       /* number of elements moved */
+  INT missingLayers = 0;
 #ifdef STAT_OUT
   DOUBLE trans_begin, trans_end, cons_end;
 #endif
@@ -771,10 +1155,22 @@ int NS_DIM_PREFIX TransferGridFromLevel (MULTIGRID *theMG, INT level)
 
   if (DisposeBottomHeapTmpMemory(theMG)) REP_ERR_RETURN(1);
 
+#ifdef UG_HAS_MESSAGE_BUFFER
+  /* user data of the previous migration must have been consumed by now */
+  ReleaseMigrationUserData(theMG);
+#endif
+
 #ifdef STAT_OUT
   trans_begin = CURRENT_TIME;
 #endif
 
+  /* the current overlap can only be kept or narrowed in one transfer */
+  if (overlap > 0)
+  {
+    missingLayers = std::max(overlap - theMG->overlapDepth, 0);
+    theMG->overlapDepth = overlap - missingLayers;
+  }
+
   /* send new destination to ghost elements */
   UpdateGhostDests(theMG);
 
@@ -814,6 +1210,12 @@ int NS_DIM_PREFIX TransferGridFromLevel (MULTIGRID *theMG, INT level)
   ce_NO_DELETE_OVERLAP2 = -1;           /* don't use further NO_DELETE_OVERLAP2 */
 #endif
 
+  if (missingLayers > 0)
+  {
+    theMG->overlapDepth += missingLayers;
+    WidenGridOverlap(theMG,missingLayers,0);
+  }
+
   /* set priorities of border nodes */
   /* TODO this is an extra communication. eventually integrate this
               with grid distribution phase. */
@@ -825,6 +1227,10 @@ int NS_DIM_PREFIX TransferGridFromLevel (MULTIGRID *theMG, INT level)
 
   /* the grid has changed at least on one processor, thus reset MGSTATUS on all processors */
   RESETMGSTATUS(theMG);
+  MG_TOPOLOGY_CHANGED(theMG);
+
+  /* vectors were migrated by DDD, patterns cannot be updated incrementally */
+  DisposeSparsityPatterns(theMG);
 
         #ifdef STAT_OUT
   cons_end = CURRENT_TIME;